@@ -17,25 +17,90 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 30/01/2024 | Document creation		                         						|
+ * | 19/10/2026 | Interrupt driven continuous mode		                         			|
+ * | 19/10/2026 | Streaming filter and multi-point calibration	                         	|
  * 
  **/
 
 /*==================[inclusions]=============================================*/
+#include <stdbool.h>
+#include "esp_err.h"
 #include <gpio_mcu.h>
 /*==================[macros]=================================================*/
-
+#define HX711_BUFFER_SIZE	32		/*!< Samples stored in continuous mode (power of 2) */
+#define HX711_TIMEOUT_MS	200		/*!< Max wait for a conversion in HX711_read() (10 SPS = 100 ms) */
+#define HX711_NO_SAMPLE		0xFFFFFFFF	/*!< Returned by HX711_read() on timeout (out of the 24 bits range) */
+#define HX711_FILTER_WINDOW	8		/*!< Max moving average / median window */
+#define HX711_CAL_POINTS	5		/*!< Max calibration points */
 /*==================[typedef]================================================*/
+/**
+ * @brief Prototype of callback function called on every new sample in continuous mode
+ *
+ * @note It is called from the DOUT interrupt, keep it short (e.g. notify a task).
+ * A conversion already waiting when HX711_startContinuous() is called is only
+ * stored in the ring, without calling it.
+ *
+ * @param sample	Raw reading (24 bits, offset binary)
+ * @param param		Pointer to callback function parameters
+ */
+typedef void (*hx711_callback_t)(uint32_t sample, void *param);
+
+/**
+ * @brief First stage of the streaming filter
+ */
+typedef enum {
+	HX711_FILTER_AVERAGE,		/*!< Moving average */
+	HX711_FILTER_MEDIAN			/*!< Moving median (rejects spikes) */
+} hx711_filter_mode_t;
+
+/**
+ * @brief Streaming filter configuration
+ */
+typedef struct {
+	hx711_filter_mode_t mode;	/*!< Moving average or median */
+	uint8_t window;				/*!< Window length in samples (1 to HX711_FILTER_WINDOW) */
+	float iir_alpha;			/*!< Low-pass coefficient (0 < alpha < 1, other values disable it) */
+	float settle_std;			/*!< Max standard deviation of the window to be settled (raw counts) */
+	uint8_t settle_samples;		/*!< Consecutive samples under settle_std before reporting settled */
+} hx711_filter_config_t;
+
+/**
+ * @brief Streaming filter state
+ */
+typedef struct {
+	hx711_filter_config_t config;		/*!< Configuration */
+	int32_t ring[HX711_FILTER_WINDOW];	/*!< Last samples (signed raw counts) */
+	uint8_t index;						/*!< Next position in ring */
+	uint8_t count;						/*!< Samples in ring */
+	int64_t sum;						/*!< Sum of the samples in ring */
+	int64_t sum_sq;						/*!< Sum of squares of the samples in ring */
+	float value;						/*!< Filtered value (signed raw counts) */
+	uint8_t stable_count;				/*!< Consecutive samples under settle_std */
+	bool settled;						/*!< Reading is stable */
+} hx711_filter_t;
+
+/**
+ * @brief Multi-point calibration (raw counts to units)
+ */
+typedef struct {
+	uint8_t points;						/*!< Number of calibration points */
+	float raw[HX711_CAL_POINTS];		/*!< Filtered raw value of each point, ascending */
+	float units[HX711_CAL_POINTS];		/*!< Known weight of each point */
+	float tare;							/*!< Subtracted from the result */
+} hx711_calibration_t;
 
 /*==================[external data declaration]==============================*/
 
 /*==================[external functions declaration]=========================*/
 /** @fn HX711_Init(uint8_t gain, gpio_t pd_sck, gpio_t dout)
  * @brief Define clock and data pin, channel, and gain factor
+ * Both pins use a dedicated GPIO channel (see gpio_fast_out_mcu.h).
  * @param[in] gain Gain
  * @param[in] pd_sck Clock pin
  * @param[in] dout Datapin
+ * @return false if there are no free dedicated GPIO channels
  */
-void HX711_Init(uint8_t gain, gpio_t pd_sck, gpio_t dout);
+bool HX711_Init(uint8_t gain, gpio_t pd_sck, gpio_t dout);
 
 /** @fn int HX711_isReady(void)
  * @brief Check if HX711 is ready
@@ -53,38 +118,72 @@ void HX711_setGain(uint8_t gain);
 
 /** @fn HX711_read(void)
  * @brief Waits for the chip to be ready and returns a reading
- * @return Read value
+ * @note In continuous mode it returns the oldest sample stored by the interrupt.
+ * @return Read value (24 bits, offset binary), HX711_NO_SAMPLE if no conversion was ready after HX711_TIMEOUT_MS
  */
 uint32_t HX711_read(void);
 
+/** @fn HX711_startContinuous(hx711_callback_t func_p, void *param_p)
+ * @brief Read every conversion from the DOUT falling edge interrupt
+ * Samples are stored in a ring of HX711_BUFFER_SIZE, so the calling task never blocks.
+ * @param[in] func_p Callback called on every new sample (NULL if not required)
+ * @param[in] param_p Pointer to callback function parameters
+ */
+void HX711_startContinuous(hx711_callback_t func_p, void *param_p);
+
+/** @fn HX711_stopContinuous(void)
+ * @brief Stop reading conversions from the interrupt
+ */
+void HX711_stopContinuous(void);
+
+/** @fn HX711_available(void)
+ * @brief Number of samples waiting in the ring
+ * @return Samples available
+ */
+uint16_t HX711_available(void);
+
+/** @fn HX711_getSample(uint32_t *sample)
+ * @brief Take the oldest sample from the ring without blocking
+ * @param[out] sample Read value (24 bits, offset binary)
+ * @return true if a sample was available
+ */
+bool HX711_getSample(uint32_t *sample);
+
+/** @fn HX711_getOverruns(void)
+ * @brief Samples dropped because the ring was full
+ * @return Number of dropped samples since HX711_startContinuous()
+ */
+uint32_t HX711_getOverruns(void);
+
 // returns an average reading; times = how many times to read
 /** @fn HX711_readAverage(uint8_t times)
  * @brief Returns an average reading
  * @param[in] times How many times to read
- * @return Read value
+ * @return Average of the conversions read, HX711_NO_SAMPLE if every read timed out
  */
 uint32_t HX711_readAverage(uint8_t times);
 
-/** @fn HX711_get_value(uint8_t times)
+/** @fn HX711_getValue(uint8_t times)
  * @brief Returns (read_average() - OFFSET), that is the current value without the tare weight
  * @param[in] times How many times to read
- * @return Read value
+ * @return Read value, NAN if every read timed out
  */
-double HX711_get_value(uint8_t times);
+double HX711_getValue(uint8_t times);
 
 
-/** @fn HX711_get_units(uint8_t times)
- * @brief Returns get_value() divided by SCALE, that is the raw value divided by a value obtained via calibration
+/** @fn HX711_getUnits(uint8_t times)
+ * @brief Returns HX711_getValue() divided by SCALE, that is the raw value divided by a value obtained via calibration
  * @param[in] times How many readings to do
- * @return Read value
+ * @return Read value, NAN if every read timed out
  */
-float HX711_get_units(uint8_t times);
+float HX711_getUnits(uint8_t times);
 
 /** @fn HX711_tare(uint8_t times)
  * @brief Set the OFFSET value for tare weight
  * @param[in] times How many times to read the tare value
+ * @return false if every read timed out (OFFSET is not changed)
  */
-void HX711_tare(uint8_t times);
+bool HX711_tare(uint8_t times);
 
 /** @fn HX711_setScale(float scale)
  * @brief Set the SCALE value; this value is used to convert the raw data to "human readable" data (measure units)
@@ -120,6 +219,100 @@ void HX711_powerDown(void);
  */
 void HX711_powerUp(void);
 
+/** @fn HX711_filterInit(hx711_filter_t *filter, const hx711_filter_config_t *config)
+ * @brief Prepare a streaming filter
+ * @param[out] filter Filter state
+ * @param[in] config Filter configuration
+ */
+void HX711_filterInit(hx711_filter_t *filter, const hx711_filter_config_t *config);
+
+/** @fn HX711_filterReset(hx711_filter_t *filter)
+ * @brief Discard the filter history (e.g. after a load change)
+ * @param[in] filter Filter state
+ */
+void HX711_filterReset(hx711_filter_t *filter);
+
+/** @fn HX711_filterUpdate(hx711_filter_t *filter, uint32_t sample)
+ * @brief Feed one sample (from HX711_read() or HX711_getSample()) to the filter
+ * Runs in constant time (median: sort of at most HX711_FILTER_WINDOW samples).
+ * @param[in] filter Filter state
+ * @param[in] sample Raw reading (HX711_NO_SAMPLE is ignored)
+ * @return true if the reading is settled, false for HX711_NO_SAMPLE
+ */
+bool HX711_filterUpdate(hx711_filter_t *filter, uint32_t sample);
+
+/** @fn HX711_filterValue(const hx711_filter_t *filter)
+ * @brief Get the filtered value
+ * @param[in] filter Filter state
+ * @return Filtered value (signed raw counts)
+ */
+float HX711_filterValue(const hx711_filter_t *filter);
+
+/** @fn HX711_filterSettled(const hx711_filter_t *filter)
+ * @brief Check if the window variance stayed under the threshold long enough
+ * @param[in] filter Filter state
+ * @return true if settled
+ */
+bool HX711_filterSettled(const hx711_filter_t *filter);
+
+/** @fn HX711_filterUnits(const hx711_filter_t *filter, const hx711_calibration_t *cal)
+ * @brief Get the filtered value converted to units
+ * @param[in] filter Filter state
+ * @param[in] cal Calibration
+ * @return Weight in calibration units
+ */
+float HX711_filterUnits(const hx711_filter_t *filter, const hx711_calibration_t *cal);
+
+/** @fn HX711_calibrationClear(hx711_calibration_t *cal)
+ * @brief Remove all calibration points
+ * With no points the conversion uses OFFSET and SCALE, like HX711_getUnits().
+ * @param[out] cal Calibration
+ */
+void HX711_calibrationClear(hx711_calibration_t *cal);
+
+/** @fn HX711_calibrationAddPoint(hx711_calibration_t *cal, float raw, float units)
+ * @brief Add a known weight (use HX711_filterValue() once settled as raw)
+ * A single point is joined to OFFSET, more points give a piecewise linear curve.
+ * @param[in] cal Calibration
+ * @param[in] raw Filtered raw value
+ * @param[in] units Known weight
+ * @return false if HX711_CAL_POINTS are already stored
+ */
+bool HX711_calibrationAddPoint(hx711_calibration_t *cal, float raw, float units);
+
+/** @fn HX711_calibrationApply(const hx711_calibration_t *cal, float raw)
+ * @brief Convert a filtered raw value to units
+ * @param[in] cal Calibration
+ * @param[in] raw Filtered raw value
+ * @return Weight in calibration units
+ */
+float HX711_calibrationApply(const hx711_calibration_t *cal, float raw);
+
+/** @fn HX711_calibrationTare(hx711_calibration_t *cal, const hx711_filter_t *filter)
+ * @brief Set the current filtered weight as zero
+ * @param[in] cal Calibration
+ * @param[in] filter Filter state
+ */
+void HX711_calibrationTare(hx711_calibration_t *cal, const hx711_filter_t *filter);
+
+/** @fn HX711_calibrationSave(const hx711_calibration_t *cal, const char *key)
+ * @brief Store a calibration in NVS
+ * @note nvs_flash_init() must be called by the application first.
+ * @param[in] cal Calibration
+ * @param[in] key NVS key (max 15 characters)
+ * @return ESP_OK on success, nvs_open() error (e.g. ESP_ERR_NVS_NOT_INITIALIZED) otherwise
+ */
+esp_err_t HX711_calibrationSave(const hx711_calibration_t *cal, const char *key);
+
+/** @fn HX711_calibrationLoad(hx711_calibration_t *cal, const char *key)
+ * @brief Read a calibration from NVS
+ * @note nvs_flash_init() must be called by the application first.
+ * @param[out] cal Calibration
+ * @param[in] key NVS key (max 15 characters)
+ * @return ESP_OK on success, ESP_ERR_NVS_NOT_FOUND if never saved, nvs_open() error otherwise
+ */
+esp_err_t HX711_calibrationLoad(hx711_calibration_t *cal, const char *key);
+
 /*==================[internal functions declaration]=========================*/
 // Sends/receives data. 
 uint8_t shiftIn(void);
@@ -23,6 +23,12 @@
  * | 	SEL3	 	| 	GPIO_9		|
  * | 	Gnd 	    | 	GND     	|
  * 
+ * Each digit latches its BCD value, so the display keeps showing a number
+ * without refresh. LcdItsE0803Write() only stores the value: the digits are
+ * latched from a timer callback, and only when what must be shown changes.
+ * Blinking and brightness below the maximum turn the digits on and off from
+ * that callback (every 1 ms).
+ * 
  * @author Albano Peñalva
  *
  * @section changelog
@@ -30,6 +36,7 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 23/10/2023 | Document creation		                         						|
+ * | 19/10/2026 | Timer driven refresh, blinking and brightness	 						|
  * 
  **/
 
@@ -37,6 +44,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 /*==================[macros]=================================================*/
+#define LCD_ITSE0803_BRIGHTNESS_MAX	10	/*!< Full brightness (default) */
 
 /*==================[typedef]================================================*/
 
@@ -80,7 +88,21 @@ uint16_t LcdItsE0803Read(void);
 void LcdItsE0803Off(void);
 
 /**
- * @brief ESP-EDU LCD Module initialization.
+ * @brief Blink the display.
+ * 
+ * @param period_ms Blink period, half of it on and half off (0: no blink)
+ */
+void LcdItsE0803Blink(uint16_t period_ms);
+
+/**
+ * @brief Display brightness, by the fraction of time the digits are on.
+ * 
+ * @param level 0 (off) to LCD_ITSE0803_BRIGHTNESS_MAX (always on)
+ */
+void LcdItsE0803Brightness(uint8_t level);
+
+/**
+ * @brief ESP-EDU LCD Module deinitialization.
  * 
  * @return true 
  */
@@ -17,6 +17,7 @@
  * |   Date	| Description                                    			|
  * |:----------:|:----------------------------------------------------------------------|
  * | 30/01/2024 | Document creation		                         		|
+ * | 19/10/2026 | Per-device context and round-robin sampler				|
  * 
  **/
 
@@ -409,9 +410,66 @@
 #define MPU6050_DMP_MEMORY_CHUNK_SIZE   16
 // note: DMP code memory blocks defined at end of header file
 
+#define MPU6050_MOTION_BYTES        14 // ACCEL_XOUT_H to GYRO_ZOUT_L
+#define MPU6050_EXT_SENS_BYTES      24 // EXT_SENS_DATA_00 to EXT_SENS_DATA_23
+#define MPU6050_AUX_SLAVES          4  // slaves 0-3 feed EXT_SENS_DATA
+
 /*==================[typedef]================================================*/
+/**
+ * @brief MPU6050 device context.
+ *
+ * One context per sensor on the bus (e.g. one at MPU6050_ADDRESS_AD0_LOW and
+ * one at MPU6050_ADDRESS_AD0_HIGH). Each context owns its scratch buffer, so
+ * different devices can be used from different tasks.
+ */
+typedef struct {
+	uint8_t address;						/*!< I2C address */
+	uint8_t aux_len[MPU6050_AUX_SLAVES];	/*!< Bytes read by each auxiliary slave (0 = unused) */
+	uint8_t ext_len;						/*!< Total external sensor bytes per sample */
+	uint8_t buffer[MPU6050_MOTION_BYTES + MPU6050_EXT_SENS_BYTES];	/*!< Scratch buffer */
+} mpu6050_t;
+
+/**
+ * @brief External sensor attached to the MPU6050 auxiliary I2C bus
+ */
+typedef struct {
+	uint8_t address;		/*!< 7-bit I2C address on the auxiliary bus */
+	uint8_t data_reg;		/*!< First data register to read on every sample */
+	uint8_t data_len;		/*!< Bytes to read on every sample (1 to 15) */
+	bool byte_swap;			/*!< Swap bytes of each word (for little-endian sensors) */
+	const uint8_t *init;	/*!< Register/value pairs written once when attached (NULL if none) */
+	uint8_t init_len;		/*!< Number of register/value pairs in init */
+} mpu6050_aux_sensor_t;
+
+/**
+ * @brief Raw accelerometer, temperature and gyroscope sample
+ */
+typedef struct {
+	int16_t ax;		/*!< Accelerometer X-axis */
+	int16_t ay;		/*!< Accelerometer Y-axis */
+	int16_t az;		/*!< Accelerometer Z-axis */
+	int16_t temp;	/*!< Temperature */
+	int16_t gx;		/*!< Gyroscope X-axis */
+	int16_t gy;		/*!< Gyroscope Y-axis */
+	int16_t gz;		/*!< Gyroscope Z-axis */
+} mpu6050_motion_t;
+
+/**
+ * @brief Round-robin sampler for several MPU6050 on the same bus
+ */
+typedef struct {
+	mpu6050_t **devices;	/*!< Array of device contexts */
+	uint8_t qty;			/*!< Number of devices */
+	uint8_t next;			/*!< Next device to be read */
+} mpu6050_sampler_t;
 
 /*==================[external data declaration]==============================*/
+/** HMC5883L magnetometer, 75 Hz continuous mode. Frame: X, Z, Y (big-endian). */
+extern const mpu6050_aux_sensor_t MPU6050_AUX_HMC5883L;
+
+/** BMP280 barometer (SDO low), normal mode. Frame: raw pressure, raw temperature (20 bits each).
+ * Compensation coefficients have to be read once by the host through MPU6050_DevAuxBypass(). */
+extern const mpu6050_aux_sensor_t MPU6050_AUX_BMP280;
 
 /*==================[external functions declaration]=========================*/
 /** Specific address constructor.
@@ -1818,7 +1876,8 @@ bool MPU6050_getIntDataReadyStatus();
 
 // ACCEL_*OUT_* registers
 /** Get raw 9-axis motion sensor readings (accel/gyro/compass).
- * FUNCTION NOT FULLY IMPLEMENTED YET.
+ * Magnetometer words are read from the first 6 bytes of EXT_SENS_DATA, so
+ * slave 0 must be attached to the magnetometer (see MPU6050_DevAuxAttach()).
  * @param ax 16-bit signed integer container for accelerometer X-axis value
  * @param ay 16-bit signed integer container for accelerometer Y-axis value
  * @param az 16-bit signed integer container for accelerometer Z-axis value
@@ -2669,6 +2728,137 @@ uint8_t MPU6050_getDeviceID();
  */
 void MPU6050_setDeviceID(uint8_t id);
 
+// Multi-device API
+
+/** Read consecutive registers from one device in a single transaction.
+ * @param dev Device context
+ * @param reg First register to read
+ * @param data Buffer to store read data in
+ * @param len Number of bytes to read
+ * @return Status of read operation (true = success)
+ */
+bool MPU6050_DevReadRegister(mpu6050_t *dev, uint8_t reg, uint8_t *data, uint8_t len);
+
+/** Power on and prepare one device for general usage.
+ * @param dev Device context
+ * @param address I2C address
+ * @see MPU6050_initialize()
+ */
+void MPU6050_DevInit(mpu6050_t *dev, uint8_t address);
+
+/** Verify the I2C connection of one device.
+ * @param dev Device context
+ * @return True if connection is valid, false otherwise
+ */
+bool MPU6050_DevTestConnection(mpu6050_t *dev);
+
+/** Set clock source of one device.
+ * @param dev Device context
+ * @param source New clock source setting
+ * @see MPU6050_setClockSource()
+ */
+void MPU6050_DevSetClockSource(mpu6050_t *dev, uint8_t source);
+
+/** Set sleep mode status of one device.
+ * @param dev Device context
+ * @param enabled New sleep mode enabled status
+ * @see MPU6050_setSleepEnabled()
+ */
+void MPU6050_DevSetSleepEnabled(mpu6050_t *dev, bool enabled);
+
+/** Set full-scale gyroscope range of one device.
+ * @param dev Device context
+ * @param range New full-scale gyroscope range value
+ * @see MPU6050_setFullScaleGyroRange()
+ */
+void MPU6050_DevSetFullScaleGyroRange(mpu6050_t *dev, uint8_t range);
+
+/** Set full-scale accelerometer range of one device.
+ * @param dev Device context
+ * @param range New full-scale accelerometer range setting
+ * @see MPU6050_setFullScaleAccelRange()
+ */
+void MPU6050_DevSetFullScaleAccelRange(mpu6050_t *dev, uint8_t range);
+
+/** Set gyroscope sample rate divider of one device.
+ * @param dev Device context
+ * @param rate New sample rate divider
+ * @see MPU6050_setRate()
+ */
+void MPU6050_DevSetRate(mpu6050_t *dev, uint8_t rate);
+
+/** Set digital low-pass filter configuration of one device.
+ * @param dev Device context
+ * @param mode New DLFP configuration setting
+ * @see MPU6050_setDLPFMode()
+ */
+void MPU6050_DevSetDLPFMode(mpu6050_t *dev, uint8_t mode);
+
+/** Get raw accel, temperature and gyro readings of one device (single burst).
+ * @param dev Device context
+ * @param motion Container for the sample
+ * @return Status of read operation (true = success)
+ */
+bool MPU6050_DevGetMotion(mpu6050_t *dev, mpu6050_motion_t *motion);
+
+/** Enable or disable the auxiliary bus pass-through of one device.
+ * @param dev Device context
+ * @param enabled true: host talks to external sensors, false: MPU6050 master owns the aux bus
+ */
+void MPU6050_DevAuxBypass(mpu6050_t *dev, bool enabled);
+
+/** Attach an external sensor (magnetometer, barometer...) to a slave 0-3 channel.
+ * @param dev Device context
+ * @param slave Slave channel (0-3), attach in order
+ * @param sensor External sensor description (e.g. &MPU6050_AUX_HMC5883L)
+ * @return true if the channel was configured
+ */
+bool MPU6050_DevAuxAttach(mpu6050_t *dev, uint8_t slave, const mpu6050_aux_sensor_t *sensor);
+
+/** Start the auxiliary I2C master with sample aligned external data.
+ * @param dev Device context
+ * @param fifo true to also stream frames through the FIFO
+ * @return Frame length in bytes (14 + external sensor bytes)
+ */
+uint8_t MPU6050_DevAuxStart(mpu6050_t *dev, bool fifo);
+
+/** Get a synchronized accel/gyro + external sensor frame in one burst.
+ * @param dev Device context
+ * @param motion Container for the accel/temperature/gyro sample
+ * @param ext Container for the external sensor bytes (dev->ext_len bytes, may be NULL)
+ * @return Status of read operation (true = success)
+ */
+bool MPU6050_DevGetFrame(mpu6050_t *dev, mpu6050_motion_t *motion, uint8_t *ext);
+
+/** Pop one synchronized frame from the FIFO.
+ * @param dev Device context
+ * @param motion Container for the accel/temperature/gyro sample
+ * @param ext Container for the external sensor bytes (dev->ext_len bytes, may be NULL)
+ * @return true if a complete frame was read
+ */
+bool MPU6050_DevGetFifoFrame(mpu6050_t *dev, mpu6050_motion_t *motion, uint8_t *ext);
+
+/** Prepare a sampler for a group of devices sharing the bus.
+ * @param sampler Sampler context
+ * @param devices Array of initialized device contexts
+ * @param qty Number of devices in the array
+ */
+void MPU6050_SamplerInit(mpu6050_sampler_t *sampler, mpu6050_t **devices, uint8_t qty);
+
+/** Read the next device in round-robin order.
+ * @param sampler Sampler context
+ * @param motion Container for the sample
+ * @return Index of the device that was read, or -1 on bus error or empty group
+ */
+int8_t MPU6050_SamplerNext(mpu6050_sampler_t *sampler, mpu6050_motion_t *motion);
+
+/** Read every device of the group back to back.
+ * @param sampler Sampler context
+ * @param motions Array of qty containers, indexed like the device array
+ * @return Number of devices read successfully
+ */
+uint8_t MPU6050_SamplerReadAll(mpu6050_sampler_t *sampler, mpu6050_motion_t *motions);
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
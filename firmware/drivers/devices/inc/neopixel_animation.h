@@ -0,0 +1,125 @@
+#ifndef NEOPIXEL_ANIMATION_H
+#define NEOPIXEL_ANIMATION_H
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Devices Drivers devices
+ ** @{ */
+/** \addtogroup NeoPixel_Animation NeoPixel_Animation
+ ** @{ */
+
+/** \brief Timer driven animations for the NeoPixel stripe.
+ *
+ * Effects run on layers. Each layer covers a segment of the stripe and
+ * higher layers are drawn over lower ones. A timer wakes a task at a fixed
+ * frame rate, each effect advances one step and only the pixels that change
+ * are written before the frame is sent with NeoPixelShow().
+ *
+ * @note NeoPixelInit() must be called first. The stripe is switched to
+ * NEOPIXEL_SHOW_MANUAL while animations are running.
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 19/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "neopixel_stripe.h"
+#include "timer_mcu.h"
+/*==================[macros]=================================================*/
+#define NEOPIXEL_ANIM_LAYERS        4       /*> Max number of simultaneous effects */
+/*==================[typedef]================================================*/
+/**
+ * @brief Available effects
+ */
+typedef enum {
+	NEOPIXEL_EFFECT_SOLID,		/*!< Fixed color */
+	NEOPIXEL_EFFECT_RAINBOW,	/*!< Rotating rainbow (uses reps, sat and val) */
+	NEOPIXEL_EFFECT_CHASE,		/*!< Block of size pixels running over background */
+	NEOPIXEL_EFFECT_FADE,		/*!< From background to color once */
+	NEOPIXEL_EFFECT_BREATHE,	/*!< Color brightness going up and down */
+	NEOPIXEL_EFFECT_PALETTE		/*!< Rotating gradient of the palette colors */
+} neopixel_effect_type_t;
+
+/**
+ * @brief Effect configuration
+ */
+typedef struct {
+	neopixel_effect_type_t type;		/*!< Effect */
+	uint16_t first;						/*!< First pixel of the segment */
+	uint16_t length;					/*!< Pixels in the segment (0: up to the end of the stripe) */
+	uint32_t period_ms;					/*!< Time for a full rotation, lap, fade or breath */
+	bool upwards;						/*!< Direction of rainbow, chase and palette */
+	neopixel_color_t color;				/*!< Main color */
+	neopixel_color_t background;		/*!< Chase background, fade initial color */
+	uint8_t size;						/*!< Chase block size */
+	uint8_t reps;						/*!< Rainbow and palette repetitions in the segment */
+	uint8_t sat;						/*!< Rainbow saturation */
+	uint8_t val;						/*!< Rainbow value */
+	const neopixel_palette_t *palette;	/*!< Gradient palette (kept by the application) */
+} neopixel_effect_t;
+
+/**
+ * @brief Frame statistics
+ */
+typedef struct {
+	uint32_t frames;		/*!< Frames drawn */
+	uint32_t missed;		/*!< Timer ticks lost because a frame took too long */
+	uint32_t last_us;		/*!< Time to draw the last frame */
+	uint32_t max_us;		/*!< Max time to draw a frame */
+	uint32_t avg_us;		/*!< Mean time to draw a frame */
+} neopixel_anim_stats_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Animation engine initialization.
+ *
+ * @param timer Timer used to keep the frame rate (not available to the application)
+ * @param fps   Frames per second
+ */
+void NeoPixelAnimInit(timer_mcu_t timer, uint16_t fps);
+
+/**
+ * @brief Start an effect on a layer (replaces the previous one).
+ *
+ * @param layer     Layer number (0 to NEOPIXEL_ANIM_LAYERS - 1, higher is drawn on top)
+ * @param effect    Effect configuration (copied)
+ * @return true if started
+ */
+bool NeoPixelAnimStart(uint8_t layer, const neopixel_effect_t *effect);
+
+/**
+ * @brief Stop the effect on a layer.
+ *
+ * @note Pixels not covered by other layers are turned off.
+ * @param layer Layer number
+ */
+void NeoPixelAnimStop(uint8_t layer);
+
+/**
+ * @brief Pause or resume all animations.
+ *
+ * @param run true: run, false: pause
+ */
+void NeoPixelAnimRun(bool run);
+
+/**
+ * @brief Get frame statistics.
+ *
+ * @param stats Pointer to store the statistics
+ */
+void NeoPixelAnimGetStats(neopixel_anim_stats_t *stats);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif
+
+/*==================[end of file]============================================*/
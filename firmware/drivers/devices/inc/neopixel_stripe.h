@@ -13,6 +13,13 @@
  * (with no limits in the qty of leds in the array).
  * 
  * @note ESP-EDU have one individual NeoPixel connected to GPIO_8, that can be used with this driver.
+ *
+ * @note Functions that change colors only mark the changed pixels. Depending on
+ * NeoPixelShowMode(), the stripe is updated at once (default), when NeoPixelShow()
+ * is called or periodically at a fixed frame rate. Only changed pixels are encoded again.
+ *
+ * @note Up to WS2812B_MAX_STRIPS extra stripes can be sent at the same time with
+ * NeoPixelParallelShow() (uses the brightness set with NeoPixelBrightness()).
  * 
  * @author Albano Peñalva
  *
@@ -21,14 +28,22 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 23/10/2023 | Document creation		                         						|
+ * | 19/10/2026 | Frames sent asynchronously by the RMT	                         				|
+ * | 19/10/2026 | Double buffered frames, NeoPixelShow() and auto show	                 	|
+ * | 19/10/2026 | Brightness and gamma lookup table	                 						|
+ * | 19/10/2026 | Range functions for the animation engine	                 				|
+ * | 19/10/2026 | Fixed point HSV arrays and gradient palettes	                 			|
+ * | 19/10/2026 | Parallel output of up to 8 stripes	                 						|
  * 
  **/
 
 /*==================[inclusions]=============================================*/
 #include <stdint.h>
+#include <stdbool.h>
 #include "sdkconfig.h"
 #include "esp_err.h"
 #include "gpio_mcu.h"
+#include "ws2812b.h"
 /*==================[macros]=================================================*/
 #define BUILT_IN_RGB_LED_PIN          GPIO_8        /*> ESP32-C6-DevKitC-1 NeoPixel it's connected at GPIO_8 */
 #define BUILT_IN_RGB_LED_LENGTH       1             /*> ESP32-C6-DevKitC-1 NeoPixel has one pixel */
@@ -47,6 +62,8 @@
 #define NEOPIXEL_COLOR_MAGENTA        0x007F007F  /*> Color magenta */
 #define NEOPIXEL_COLOR_ROSE           0x00FF007D  /*> Color rose */
 
+#define NEOPIXEL_PALETTE_SIZE         16          /*> Colors in a gradient palette */
+
 #define NEOPIXEL_HUE_RED              0x0000      /*> Hue red */
 #define NEOPIXEL_HUE_ORANGE           0x1555      /*> Hue orange */
 #define NEOPIXEL_HUE_YELLOW           0x2AAA      /*> Hue yellow */
@@ -69,6 +86,23 @@
  * 0x000000FF -> Blue
  */
 typedef uint32_t neopixel_color_t;
+
+/**
+ * @brief Gradient palette, colors between entries are interpolated
+ * (the last entry blends back into the first one)
+ */
+typedef struct {
+	neopixel_color_t colors[NEOPIXEL_PALETTE_SIZE];	/*!< Equally spaced colors */
+} neopixel_palette_t;
+
+/**
+ * @brief When color changes are sent to the stripe
+ */
+typedef enum {
+	NEOPIXEL_SHOW_IMMEDIATE,	/*!< Every change is sent at once (default) */
+	NEOPIXEL_SHOW_MANUAL,		/*!< Changes are sent by NeoPixelShow() */
+	NEOPIXEL_SHOW_AUTO			/*!< Changes are sent periodically */
+} neopixel_show_t;
 /*==================[external data declaration]==============================*/
 
 /*==================[external functions declaration]=========================*/
@@ -82,9 +116,25 @@ typedef uint32_t neopixel_color_t;
  */
 void NeoPixelInit(gpio_t pin, uint16_t len, neopixel_color_t *color_array);
 
+/**
+ * @brief Send the changes made since the last frame.
+ * 
+ * @note Returns while the frame is being sent. Does nothing if there are no changes.
+ */
+void NeoPixelShow(void);
+
+/**
+ * @brief Select when changes are sent to the stripe.
+ * 
+ * @param mode  NEOPIXEL_SHOW_IMMEDIATE, NEOPIXEL_SHOW_MANUAL or NEOPIXEL_SHOW_AUTO
+ * @param fps   Frames per second (only used with NEOPIXEL_SHOW_AUTO)
+ */
+void NeoPixelShowMode(neopixel_show_t mode, uint16_t fps);
+
 /**
  * @brief Turn off all NeoPixels.
  * 
+ * @note Colors are kept, the next frame with changes turns the stripe on again.
  */
 void NeoPixelAllOff(void);
 
@@ -103,9 +153,71 @@ void NeoPixelAllColor(neopixel_color_t color);
  */
 void NeoPixelSetPixel(uint16_t pixel, neopixel_color_t color);
 
+/**
+ * @brief Set consecutive pixels to a color.
+ * 
+ * @param first     First NeoPixel
+ * @param qty       Number of NeoPixels
+ * @param color     24 bits color
+ */
+void NeoPixelFill(uint16_t first, uint16_t qty, neopixel_color_t color);
+
+/**
+ * @brief Set consecutive pixels with the colors stored in an array.
+ * 
+ * @param first     First NeoPixel
+ * @param qty       Number of NeoPixels
+ * @param colors    Array of qty 24 bits colors
+ */
+void NeoPixelSetRange(uint16_t first, uint16_t qty, const neopixel_color_t *colors);
+
+/**
+ * @brief Rotate the colors of consecutive pixels.
+ * 
+ * @param first     First NeoPixel
+ * @param qty       Number of NeoPixels
+ * @param steps     Number of positions
+ * @param upwards   Direction: true: upwards, false: downwards.
+ */
+void NeoPixelRotate(uint16_t first, uint16_t qty, uint16_t steps, bool upwards);
+
+/**
+ * @brief Parallel stripes initialization.
+ * 
+ * @param pins  Array of GPIO numbers where each stripe data pin (DIN) will be connected
+ * @param qty   Number of stripes (1 to WS2812B_MAX_STRIPS)
+ * @return true if the stripes were initialized (see ws2812bParallelInit())
+ */
+bool NeoPixelParallelInit(gpio_t *pins, uint8_t qty);
+
+/**
+ * @brief Send the colors of every parallel stripe at once.
+ * 
+ * @note Blocks until the frame has been sent (30us per led of the longest stripe).
+ * @param color_arrays  Array of 24 bits colors of each stripe
+ * @param len           Number of NeoPixels of each stripe
+ */
+void NeoPixelParallelShow(neopixel_color_t *const color_arrays[], const uint16_t len[]);
+
+/**
+ * @brief Get the number of NeoPixels in the stripe.
+ * 
+ * @return uint16_t Stripe length
+ */
+uint16_t NeoPixelLength(void);
+
+/**
+ * @brief Get the color of an individual pixel.
+ * 
+ * @param pixel     NeoPixel number on the stripe
+ * @return neopixel_color_t 24 bits color
+ */
+neopixel_color_t NeoPixelGetPixel(uint16_t pixel);
+
 /**
  * @brief Set all NeoPixels in the array with the color stored in an array.
  * 
+ * @note Call it with the array passed to NeoPixelInit() after writing it directly.
  * @param color_array Array of 24 bits color
  */
 void NeoPixelSetArray(neopixel_color_t *color_array);
@@ -147,6 +259,52 @@ neopixel_color_t NeoPixelRgb2Color(uint8_t red, uint8_t green, uint8_t blue);
  */
 neopixel_color_t NeoPixelHSV2Color(uint16_t hue, uint8_t sat, uint8_t val);
 
+/**
+ * @brief Convert a sequence of equally spaced hues to 24 bits colors.
+ * 
+ * @note Hues are 16.16 fixed point values, so the step between pixels
+ * is computed once and no divisions are needed inside the loop.
+ * @param color_array   Array to store qty colors
+ * @param qty           Number of colors
+ * @param first_hue     Hue of the first color (16.16 fixed point: hue << 16)
+ * @param hue_step      Hue increment between colors (16.16 fixed point)
+ * @param sat           Color saturation (HSV color model)
+ * @param val           Color value or brightness (HSV color model)
+ */
+void NeoPixelHSV2ColorArray(neopixel_color_t *color_array, uint16_t qty, uint32_t first_hue,
+                            uint32_t hue_step, uint8_t sat, uint8_t val);
+
+/**
+ * @brief Mix two colors.
+ * 
+ * @param c1    Color for frac = 0
+ * @param c2    Color for frac = 256 (255 is c2 within one level)
+ * @param frac  Weight of c2
+ * @return neopixel_color_t 24 bits color
+ */
+neopixel_color_t NeoPixelBlend(neopixel_color_t c1, neopixel_color_t c2, uint8_t frac);
+
+/**
+ * @brief Get a color from a gradient palette.
+ * 
+ * @param palette   Gradient palette
+ * @param index     Position in the palette (0 to 65535, 4096 between entries)
+ * @return neopixel_color_t 24 bits color
+ */
+neopixel_color_t NeoPixelPaletteColor(const neopixel_palette_t *palette, uint16_t index);
+
+/**
+ * @brief Fill an array with equally spaced colors of a gradient palette.
+ * 
+ * @param palette       Gradient palette
+ * @param color_array   Array to store qty colors
+ * @param qty           Number of colors
+ * @param first_index   Palette position of the first color (16.16 fixed point: index << 16)
+ * @param index_step    Position increment between colors (16.16 fixed point)
+ */
+void NeoPixelPaletteArray(const neopixel_palette_t *palette, neopixel_color_t *color_array,
+                          uint16_t qty, uint32_t first_index, uint32_t index_step);
+
 /**
  * @brief Set all NeoPixels with a gradient of colors. 
  * 
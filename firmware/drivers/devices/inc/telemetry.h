@@ -0,0 +1,118 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Devices Drivers devices
+ ** @{ */
+/** \addtogroup Telemetry Telemetry
+ ** @{ */
+
+/** \brief Binary telemetry over a serial port.
+ *
+ * Samples are pushed to typed channels and stored until a frame is full (or
+ * TelemetryFlush() is called), so many samples share one frame. Frames are
+ * protected with a CRC-16 and COBS encoded, so a 0x00 byte always marks a
+ * frame end and the receiver can resynchronize after lost bytes.
+ *
+ * Frame (before COBS encoding, multi-byte values little endian):
+ * |  Field  | Size        | Description                                     |
+ * |:-------:|:-----------:|:------------------------------------------------|
+ * | seq     | 1           | Frame counter (detects lost frames)             |
+ * | id      | 1           | Channel number  \                               |
+ * | type    | 1           | telemetry_type_t | repeated for each channel    |
+ * | qty     | 1           | Number of samples | with samples                |
+ * | samples | qty * size  | Samples         /                               |
+ * | crc     | 2           | CRC-16/CCITT-FALSE of the previous bytes        |
+ *
+ * @note firmware/tools/telemetry_decode.py decodes the frames on the PC.
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 19/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "uart_mcu.h"
+/*==================[macros]=================================================*/
+#define TELEMETRY_MAX_CHANNELS      16      /*!< Channels 0 to TELEMETRY_MAX_CHANNELS - 1 */
+#define TELEMETRY_CHANNEL_BYTES     64      /*!< Samples stored per channel before sending */
+#define TELEMETRY_FRAME_BYTES       256     /*!< Max frame size before COBS encoding */
+/*==================[typedef]================================================*/
+/**
+ * @brief Sample types
+ */
+typedef enum {
+	TELEMETRY_U8,		/*!< uint8_t */
+	TELEMETRY_I8,		/*!< int8_t */
+	TELEMETRY_U16,		/*!< uint16_t */
+	TELEMETRY_I16,		/*!< int16_t */
+	TELEMETRY_U32,		/*!< uint32_t */
+	TELEMETRY_I32,		/*!< int32_t */
+	TELEMETRY_FLOAT		/*!< float */
+} telemetry_type_t;
+
+/**
+ * @brief Frame counters
+ */
+typedef struct {
+	uint32_t frames;	/*!< Frames sent */
+	uint32_t bytes;		/*!< Bytes sent (after encoding) */
+	uint32_t samples;	/*!< Samples sent */
+} telemetry_stats_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Telemetry initialization
+ *
+ * @note The serial port must be initialized with UartInit().
+ * @param port Serial port used to send frames
+ */
+void TelemetryInit(uart_mcu_port_t port);
+
+/**
+ * @brief Declare a channel
+ *
+ * @param id Channel number (0 to TELEMETRY_MAX_CHANNELS - 1)
+ * @param type Type of the channel samples
+ * @return true if the channel was declared
+ */
+bool TelemetryChannel(uint8_t id, telemetry_type_t type);
+
+/**
+ * @brief Add samples to a channel
+ *
+ * @note If the channel is full, stored samples of every channel are sent first.
+ * @param id Channel number
+ * @param samples Pointer to an array of samples of the channel type
+ * @param qty Number of samples
+ * @return true if the samples were added
+ */
+bool TelemetryPush(uint8_t id, const void *samples, uint8_t qty);
+
+/**
+ * @brief Send the stored samples of every channel
+ */
+void TelemetryFlush(void);
+
+/**
+ * @brief Get frame counters
+ *
+ * @param stats Pointer to store the counters
+ */
+void TelemetryGetStats(telemetry_stats_t *stats);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif
+
+/*==================[end of file]============================================*/
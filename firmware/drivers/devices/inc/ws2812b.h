@@ -9,6 +9,14 @@
  ** @{ */
 
 /** \brief Driver for handling WS2812B RGB leds.
+ *
+ * Bits are generated by the RMT peripheral, so timing does not depend on the
+ * CPU and interrupts do not corrupt the frame. A whole frame is sent with
+ * ws2812bTransmit() while the CPU keeps running.
+ *
+ * Up to 8 stripes can also be driven at once through a dedicated GPIO bundle
+ * (ws2812bParallelInit()): the same bit of every stripe is sent in the same
+ * period, so a frame takes the time of the longest stripe.
  *
  * @note For handling NeoPixels arrays use "neopixel_stripe.h".
  * 
@@ -19,15 +27,19 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 23/10/2023 | Document creation		                         						|
+ * | 19/10/2026 | RMT output, asynchronous frames		                         				|
+ * | 19/10/2026 | Parallel output of up to 8 stripes		                         			|
  * 
  **/
 
 /*==================[inclusions]=============================================*/
 #include <stdint.h>
+#include <stdbool.h>
 #include "sdkconfig.h"
 #include "esp_err.h"
 #include "gpio_mcu.h"
 /*==================[macros]=================================================*/
+#define WS2812B_MAX_STRIPS      8       /*> Max stripes driven by ws2812bParallelTransmit() */
 
 /*==================[typedef]================================================*/
 /**
@@ -51,15 +63,81 @@ typedef struct rgb_led{
 void ws2812bInit(gpio_t pin);
 
 /**
- * @brief Send color information to NeoPixel.
+ * @brief Set a function to be called each time a frame has been sent.
+ * 
+ * @note The function is called from the RMT interrupt.
+ * @param func_p    Function to be called (NULL to disable)
+ * @param param_p   Parameter passed to func_p
+ */
+void ws2812bSetCallback(void (*func_p)(void *param), void *param_p);
+
+/**
+ * @brief Send a frame (3 bytes per led, in G, R, B order) followed by the ret command.
+ * 
+ * @note The function returns as soon as the frame is queued. grb must not be
+ * modified until the frame has been sent (see ws2812bWait() and ws2812bSetCallback()).
+ * @param grb   Frame data (already gamma corrected)
+ * @param len   Frame length in bytes
+ * @return ESP_OK if the frame was queued
+ */
+esp_err_t ws2812bTransmit(const uint8_t *grb, uint32_t len);
+
+/**
+ * @brief Check if there are frames being sent.
+ * 
+ * @return true if busy
+ */
+bool ws2812bBusy(void);
+
+/**
+ * @brief Wait until all queued frames have been sent.
+ * 
+ * @param timeout_ms Max wait (-1 to wait forever)
+ * @return ESP_OK if done, ESP_ERR_TIMEOUT otherwise
+ */
+esp_err_t ws2812bWait(int32_t timeout_ms);
+
+/**
+ * @brief Gamma correction of a color component.
+ * 
+ * @param component Color level (0 to 255)
+ * @return Corrected level
+ */
+uint8_t ws2812bGammaCorrection(uint8_t component);
+
+/**
+ * @brief Parallel output initialization.
+ * 
+ * @param pins  Array of GPIO numbers where each stripe data pin (DIN) will be connected
+ * @param qty   Number of stripes (1 to WS2812B_MAX_STRIPS)
+ * @return true if the output was initialized, false if qty is not valid, it
+ * was already initialized or there are not enough free dedicated GPIO channels
+ */
+bool ws2812bParallelInit(gpio_t *pins, uint8_t qty);
+
+/**
+ * @brief Send a frame to every stripe at once, followed by the ret command.
+ * 
+ * @note Bits are timed by the CPU. Interrupts are disabled while each led is
+ * sent (30us) and enabled between leds, the scheduler is suspended for the
+ * whole frame. Blocks until the frame has been sent.
+ * @param grb   Frame data of each stripe (3 bytes per led, in G, R, B order, already gamma corrected)
+ * @param len   Frame length of each stripe in bytes
+ */
+void ws2812bParallelTransmit(const uint8_t *const grb[], const uint32_t len[]);
+
+/**
+ * @brief Add color information for the next NeoPixel.
  * 
+ * @note Colors are stored until ws2812bSendRet() is called.
  * @param data NeoPixel color
  */
 void ws2812bSend(rgb_led_t led_color);
 
 /**
- * @brief Send a ret command to NeoPixel.
+ * @brief Send the colors stored by ws2812bSend() followed by a ret command.
  * 
+ * @note Blocks until the frame has been sent.
  */
 void ws2812bSendRet(void);
 
@@ -8,21 +8,46 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <math.h>
 
 #include "hx711.h"
 
 #include <delay_mcu.h>
+#include "gpio_fast_out_mcu.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "driver/gpio.h"
+#include "hal/gpio_ll.h"
+#include "soc/gpio_struct.h"
+#include "esp_rom_sys.h"
+#include "nvs.h"
 
 /*==================[macros and definitions]=================================*/
+#define HX711_DATA_BITS		24			/*!<  Bits per conversion */
+#define HX711_SIGN_BIT		0x800000	/*!<  Converts 2's complement to offset binary */
+#define HX711_CLK_US		1			/*!<  PD_SCK high and low time (0.2 to 50 us) */
+#define HX711_RING_MASK		(HX711_BUFFER_SIZE - 1)
+#define HX711_NVS_NAMESPACE	"hx711"		/*!<  NVS namespace for calibrations */
 
 /*==================[internal data declaration]==============================*/
 uint8_t GAIN;		             /*!<  Amplification factor */
 double OFFSET;	                 /*!<  Used for tare weight */
-float SCALE;	                 /*!<  Used to return weight in grams, kg, ounces, whatever */ 
+float SCALE = 1;                 /*!<  Used to return weight in grams, kg, ounces, whatever */ 
 
 
 gpio_t internal_pd_sck;
 gpio_t internal_dout;
+static gpio_fast_t sck_pin;		/*!<  PD_SCK, dedicated GPIO output */
+static gpio_fast_t dout_pin;	/*!<  DOUT, dedicated GPIO input */
+
+static portMUX_TYPE hx711_lock = portMUX_INITIALIZER_UNLOCKED;	/*!<  Keeps PD_SCK high time under 60 us */
+static volatile bool continuous = false;				/*!<  Conversions are read from the DOUT interrupt */
+static uint32_t ring[HX711_BUFFER_SIZE];				/*!<  Samples read from the interrupt */
+static volatile uint16_t ring_head = 0;					/*!<  Written only by the interrupt */
+static volatile uint16_t ring_tail = 0;					/*!<  Written only by the reading task */
+static volatile uint32_t overruns = 0;					/*!<  Samples lost because the ring was full */
+static hx711_callback_t sample_isr_p = NULL;			/*!<  Callback for every new sample */
+static void *sample_user_data;							/*!<  Callback parameter */
 
 /*==================[internal functions declaration]=========================*/
 
@@ -32,31 +57,122 @@ uint8_t shiftIn(void)
 
     for (uint8_t i = 0; i < 8; ++i)
     {
-    	GPIOOn(internal_pd_sck);//PD_SCK_SET_HIGH;
-        value |= GPIORead(internal_dout) << (7 - i);
-        GPIOOff(internal_pd_sck);//PD_SCK_SET_LOW;
+    	GPIOFastWrite(&sck_pin, 1);//PD_SCK_SET_HIGH;
+        value |= GPIOFastRead(&dout_pin) << (7 - i);
+        GPIOFastWrite(&sck_pin, 0);//PD_SCK_SET_LOW;
     }
     return value;
 }
 
+/** Clock out one conversion (24 data bits + GAIN pulses for the next one).
+ * Pins are driven through dedicated GPIO channels. Must be called with
+ * hx711_lock taken: if PD_SCK stays high for more than 60 us the chip
+ * powers down.
+ */
+static uint32_t IRAM_ATTR HX711_shiftIn24(void)
+{
+	uint32_t count = 0;
+
+	for (uint8_t i = 0; i < HX711_DATA_BITS; i++)
+	{
+		GPIOFastWrite(&sck_pin, 1);
+		esp_rom_delay_us(HX711_CLK_US);
+		GPIOFastWrite(&sck_pin, 0);
+		esp_rom_delay_us(HX711_CLK_US);
+		count = (count << 1) | GPIOFastRead(&dout_pin);
+	}
+	for (uint8_t i = 0; i < GAIN; i++)
+	{
+		GPIOFastWrite(&sck_pin, 1);
+		esp_rom_delay_us(HX711_CLK_US);
+		GPIOFastWrite(&sck_pin, 0);
+		esp_rom_delay_us(HX711_CLK_US);
+	}
+	return count ^ HX711_SIGN_BIT;
+}
+
+/** Store one sample in the ring (single producer).
+ */
+static void IRAM_ATTR HX711_store(uint32_t sample)
+{
+	uint16_t next = (ring_head + 1) & HX711_RING_MASK;
+
+	if (next == ring_tail)
+	{
+		overruns++;
+	}
+	else
+	{
+		ring[ring_head] = sample;
+		ring_head = next;
+	}
+}
+
+/** Store one sample and notify the user, only from the DOUT interrupt.
+ */
+static void IRAM_ATTR HX711_push(uint32_t sample)
+{
+	HX711_store(sample);
+	if (sample_isr_p != NULL)
+	{
+		sample_isr_p(sample, sample_user_data);
+	}
+}
+
+/** DOUT falling edge: a conversion is ready.
+ * The edge interrupt is masked while clocking, since DOUT toggles with the
+ * data bits.
+ */
+static void IRAM_ATTR HX711_doutIsr(void *args)
+{
+	uint32_t sample;
+
+	gpio_ll_set_intr_type(&GPIO, internal_dout, GPIO_INTR_DISABLE);
+	portENTER_CRITICAL_ISR(&hx711_lock);
+	sample = HX711_shiftIn24();
+	portEXIT_CRITICAL_ISR(&hx711_lock);
+	gpio_ll_clear_intr_status(&GPIO, 1 << internal_dout);
+	gpio_ll_set_intr_type(&GPIO, internal_dout, GPIO_INTR_NEGEDGE);
+	HX711_push(sample);
+}
+
+/** Open the calibration namespace.
+ * NVS is initialized by the application (nvs_flash_init()), the driver never
+ * initializes or erases the partition.
+ */
+static esp_err_t HX711_nvsOpen(nvs_open_mode_t mode, nvs_handle_t *handle)
+{
+	return nvs_open(HX711_NVS_NAMESPACE, mode, handle);
+}
+
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
 
 /*==================[external functions definition]==========================*/
-void HX711_Init(uint8_t gain, gpio_t pd_sck, gpio_t dout)
+bool HX711_Init(uint8_t gain, gpio_t pd_sck, gpio_t dout)
 {
 	internal_pd_sck = pd_sck;
 	internal_dout = dout;
-	GPIOInit(pd_sck, GPIO_OUTPUT);//PD_SCK_SET_OUTPUT;
-	GPIOInit(dout, GPIO_INPUT);//DOUT_SET_INPUT;
+	GPIOFastDeinit(&sck_pin);
+	GPIOFastDeinit(&dout_pin);
+	if (!GPIOFastInit(&sck_pin, &pd_sck, 1, GPIO_FAST_OUTPUT))//PD_SCK_SET_OUTPUT;
+	{
+		return false;
+	}
+	if (!GPIOFastInit(&dout_pin, &dout, 1, GPIO_FAST_INPUT))//DOUT_SET_INPUT;
+	{
+		GPIOFastDeinit(&sck_pin);
+		return false;
+	}
     HX711_setGain(gain);
+    return true;
 
 }
 
 int HX711_isReady(void)
 {
-    return (GPIORead(internal_dout)) == 0;
+    return GPIOFastRead(&dout_pin) == 0;
 }
 
 void HX711_setGain(uint8_t gain)
@@ -74,71 +190,144 @@ void HX711_setGain(uint8_t gain)
 			break;
 	}
 
-	GPIOOff(internal_pd_sck);//PD_SCK_SET_LOW;
+	GPIOFastWrite(&sck_pin, 0);//PD_SCK_SET_LOW;
 	HX711_read();
 }
 
 uint32_t HX711_read(void)
 {
+	uint32_t count = 0;
+	TickType_t start = xTaskGetTickCount();
+
+	if (continuous)
+	{
+		// the interrupt owns the chip, take the next sample from the ring
+		while (!HX711_getSample(&count))
+		{
+			if ((xTaskGetTickCount() - start) > pdMS_TO_TICKS(HX711_TIMEOUT_MS))
+			{
+				return HX711_NO_SAMPLE;
+			}
+			vTaskDelay(1);
+		}
+		return count;
+	}
+
 	// wait for the chip to become ready
-	while (!HX711_isReady());
+	while (!HX711_isReady())
+	{
+		if ((xTaskGetTickCount() - start) > pdMS_TO_TICKS(HX711_TIMEOUT_MS))
+		{
+			return HX711_NO_SAMPLE;
+		}
+		vTaskDelay(1);
+	}
 
-    unsigned long count;
-    unsigned char i;
+	portENTER_CRITICAL(&hx711_lock);
+	count = HX711_shiftIn24();
+	portEXIT_CRITICAL(&hx711_lock);
+	return(count);
+}
 
-    GPIOOn(internal_dout);//DOUT_SET_HIGH;
+void HX711_startContinuous(hx711_callback_t func_p, void *param_p)
+{
+	uint32_t sample;
+
+	sample_isr_p = func_p;
+	sample_user_data = param_p;
+	ring_head = ring_tail = 0;
+	overruns = 0;
+	continuous = true;
+	GPIOActivInt(internal_dout, HX711_doutIsr, false, NULL);
+	// a conversion that was already waiting won't produce an edge; the
+	// interrupt stays off until it is stored, so the ring has one writer.
+	// The callback is not called here: it must only run in the interrupt
+	gpio_intr_disable(internal_dout);
+	if (HX711_isReady())
+	{
+		portENTER_CRITICAL(&hx711_lock);
+		sample = HX711_shiftIn24();
+		portEXIT_CRITICAL(&hx711_lock);
+		HX711_store(sample);
+	}
+	gpio_intr_enable(internal_dout);
+}
 
-    DelayUs(1);
+void HX711_stopContinuous(void)
+{
+	gpio_intr_disable(internal_dout);
+	gpio_isr_handler_remove(internal_dout);
+	continuous = false;
+}
 
-    GPIOOff(internal_pd_sck);//PD_SCK_SET_LOW;
-    DelayUs(1);
+uint16_t HX711_available(void)
+{
+	return (ring_head - ring_tail) & HX711_RING_MASK;
+}
 
-    count=0;
-    while(GPIORead(internal_dout));
-    for(i=0;i<24;i++)
-    {
-    	 GPIOOn(internal_pd_sck);//PD_SCK_SET_HIGH;
-    	 DelayUs(1);
-        count=count<<1;
-        GPIOOff(internal_pd_sck);//PD_SCK_SET_LOW;
-        DelayUs(1);
-        if(GPIORead(internal_dout))
-            count++;
-    }
-    count = count>>6;
-    GPIOOn(internal_pd_sck);//PD_SCK_SET_HIGH;
-    DelayUs(1);
-    GPIOOff(internal_pd_sck);//PD_SCK_SET_LOW;
-    DelayUs(1);
-    count ^= 0x800000;
-    return(count);
+bool HX711_getSample(uint32_t *sample)
+{
+	if (ring_tail == ring_head)
+	{
+		return false;
+	}
+	*sample = ring[ring_tail];
+	ring_tail = (ring_tail + 1) & HX711_RING_MASK;
+	return true;
+}
+
+uint32_t HX711_getOverruns(void)
+{
+	return overruns;
 }
 
 uint32_t HX711_readAverage(uint8_t times)
 {
 	uint32_t sum = 0;
+	uint32_t sample;
+	uint8_t valid = 0;
 	for (uint8_t i = 0; i < times; i++)
 	{
-		sum += HX711_read();
+		sample = HX711_read();
+		if (sample != HX711_NO_SAMPLE)
+		{
+			sum += sample;
+			valid++;
+		}
 		// TODO: See if yield will work | yield();
 	}
-	return sum / times;
+	if (valid == 0)
+	{
+		return HX711_NO_SAMPLE;
+	}
+	return sum / valid;
 }
 
 double HX711_getValue(uint8_t times)
 {
-	return HX711_readAverage(times) - OFFSET;
+	uint32_t average = HX711_readAverage(times);
+	if (average == HX711_NO_SAMPLE)
+	{
+		return NAN;
+	}
+	return average - OFFSET;
 }
 
 float HX711_getUnits(uint8_t times)
 {
-	return HX711_get_value(times) / SCALE;
+	return HX711_getValue(times) / SCALE;
 }
 
-void HX711_tare(uint8_t times)
+bool HX711_tare(uint8_t times)
 {
-	double sum = HX711_readAverage(times);
-	HX711_setOffset(sum);
+	uint32_t average = HX711_readAverage(times);
+	if (average == HX711_NO_SAMPLE)
+	{
+		// keep the last offset, the cell is not answering
+		return false;
+	}
+	HX711_setOffset(average);
+	return true;
 }
 
 void HX711_setScale(float scale)
@@ -163,14 +352,228 @@ double HX711_getOffset(void)
 
 void HX711_powerDown(void)
 {
-	GPIOOff(internal_pd_sck);//PD_SCK_SET_LOW;
-	GPIOOn(internal_pd_sck);//PD_SCK_SET_HIGH;
+	GPIOFastWrite(&sck_pin, 0);//PD_SCK_SET_LOW;
+	GPIOFastWrite(&sck_pin, 1);//PD_SCK_SET_HIGH;
 	DelayUs(70);
 }
 
 void HX711_powerUp(void)
 {
-	GPIOOff(internal_pd_sck);//PD_SCK_SET_LOW;
+	GPIOFastWrite(&sck_pin, 0);//PD_SCK_SET_LOW;
+}
+
+void HX711_filterInit(hx711_filter_t *filter, const hx711_filter_config_t *config)
+{
+	filter->config = *config;
+	if (filter->config.window == 0)
+	{
+		filter->config.window = 1;
+	}
+	if (filter->config.window > HX711_FILTER_WINDOW)
+	{
+		filter->config.window = HX711_FILTER_WINDOW;
+	}
+	HX711_filterReset(filter);
+}
+
+void HX711_filterReset(hx711_filter_t *filter)
+{
+	filter->index = 0;
+	filter->count = 0;
+	filter->sum = 0;
+	filter->sum_sq = 0;
+	filter->value = 0;
+	filter->stable_count = 0;
+	filter->settled = false;
 }
 
+bool HX711_filterUpdate(hx711_filter_t *filter, uint32_t sample)
+{
+	int32_t raw = (int32_t)sample - HX711_SIGN_BIT;
+	uint8_t window = filter->config.window;
+	float stage, variance, limit;
+
+	if (sample == HX711_NO_SAMPLE)
+	{
+		return false;
+	}
 
+	/* Moving window: O(1) running sums, oldest sample replaced in place */
+	if (filter->count == window)
+	{
+		int32_t old = filter->ring[filter->index];
+		filter->sum -= old;
+		filter->sum_sq -= (int64_t)old * old;
+	}
+	else
+	{
+		filter->count++;
+	}
+	filter->ring[filter->index] = raw;
+	filter->sum += raw;
+	filter->sum_sq += (int64_t)raw * raw;
+	filter->index = (filter->index + 1 < window) ? filter->index + 1 : 0;
+
+	if (filter->config.mode == HX711_FILTER_MEDIAN)
+	{
+		/* Insertion sort of a copy, window is at most HX711_FILTER_WINDOW */
+		int32_t sorted[HX711_FILTER_WINDOW];
+		for (uint8_t i = 0; i < filter->count; i++)
+		{
+			int32_t v = filter->ring[i];
+			int8_t j = i - 1;
+			while (j >= 0 && sorted[j] > v)
+			{
+				sorted[j + 1] = sorted[j];
+				j--;
+			}
+			sorted[j + 1] = v;
+		}
+		stage = (filter->count & 1) ? sorted[filter->count / 2] :
+				((float)sorted[filter->count / 2 - 1] + sorted[filter->count / 2]) / 2;
+	}
+	else
+	{
+		stage = (float)filter->sum / filter->count;
+	}
+
+	/* Low-pass: y += alpha * (x - y), first sample initializes the output */
+	if ((filter->count == 1) || (filter->config.iir_alpha <= 0) || (filter->config.iir_alpha >= 1))
+	{
+		filter->value = stage;
+	}
+	else
+	{
+		filter->value += filter->config.iir_alpha * (stage - filter->value);
+	}
+
+	/* Stability: window variance under threshold for settle_samples in a row */
+	variance = (float)((int64_t)filter->count * filter->sum_sq - filter->sum * filter->sum) /
+			   (filter->count * filter->count);
+	limit = filter->config.settle_std * filter->config.settle_std;
+	if ((filter->count == window) && (variance <= limit))
+	{
+		if (filter->stable_count < filter->config.settle_samples)
+		{
+			filter->stable_count++;
+		}
+	}
+	else
+	{
+		filter->stable_count = 0;
+	}
+	filter->settled = (filter->count == window) && (filter->stable_count >= filter->config.settle_samples);
+	return filter->settled;
+}
+
+float HX711_filterValue(const hx711_filter_t *filter)
+{
+	return filter->value;
+}
+
+bool HX711_filterSettled(const hx711_filter_t *filter)
+{
+	return filter->settled;
+}
+
+void HX711_calibrationClear(hx711_calibration_t *cal)
+{
+	cal->points = 0;
+	cal->tare = 0;
+}
+
+bool HX711_calibrationAddPoint(hx711_calibration_t *cal, float raw, float units)
+{
+	int8_t i;
+
+	if (cal->points >= HX711_CAL_POINTS)
+	{
+		return false;
+	}
+	/* Keep points sorted by raw value */
+	for (i = cal->points - 1; (i >= 0) && (cal->raw[i] > raw); i--)
+	{
+		cal->raw[i + 1] = cal->raw[i];
+		cal->units[i + 1] = cal->units[i];
+	}
+	cal->raw[i + 1] = raw;
+	cal->units[i + 1] = units;
+	cal->points++;
+	return true;
+}
+
+float HX711_calibrationApply(const hx711_calibration_t *cal, float raw)
+{
+	float units;
+	uint8_t seg = 0;
+
+	if (cal->points == 0)
+	{
+		/* Not calibrated: same conversion as HX711_getUnits() */
+		units = (raw + HX711_SIGN_BIT - OFFSET) / SCALE;
+	}
+	else if (cal->points == 1)
+	{
+		/* Line through the tare offset and the single point */
+		float zero = OFFSET - HX711_SIGN_BIT;
+		units = (raw - zero) * cal->units[0] / (cal->raw[0] - zero);
+	}
+	else
+	{
+		/* Piecewise linear, end segments are extrapolated */
+		while ((seg < cal->points - 2) && (raw > cal->raw[seg + 1]))
+		{
+			seg++;
+		}
+		units = cal->units[seg] + (raw - cal->raw[seg]) *
+				(cal->units[seg + 1] - cal->units[seg]) / (cal->raw[seg + 1] - cal->raw[seg]);
+	}
+	return units - cal->tare;
+}
+
+void HX711_calibrationTare(hx711_calibration_t *cal, const hx711_filter_t *filter)
+{
+	cal->tare = 0;
+	cal->tare = HX711_calibrationApply(cal, filter->value);
+}
+
+float HX711_filterUnits(const hx711_filter_t *filter, const hx711_calibration_t *cal)
+{
+	return HX711_calibrationApply(cal, filter->value);
+}
+
+esp_err_t HX711_calibrationSave(const hx711_calibration_t *cal, const char *key)
+{
+	nvs_handle_t handle;
+	esp_err_t ret = HX711_nvsOpen(NVS_READWRITE, &handle);
+	if (ret != ESP_OK)
+	{
+		return ret;
+	}
+	ret = nvs_set_blob(handle, key, cal, sizeof(hx711_calibration_t));
+	if (ret == ESP_OK)
+	{
+		ret = nvs_commit(handle);
+	}
+	nvs_close(handle);
+	return ret;
+}
+
+esp_err_t HX711_calibrationLoad(hx711_calibration_t *cal, const char *key)
+{
+	nvs_handle_t handle;
+	size_t len = sizeof(hx711_calibration_t);
+	esp_err_t ret = HX711_nvsOpen(NVS_READONLY, &handle);
+	if (ret != ESP_OK)
+	{
+		return ret;
+	}
+	ret = nvs_get_blob(handle, key, cal, &len);
+	nvs_close(handle);
+	if ((ret == ESP_OK) && ((len != sizeof(hx711_calibration_t)) || (cal->points > HX711_CAL_POINTS)))
+	{
+		HX711_calibrationClear(cal);
+		ret = ESP_ERR_INVALID_SIZE;
+	}
+	return ret;
+}
@@ -10,8 +10,13 @@
  */
 
 /*==================[inclusions]=============================================*/
+#include <stddef.h>
 #include "lcditse0803.h"
 #include "gpio_mcu.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#include "esp_rom_sys.h"
 /*==================[macros and definitions]=================================*/
 #define GPIO_BCD_1	GPIO_20
 #define GPIO_BCD_2	GPIO_21
@@ -20,21 +25,115 @@
 #define GPIO_SEL_1	GPIO_19
 #define GPIO_SEL_2	GPIO_18
 #define GPIO_SEL_3	GPIO_9
+#define BCD_SHIFT	GPIO_BCD_1	/* BCD_1 to BCD_4 are consecutive GPIOs */
+#define BCD_MASK	(0x0F << BCD_SHIFT)
+#define BCD_BLANK	0x0F		/* Codes over 9 turn the digit off */
+#define VALUE_BLANK	0xFFFF		/* Display turned off */
+#define LATCH_US	1		/* BCD setup time and select pulse width */
+#define REFRESH_PERIOD_US	1000	/* Brightness step (period of 10 ms with LCD_ITSE0803_BRIGHTNESS_MAX = 10) */
 /*==================[internal data definition]===============================*/
-static uint16_t actual_value = 0; /*variable that saves the value to be shown in the display LCD*/
+static volatile uint16_t actual_value = 0; /*variable that saves the value to be shown in the display LCD*/
+static volatile bool display_on = true;		/* false after LcdItsE0803Off() */
+static volatile uint8_t brightness = LCD_ITSE0803_BRIGHTNESS_MAX;
+static volatile uint16_t blink_period = 0;	/* Blink period in ms (0: no blink) */
+static uint16_t shown_value = VALUE_BLANK;	/* Value latched in the display */
+static uint32_t ticks = 0;					/* Refresh periods */
+static bool periodic = false;				/* Refresh timer running periodically */
+static esp_timer_handle_t refresh_timer = NULL;
+static SemaphoreHandle_t update_mutex = NULL;	/* periodic and the timer state are changed from several tasks */
 /*==================[internal functions declaration]=========================*/
 /** @brief Aux function to load a digit to the LCD Display
  *
  */
 bool LcdItsE0803BCDtoPin(uint8_t value){
-	GPIOState(GPIO_BCD_1, (value & (1<<0))>>0);
-	GPIOState(GPIO_BCD_2, (value & (1<<1))>>1);
-	GPIOState(GPIO_BCD_3, (value & (1<<2))>>2);
-	GPIOState(GPIO_BCD_4, (value & (1<<3))>>3);
+	uint32_t bcd = ((uint32_t)value << BCD_SHIFT) & BCD_MASK;
+	/* The four BCD lines change at the same time */
+	GPIOWriteMask(bcd, BCD_MASK & ~bcd);
 	return true;
 }
+
+/** @brief Aux function to load a digit and latch it with its select line
+ *
+ */
+static void LcdItsE0803Digit(uint8_t value, gpio_t sel){
+	LcdItsE0803BCDtoPin(value);
+	esp_rom_delay_us(LATCH_US);
+	GPIOWriteMask(GPIO_MASK(sel), 0);
+	esp_rom_delay_us(LATCH_US);
+	GPIOWriteMask(0, GPIO_MASK(sel));
+}
+
+/** @brief Refresh timer callback, latches the digits only when what must be shown changes
+ *
+ */
+static void LcdItsE0803Refresh(void *param){
+	uint16_t value = display_on ? actual_value : VALUE_BLANK;
+	uint16_t period = blink_period;
+	uint8_t hundreds, tens;
+
+	ticks++;
+	if(period > 0 && (ticks * (REFRESH_PERIOD_US / 1000)) % period >= period / 2){
+		value = VALUE_BLANK;
+	}
+	if(ticks % LCD_ITSE0803_BRIGHTNESS_MAX >= brightness){
+		value = VALUE_BLANK;
+	}
+	if(value == shown_value){
+		return;
+	}
+	shown_value = value;
+	if(value == VALUE_BLANK){
+		LcdItsE0803Digit(BCD_BLANK, GPIO_SEL_1);
+		LcdItsE0803Digit(BCD_BLANK, GPIO_SEL_2);
+		LcdItsE0803Digit(BCD_BLANK, GPIO_SEL_3);
+		return;
+	}
+	hundreds = value / 100;
+	value -= hundreds * 100;
+	tens = value / 10;
+	LcdItsE0803Digit(hundreds, GPIO_SEL_1);
+	LcdItsE0803Digit(tens, GPIO_SEL_2);
+	LcdItsE0803Digit(value - tens * 10, GPIO_SEL_3);
+}
+
+/** @brief Aux function to run the refresh: periodically while blinking or dimmed, once in other case
+ *
+ */
+static void LcdItsE0803Update(void){
+	bool need_periodic;
+
+	if(update_mutex == NULL){
+		return;
+	}
+	xSemaphoreTake(update_mutex, portMAX_DELAY);
+	/* Read under the mutex, so the last caller always sets the final state */
+	need_periodic = (blink_period > 0) || (brightness < LCD_ITSE0803_BRIGHTNESS_MAX);
+	if(refresh_timer == NULL){
+		xSemaphoreGive(update_mutex);
+		return;
+	}
+	if(need_periodic != periodic){
+		esp_timer_stop(refresh_timer);
+		periodic = need_periodic;
+		if(periodic){
+			esp_timer_start_periodic(refresh_timer, REFRESH_PERIOD_US);
+		}
+	}
+	if(!periodic){
+		/* Fails if a refresh is already pending, which shows the new value anyway */
+		esp_timer_start_once(refresh_timer, 0);
+	}
+	xSemaphoreGive(update_mutex);
+}
 /*==================[external functions definition]==========================*/
 bool LcdItsE0803Init(void){
+	esp_timer_create_args_t timer_args = {
+		.callback = LcdItsE0803Refresh,
+		.arg = NULL,
+		.dispatch_method = ESP_TIMER_TASK,
+		.name = "lcditse0803",
+	};
+
 	/* Configuration of pins of data*/
 	GPIOInit(GPIO_BCD_1, GPIO_OUTPUT);
 	GPIOInit(GPIO_BCD_2, GPIO_OUTPUT);
@@ -46,34 +145,27 @@ bool LcdItsE0803Init(void){
 	GPIOInit(GPIO_SEL_2, GPIO_OUTPUT);
 	GPIOInit(GPIO_SEL_3, GPIO_OUTPUT);
 
+	if(update_mutex == NULL){
+		update_mutex = xSemaphoreCreateMutex();
+		if(update_mutex == NULL){
+			return false;
+		}
+	}
+	if(refresh_timer == NULL && esp_timer_create(&timer_args, &refresh_timer) != ESP_OK){
+		return false;
+	}
+	shown_value = VALUE_BLANK;
+	periodic = false;
 	actual_value=0;
 	LcdItsE0803Write(actual_value);
 	return true;
 };
 
 bool LcdItsE0803Write(uint16_t value) {
-	uint8_t units, tens, hundreds;
 	if(value<1000)	 {
 		actual_value = value;
-
-		hundreds = value/100;
-		tens = (value-(hundreds*100))/10;
-		units = (value-(hundreds*100)-(tens*10));
-
-		/* Write hundreds */
-		LcdItsE0803BCDtoPin(hundreds);
-		GPIOOn(GPIO_SEL_1);
-		GPIOOff(GPIO_SEL_1);
-
-		/* Write tens */
-		LcdItsE0803BCDtoPin(tens);
-		GPIOOn(GPIO_SEL_2);
-		GPIOOff(GPIO_SEL_2);
-
-		/* Write units */
-		LcdItsE0803BCDtoPin(units);
-		GPIOOn(GPIO_SEL_3);
-		GPIOOff(GPIO_SEL_3);
+		display_on = true;
+		LcdItsE0803Update();
 		return true; /* return 1 for values lower than 999 */
 	}
 	else
@@ -85,20 +177,32 @@ uint16_t LcdItsE0803Read(void){
 }
 
 void LcdItsE0803Off(void){
-	LcdItsE0803BCDtoPin(0x0F);
-	GPIOOn(GPIO_SEL_1);
-	GPIOOff(GPIO_SEL_1);
+	display_on = false;
+	LcdItsE0803Update();
+}
 
-	LcdItsE0803BCDtoPin(0x0F);
-	GPIOOn(GPIO_SEL_2);
-	GPIOOff(GPIO_SEL_2);
+void LcdItsE0803Blink(uint16_t period_ms){
+	blink_period = period_ms;
+	LcdItsE0803Update();
+}
 
-	LcdItsE0803BCDtoPin(0x0F);
-	GPIOOn(GPIO_SEL_3);
-	GPIOOff(GPIO_SEL_3);
+void LcdItsE0803Brightness(uint8_t level){
+	brightness = (level > LCD_ITSE0803_BRIGHTNESS_MAX) ? LCD_ITSE0803_BRIGHTNESS_MAX : level;
+	LcdItsE0803Update();
 }
 
 bool LcdItsE0803DeInit(void){
+	if(update_mutex != NULL){
+		xSemaphoreTake(update_mutex, portMAX_DELAY);
+	}
+	if(refresh_timer != NULL){
+		esp_timer_stop(refresh_timer);
+		esp_timer_delete(refresh_timer);
+		refresh_timer = NULL;
+	}
+	if(update_mutex != NULL){
+		xSemaphoreGive(update_mutex);
+	}
 	GPIODeinit();
 	return true;
 }
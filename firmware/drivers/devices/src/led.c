@@ -16,6 +16,7 @@
 #define GPIO_LED1 GPIO_11
 #define GPIO_LED2 GPIO_10
 #define GPIO_LED3 GPIO_5
+#define LEDS_GPIO_MASK (GPIO_MASK(GPIO_LED1) | GPIO_MASK(GPIO_LED2) | GPIO_MASK(GPIO_LED3))
 /*==================[internal data declaration]==============================*/
 
 /*==================[internal functions declaration]=========================*/
@@ -35,9 +36,7 @@ uint8_t LedsInit(void){
 	GPIOInit(GPIO_LED3, GPIO_OUTPUT);
 
 	/** Turn off leds*/
-	GPIOOff(GPIO_LED1);
-	GPIOOff(GPIO_LED2);
-	GPIOOff(GPIO_LED3);
+	GPIOWriteMask(0, LEDS_GPIO_MASK);
 
 	return true;
 }
@@ -103,17 +102,24 @@ uint8_t LedToggle(led_t led){
 }
 
 uint8_t LedsOffAll(void){
-	GPIOOff(GPIO_LED1);
-	GPIOOff(GPIO_LED2);
-	GPIOOff(GPIO_LED3);
+	GPIOWriteMask(0, LEDS_GPIO_MASK);
 	
 	return true;
 }
 
 uint8_t LedsMask(uint8_t mask){
-	GPIOState(GPIO_LED1, (mask & LED_1) >> 2);
-	GPIOState(GPIO_LED2, (mask & LED_2) >> 1);
-	GPIOState(GPIO_LED3, (mask & LED_3));
+	uint32_t on = 0;
+	if(mask & LED_1){
+		on |= GPIO_MASK(GPIO_LED1);
+	}
+	if(mask & LED_2){
+		on |= GPIO_MASK(GPIO_LED2);
+	}
+	if(mask & LED_3){
+		on |= GPIO_MASK(GPIO_LED3);
+	}
+	/* Every led changes at the same time */
+	GPIOWriteMask(on, LEDS_GPIO_MASK & ~on);
 	return true;
 }
 
@@ -17,40 +17,59 @@
 #define I2C_NUM I2C_NUM_0
 
 /*==================[internal data definition]===============================*/
-uint8_t devAddr;
-uint8_t buffer[14];
+static mpu6050_t mpu_default = {		/*!< Context used by the single device API */
+	.address = MPU6050_DEFAULT_ADDRESS,
+};
+static const uint8_t hmc5883l_init[] = {
+	0x00, 0x18,		/* CRA: 1 sample averaged, 75 Hz output rate */
+	0x01, 0x20,		/* CRB: +/- 1.3 Ga */
+	0x02, 0x00,		/* MODE: continuous measurement */
+};
+static const uint8_t bmp280_init[] = {
+	0xF5, 0x00,		/* CONFIG: 0.5 ms standby, filter off */
+	0xF4, 0x27,		/* CTRL_MEAS: temperature x1, pressure x1, normal mode */
+};
+/*==================[external data definition]===============================*/
+const mpu6050_aux_sensor_t MPU6050_AUX_HMC5883L = {
+	.address = 0x1E,
+	.data_reg = 0x03,
+	.data_len = 6,
+	.byte_swap = false,
+	.init = hmc5883l_init,
+	.init_len = sizeof(hmc5883l_init) / 2,
+};
+const mpu6050_aux_sensor_t MPU6050_AUX_BMP280 = {
+	.address = 0x76,
+	.data_reg = 0xF7,
+	.data_len = 6,
+	.byte_swap = false,
+	.init = bmp280_init,
+	.init_len = sizeof(bmp280_init) / 2,
+};
 /*==================[internal functions declaration]=========================*/
+/** Unpack accel, temperature and gyro words from a burst or FIFO frame.
+ */
+static void MPU6050_ParseMotion(const uint8_t *b, mpu6050_motion_t *motion) {
+	motion->ax = (((int16_t)b[0]) << 8) | b[1];
+	motion->ay = (((int16_t)b[2]) << 8) | b[3];
+	motion->az = (((int16_t)b[4]) << 8) | b[5];
+	motion->temp = (((int16_t)b[6]) << 8) | b[7];
+	motion->gx = (((int16_t)b[8]) << 8) | b[9];
+	motion->gy = (((int16_t)b[10]) << 8) | b[11];
+	motion->gz = (((int16_t)b[12]) << 8) | b[13];
+}
 
 /*==================[external functions definition]==========================*/
 void MPU6050_ReadRegister(uint8_t reg, uint8_t *data, uint8_t len){
-	uint8_t dev = 0x68;
-	i2c_cmd_handle_t cmd;
-	I2C_SelectRegister(dev, reg);
-
-	cmd = i2c_cmd_link_create();
-	ESP_ERROR_CHECK(i2c_master_start(cmd));
-	ESP_ERROR_CHECK(i2c_master_write_byte(cmd, (dev << 1) | I2C_MASTER_READ, 1));
-
-	if(len>1)
-		ESP_ERROR_CHECK(i2c_master_read(cmd, data, len, I2C_MASTER_ACK));
-
-	ESP_ERROR_CHECK(i2c_master_read_byte(cmd, data+len-1, I2C_MASTER_NACK));
-
-	ESP_ERROR_CHECK(i2c_master_stop(cmd));
-	ESP_ERROR_CHECK(i2c_master_cmd_begin(I2C_NUM, cmd, 1000));
-	i2c_cmd_link_delete(cmd);
+	MPU6050_DevReadRegister(&mpu_default, reg, data, len);
 }
 
 void MPU6050_Address(uint8_t address) {
-    devAddr = address;
+    mpu_default.address = address;
 }
 
 void MPU6050_initialize() {
-	devAddr = MPU6050_DEFAULT_ADDRESS;
-    MPU6050_setClockSource(MPU6050_CLOCK_PLL_XGYRO);
-    MPU6050_setFullScaleGyroRange(MPU6050_GYRO_FS_250);
-    MPU6050_setFullScaleAccelRange(MPU6050_ACCEL_FS_2);
-    MPU6050_setSleepEnabled(false); // thanks to Jack Elston for pointing this one out!
+	MPU6050_DevInit(&mpu_default, mpu_default.address);
 }
 
 /** Verify the I2C connection.
@@ -69,8 +88,8 @@ bool MPU6050_testConnection() {
  * @return I2C supply voltage level (0=VLOGIC, 1=VDD)
  */
 uint8_t MPU6050_getAuxVDDIOLevel() {
-    I2C_readBit(devAddr, MPU6050_RA_YG_OFFS_TC, MPU6050_TC_PWR_MODE_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_YG_OFFS_TC, MPU6050_TC_PWR_MODE_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set the auxiliary I2C supply voltage level.
  * When set to 1, the auxiliary I2C bus high logic level is VDD. When cleared to
@@ -79,7 +98,7 @@ uint8_t MPU6050_getAuxVDDIOLevel() {
  * @param level I2C supply voltage level (0=VLOGIC, 1=VDD)
  */
 void MPU6050_setAuxVDDIOLevel(uint8_t level) {
-    I2C_writeBit(devAddr, MPU6050_RA_YG_OFFS_TC, MPU6050_TC_PWR_MODE_BIT, level);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_YG_OFFS_TC, MPU6050_TC_PWR_MODE_BIT, level);
 }
 
 // SMPLRT_DIV register
@@ -105,8 +124,8 @@ void MPU6050_setAuxVDDIOLevel(uint8_t level) {
  * @see MPU6050_RA_SMPLRT_DIV
  */
 uint8_t MPU6050_getRate() {
-    I2C_readByte(devAddr, MPU6050_RA_SMPLRT_DIV, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readByte(mpu_default.address, MPU6050_RA_SMPLRT_DIV, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 
 /** Set gyroscope sample rate divider.
@@ -115,7 +134,7 @@ uint8_t MPU6050_getRate() {
  * @see MPU6050_RA_SMPLRT_DIV
  */
 void MPU6050_setRate(uint8_t rate) {
-    I2C_writeByte(devAddr, MPU6050_RA_SMPLRT_DIV, rate);
+    I2C_writeByte(mpu_default.address, MPU6050_RA_SMPLRT_DIV, rate);
 }
 
 // CONFIG register
@@ -147,8 +166,8 @@ void MPU6050_setRate(uint8_t rate) {
  * @return FSYNC configuration value
  */
 uint8_t MPU6050_getExternalFrameSync() {
-    I2C_readBits(devAddr, MPU6050_RA_CONFIG, MPU6050_CFG_EXT_SYNC_SET_BIT, MPU6050_CFG_EXT_SYNC_SET_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBits(mpu_default.address, MPU6050_RA_CONFIG, MPU6050_CFG_EXT_SYNC_SET_BIT, MPU6050_CFG_EXT_SYNC_SET_LENGTH, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 
 /** Set external FSYNC configuration.
@@ -157,7 +176,7 @@ uint8_t MPU6050_getExternalFrameSync() {
  * @param sync New FSYNC configuration value
  */
 void MPU6050_setExternalFrameSync(uint8_t sync) {
-    I2C_writeBits(devAddr, MPU6050_RA_CONFIG, MPU6050_CFG_EXT_SYNC_SET_BIT, MPU6050_CFG_EXT_SYNC_SET_LENGTH, sync);
+    I2C_writeBits(mpu_default.address, MPU6050_RA_CONFIG, MPU6050_CFG_EXT_SYNC_SET_BIT, MPU6050_CFG_EXT_SYNC_SET_LENGTH, sync);
 }
 /** Get digital low-pass filter configuration.
  * The DLPF_CFG parameter sets the digital low pass filter configuration. It
@@ -188,8 +207,8 @@ void MPU6050_setExternalFrameSync(uint8_t sync) {
  * @see MPU6050_CFG_DLPF_CFG_LENGTH
  */
 uint8_t MPU6050_getDLPFMode() {
-    I2C_readBits(devAddr, MPU6050_RA_CONFIG, MPU6050_CFG_DLPF_CFG_BIT, MPU6050_CFG_DLPF_CFG_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBits(mpu_default.address, MPU6050_RA_CONFIG, MPU6050_CFG_DLPF_CFG_BIT, MPU6050_CFG_DLPF_CFG_LENGTH, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set digital low-pass filter configuration.
  * @param mode New DLFP configuration setting
@@ -200,7 +219,7 @@ uint8_t MPU6050_getDLPFMode() {
  * @see MPU6050_CFG_DLPF_CFG_LENGTH
  */
 void MPU6050_setDLPFMode(uint8_t mode) {
-    I2C_writeBits(devAddr, MPU6050_RA_CONFIG, MPU6050_CFG_DLPF_CFG_BIT, MPU6050_CFG_DLPF_CFG_LENGTH, mode);
+    I2C_writeBits(mpu_default.address, MPU6050_RA_CONFIG, MPU6050_CFG_DLPF_CFG_BIT, MPU6050_CFG_DLPF_CFG_LENGTH, mode);
 }
 
 // GYRO_CONFIG register
@@ -223,8 +242,8 @@ void MPU6050_setDLPFMode(uint8_t mode) {
  * @see MPU6050_GCONFIG_FS_SEL_LENGTH
  */
 uint8_t MPU6050_getFullScaleGyroRange() {
-    I2C_readBits(devAddr, MPU6050_RA_GYRO_CONFIG, MPU6050_GCONFIG_FS_SEL_BIT, MPU6050_GCONFIG_FS_SEL_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBits(mpu_default.address, MPU6050_RA_GYRO_CONFIG, MPU6050_GCONFIG_FS_SEL_BIT, MPU6050_GCONFIG_FS_SEL_LENGTH, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set full-scale gyroscope range.
  * @param range New full-scale gyroscope range value
@@ -235,7 +254,7 @@ uint8_t MPU6050_getFullScaleGyroRange() {
  * @see MPU6050_GCONFIG_FS_SEL_LENGTH
  */
 void MPU6050_setFullScaleGyroRange(uint8_t range) {
-    I2C_writeBits(devAddr, MPU6050_RA_GYRO_CONFIG, MPU6050_GCONFIG_FS_SEL_BIT, MPU6050_GCONFIG_FS_SEL_LENGTH, range);
+    I2C_writeBits(mpu_default.address, MPU6050_RA_GYRO_CONFIG, MPU6050_GCONFIG_FS_SEL_BIT, MPU6050_GCONFIG_FS_SEL_LENGTH, range);
 }
 
 // SELF TEST FACTORY TRIM VALUES
@@ -245,9 +264,9 @@ void MPU6050_setFullScaleGyroRange(uint8_t range) {
  * @see MPU6050_RA_SELF_TEST_X
  */
 uint8_t MPU6050_getAccelXSelfTestFactoryTrim() {
-    I2C_readByte(devAddr, MPU6050_RA_SELF_TEST_X, &buffer[0], I2C_MASTER_TIMEOUT_MS);
-	I2C_readByte(devAddr, MPU6050_RA_SELF_TEST_A, &buffer[1], I2C_MASTER_TIMEOUT_MS);	
-    return (buffer[0]>>3) | ((buffer[1]>>4) & 0x03);
+    I2C_readByte(mpu_default.address, MPU6050_RA_SELF_TEST_X, &mpu_default.buffer[0], I2C_MASTER_TIMEOUT_MS);
+	I2C_readByte(mpu_default.address, MPU6050_RA_SELF_TEST_A, &mpu_default.buffer[1], I2C_MASTER_TIMEOUT_MS);	
+    return (mpu_default.buffer[0]>>3) | ((mpu_default.buffer[1]>>4) & 0x03);
 }
 
 /** Get self-test factory trim value for accelerometer Y axis.
@@ -255,9 +274,9 @@ uint8_t MPU6050_getAccelXSelfTestFactoryTrim() {
  * @see MPU6050_RA_SELF_TEST_Y
  */
 uint8_t MPU6050_getAccelYSelfTestFactoryTrim() {
-    I2C_readByte(devAddr, MPU6050_RA_SELF_TEST_Y, &buffer[0], I2C_MASTER_TIMEOUT_MS);
-	I2C_readByte(devAddr, MPU6050_RA_SELF_TEST_A, &buffer[1], I2C_MASTER_TIMEOUT_MS);	
-    return (buffer[0]>>3) | ((buffer[1]>>2) & 0x03);
+    I2C_readByte(mpu_default.address, MPU6050_RA_SELF_TEST_Y, &mpu_default.buffer[0], I2C_MASTER_TIMEOUT_MS);
+	I2C_readByte(mpu_default.address, MPU6050_RA_SELF_TEST_A, &mpu_default.buffer[1], I2C_MASTER_TIMEOUT_MS);	
+    return (mpu_default.buffer[0]>>3) | ((mpu_default.buffer[1]>>2) & 0x03);
 }
 
 /** Get self-test factory trim value for accelerometer Z axis.
@@ -265,8 +284,8 @@ uint8_t MPU6050_getAccelYSelfTestFactoryTrim() {
  * @see MPU6050_RA_SELF_TEST_Z
  */
 uint8_t MPU6050_getAccelZSelfTestFactoryTrim() {
-    I2C_readBytes(devAddr, MPU6050_RA_SELF_TEST_Z, 2, buffer, I2C_MASTER_TIMEOUT_MS);	
-    return (buffer[0]>>3) | (buffer[1] & 0x03);
+    I2C_readBytes(mpu_default.address, MPU6050_RA_SELF_TEST_Z, 2, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);	
+    return (mpu_default.buffer[0]>>3) | (mpu_default.buffer[1] & 0x03);
 }
 
 /** Get self-test factory trim value for gyro X axis.
@@ -274,8 +293,8 @@ uint8_t MPU6050_getAccelZSelfTestFactoryTrim() {
  * @see MPU6050_RA_SELF_TEST_X
  */
 uint8_t MPU6050_getGyroXSelfTestFactoryTrim() {
-    I2C_readByte(devAddr, MPU6050_RA_SELF_TEST_X, buffer, I2C_MASTER_TIMEOUT_MS);	
-    return (buffer[0] & 0x1F);
+    I2C_readByte(mpu_default.address, MPU6050_RA_SELF_TEST_X, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);	
+    return (mpu_default.buffer[0] & 0x1F);
 }
 
 /** Get self-test factory trim value for gyro Y axis.
@@ -283,8 +302,8 @@ uint8_t MPU6050_getGyroXSelfTestFactoryTrim() {
  * @see MPU6050_RA_SELF_TEST_Y
  */
 uint8_t MPU6050_getGyroYSelfTestFactoryTrim() {
-    I2C_readByte(devAddr, MPU6050_RA_SELF_TEST_Y, buffer, I2C_MASTER_TIMEOUT_MS);	
-    return (buffer[0] & 0x1F);
+    I2C_readByte(mpu_default.address, MPU6050_RA_SELF_TEST_Y, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);	
+    return (mpu_default.buffer[0] & 0x1F);
 }
 
 /** Get self-test factory trim value for gyro Z axis.
@@ -292,8 +311,8 @@ uint8_t MPU6050_getGyroYSelfTestFactoryTrim() {
  * @see MPU6050_RA_SELF_TEST_Z
  */
 uint8_t MPU6050_getGyroZSelfTestFactoryTrim() {
-    I2C_readByte(devAddr, MPU6050_RA_SELF_TEST_Z, buffer, I2C_MASTER_TIMEOUT_MS);	
-    return (buffer[0] & 0x1F);
+    I2C_readByte(mpu_default.address, MPU6050_RA_SELF_TEST_Z, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);	
+    return (mpu_default.buffer[0] & 0x1F);
 }
 
 // ACCEL_CONFIG register
@@ -303,45 +322,45 @@ uint8_t MPU6050_getGyroZSelfTestFactoryTrim() {
  * @see MPU6050_RA_ACCEL_CONFIG
  */
 bool MPU6050_getAccelXSelfTest() {
-    I2C_readBit(devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_XA_ST_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_XA_ST_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Get self-test enabled setting for accelerometer X axis.
  * @param enabled Self-test enabled value
  * @see MPU6050_RA_ACCEL_CONFIG
  */
 void MPU6050_setAccelXSelfTest(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_XA_ST_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_XA_ST_BIT, enabled);
 }
 /** Get self-test enabled value for accelerometer Y axis.
  * @return Self-test enabled value
  * @see MPU6050_RA_ACCEL_CONFIG
  */
 bool MPU6050_getAccelYSelfTest() {
-    I2C_readBit(devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_YA_ST_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_YA_ST_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Get self-test enabled value for accelerometer Y axis.
  * @param enabled Self-test enabled value
  * @see MPU6050_RA_ACCEL_CONFIG
  */
 void MPU6050_setAccelYSelfTest(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_YA_ST_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_YA_ST_BIT, enabled);
 }
 /** Get self-test enabled value for accelerometer Z axis.
  * @return Self-test enabled value
  * @see MPU6050_RA_ACCEL_CONFIG
  */
 bool MPU6050_getAccelZSelfTest() {
-    I2C_readBit(devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_ZA_ST_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_ZA_ST_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set self-test enabled value for accelerometer Z axis.
  * @param enabled Self-test enabled value
  * @see MPU6050_RA_ACCEL_CONFIG
  */
 void MPU6050_setAccelZSelfTest(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_ZA_ST_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_ZA_ST_BIT, enabled);
 }
 /** Get full-scale accelerometer range.
  * The FS_SEL parameter allows setting the full-scale range of the accelerometer
@@ -361,15 +380,15 @@ void MPU6050_setAccelZSelfTest(bool enabled) {
  * @see MPU6050_ACONFIG_AFS_SEL_LENGTH
  */
 uint8_t MPU6050_getFullScaleAccelRange() {
-    I2C_readBits(devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_AFS_SEL_BIT, MPU6050_ACONFIG_AFS_SEL_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBits(mpu_default.address, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_AFS_SEL_BIT, MPU6050_ACONFIG_AFS_SEL_LENGTH, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set full-scale accelerometer range.
  * @param range New full-scale accelerometer range setting
  * @see getFullScaleAccelRange()
  */
 void MPU6050_setFullScaleAccelRange(uint8_t range) {
-    I2C_writeBits(devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_AFS_SEL_BIT, MPU6050_ACONFIG_AFS_SEL_LENGTH, range);
+    I2C_writeBits(mpu_default.address, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_AFS_SEL_BIT, MPU6050_ACONFIG_AFS_SEL_LENGTH, range);
 }
 /** Get the high-pass filter configuration.
  * The DHPF is a filter module in the path leading to motion detectors (Free
@@ -407,8 +426,8 @@ void MPU6050_setFullScaleAccelRange(uint8_t range) {
  * @see MPU6050_RA_ACCEL_CONFIG
  */
 uint8_t MPU6050_getDHPFMode() {
-    I2C_readBits(devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_ACCEL_HPF_BIT, MPU6050_ACONFIG_ACCEL_HPF_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBits(mpu_default.address, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_ACCEL_HPF_BIT, MPU6050_ACONFIG_ACCEL_HPF_LENGTH, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set the high-pass filter configuration.
  * @param bandwidth New high-pass filter configuration
@@ -417,7 +436,7 @@ uint8_t MPU6050_getDHPFMode() {
  * @see MPU6050_RA_ACCEL_CONFIG
  */
 void MPU6050_setDHPFMode(uint8_t bandwidth) {
-    I2C_writeBits(devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_ACCEL_HPF_BIT, MPU6050_ACONFIG_ACCEL_HPF_LENGTH, bandwidth);
+    I2C_writeBits(mpu_default.address, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_ACCEL_HPF_BIT, MPU6050_ACONFIG_ACCEL_HPF_LENGTH, bandwidth);
 }
 
 // FF_THR register
@@ -438,8 +457,8 @@ void MPU6050_setDHPFMode(uint8_t bandwidth) {
  * @see MPU6050_RA_FF_THR
  */
 uint8_t MPU6050_getFreefallDetectionThreshold() {
-    I2C_readByte(devAddr, MPU6050_RA_FF_THR, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readByte(mpu_default.address, MPU6050_RA_FF_THR, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Get free-fall event acceleration threshold.
  * @param threshold New free-fall acceleration threshold value (LSB = 2mg)
@@ -447,7 +466,7 @@ uint8_t MPU6050_getFreefallDetectionThreshold() {
  * @see MPU6050_RA_FF_THR
  */
 void MPU6050_setFreefallDetectionThreshold(uint8_t threshold) {
-    I2C_writeByte(devAddr, MPU6050_RA_FF_THR, threshold);
+    I2C_writeByte(mpu_default.address, MPU6050_RA_FF_THR, threshold);
 }
 
 // FF_DUR register
@@ -470,8 +489,8 @@ void MPU6050_setFreefallDetectionThreshold(uint8_t threshold) {
  * @see MPU6050_RA_FF_DUR
  */
 uint8_t MPU6050_getFreefallDetectionDuration() {
-    I2C_readByte(devAddr, MPU6050_RA_FF_DUR, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readByte(mpu_default.address, MPU6050_RA_FF_DUR, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Get free-fall event duration threshold.
  * @param duration New free-fall duration threshold value (LSB = 1ms)
@@ -479,7 +498,7 @@ uint8_t MPU6050_getFreefallDetectionDuration() {
  * @see MPU6050_RA_FF_DUR
  */
 void MPU6050_setFreefallDetectionDuration(uint8_t duration) {
-    I2C_writeByte(devAddr, MPU6050_RA_FF_DUR, duration);
+    I2C_writeByte(mpu_default.address, MPU6050_RA_FF_DUR, duration);
 }
 
 // MOT_THR register
@@ -504,8 +523,8 @@ void MPU6050_setFreefallDetectionDuration(uint8_t duration) {
  * @see MPU6050_RA_MOT_THR
  */
 uint8_t MPU6050_getMotionDetectionThreshold() {
-    I2C_readByte(devAddr, MPU6050_RA_MOT_THR, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readByte(mpu_default.address, MPU6050_RA_MOT_THR, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set motion detection event acceleration threshold.
  * @param threshold New motion detection acceleration threshold value (LSB = 2mg)
@@ -513,7 +532,7 @@ uint8_t MPU6050_getMotionDetectionThreshold() {
  * @see MPU6050_RA_MOT_THR
  */
 void MPU6050_setMotionDetectionThreshold(uint8_t threshold) {
-    I2C_writeByte(devAddr, MPU6050_RA_MOT_THR, threshold);
+    I2C_writeByte(mpu_default.address, MPU6050_RA_MOT_THR, threshold);
 }
 
 // MOT_DUR register
@@ -534,8 +553,8 @@ void MPU6050_setMotionDetectionThreshold(uint8_t threshold) {
  * @see MPU6050_RA_MOT_DUR
  */
 uint8_t MPU6050_getMotionDetectionDuration() {
-    I2C_readByte(devAddr, MPU6050_RA_MOT_DUR, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readByte(mpu_default.address, MPU6050_RA_MOT_DUR, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set motion detection event duration threshold.
  * @param duration New motion detection duration threshold value (LSB = 1ms)
@@ -543,7 +562,7 @@ uint8_t MPU6050_getMotionDetectionDuration() {
  * @see MPU6050_RA_MOT_DUR
  */
 void MPU6050_setMotionDetectionDuration(uint8_t duration) {
-    I2C_writeByte(devAddr, MPU6050_RA_MOT_DUR, duration);
+    I2C_writeByte(mpu_default.address, MPU6050_RA_MOT_DUR, duration);
 }
 
 // ZRMOT_THR register
@@ -574,8 +593,8 @@ void MPU6050_setMotionDetectionDuration(uint8_t duration) {
  * @see MPU6050_RA_ZRMOT_THR
  */
 uint8_t MPU6050_getZeroMotionDetectionThreshold() {
-    I2C_readByte(devAddr, MPU6050_RA_ZRMOT_THR, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readByte(mpu_default.address, MPU6050_RA_ZRMOT_THR, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set zero motion detection event acceleration threshold.
  * @param threshold New zero motion detection acceleration threshold value (LSB = 2mg)
@@ -583,7 +602,7 @@ uint8_t MPU6050_getZeroMotionDetectionThreshold() {
  * @see MPU6050_RA_ZRMOT_THR
  */
 void MPU6050_setZeroMotionDetectionThreshold(uint8_t threshold) {
-    I2C_writeByte(devAddr, MPU6050_RA_ZRMOT_THR, threshold);
+    I2C_writeByte(mpu_default.address, MPU6050_RA_ZRMOT_THR, threshold);
 }
 
 // ZRMOT_DUR register
@@ -605,8 +624,8 @@ void MPU6050_setZeroMotionDetectionThreshold(uint8_t threshold) {
  * @see MPU6050_RA_ZRMOT_DUR
  */
 uint8_t MPU6050_getZeroMotionDetectionDuration() {
-    I2C_readByte(devAddr, MPU6050_RA_ZRMOT_DUR, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readByte(mpu_default.address, MPU6050_RA_ZRMOT_DUR, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set zero motion detection event duration threshold.
  * @param duration New zero motion detection duration threshold value (LSB = 1ms)
@@ -614,7 +633,7 @@ uint8_t MPU6050_getZeroMotionDetectionDuration() {
  * @see MPU6050_RA_ZRMOT_DUR
  */
 void MPU6050_setZeroMotionDetectionDuration(uint8_t duration) {
-    I2C_writeByte(devAddr, MPU6050_RA_ZRMOT_DUR, duration);
+    I2C_writeByte(mpu_default.address, MPU6050_RA_ZRMOT_DUR, duration);
 }
 
 // FIFO_EN register
@@ -626,8 +645,8 @@ void MPU6050_setZeroMotionDetectionDuration(uint8_t duration) {
  * @see MPU6050_RA_FIFO_EN
  */
 bool MPU6050_getTempFIFOEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_FIFO_EN, MPU6050_TEMP_FIFO_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_FIFO_EN, MPU6050_TEMP_FIFO_EN_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set temperature FIFO enabled value.
  * @param enabled New temperature FIFO enabled value
@@ -635,7 +654,7 @@ bool MPU6050_getTempFIFOEnabled() {
  * @see MPU6050_RA_FIFO_EN
  */
 void MPU6050_setTempFIFOEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_FIFO_EN, MPU6050_TEMP_FIFO_EN_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_FIFO_EN, MPU6050_TEMP_FIFO_EN_BIT, enabled);
 }
 /** Get gyroscope X-axis FIFO enabled value.
  * When set to 1, this bit enables GYRO_XOUT_H and GYRO_XOUT_L (Registers 67 and
@@ -644,8 +663,8 @@ void MPU6050_setTempFIFOEnabled(bool enabled) {
  * @see MPU6050_RA_FIFO_EN
  */
 bool MPU6050_getXGyroFIFOEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_FIFO_EN, MPU6050_XG_FIFO_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_FIFO_EN, MPU6050_XG_FIFO_EN_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set gyroscope X-axis FIFO enabled value.
  * @param enabled New gyroscope X-axis FIFO enabled value
@@ -653,7 +672,7 @@ bool MPU6050_getXGyroFIFOEnabled() {
  * @see MPU6050_RA_FIFO_EN
  */
 void MPU6050_setXGyroFIFOEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_FIFO_EN, MPU6050_XG_FIFO_EN_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_FIFO_EN, MPU6050_XG_FIFO_EN_BIT, enabled);
 }
 /** Get gyroscope Y-axis FIFO enabled value.
  * When set to 1, this bit enables GYRO_YOUT_H and GYRO_YOUT_L (Registers 69 and
@@ -662,8 +681,8 @@ void MPU6050_setXGyroFIFOEnabled(bool enabled) {
  * @see MPU6050_RA_FIFO_EN
  */
 bool MPU6050_getYGyroFIFOEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_FIFO_EN, MPU6050_YG_FIFO_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_FIFO_EN, MPU6050_YG_FIFO_EN_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set gyroscope Y-axis FIFO enabled value.
  * @param enabled New gyroscope Y-axis FIFO enabled value
@@ -671,7 +690,7 @@ bool MPU6050_getYGyroFIFOEnabled() {
  * @see MPU6050_RA_FIFO_EN
  */
 void MPU6050_setYGyroFIFOEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_FIFO_EN, MPU6050_YG_FIFO_EN_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_FIFO_EN, MPU6050_YG_FIFO_EN_BIT, enabled);
 }
 /** Get gyroscope Z-axis FIFO enabled value.
  * When set to 1, this bit enables GYRO_ZOUT_H and GYRO_ZOUT_L (Registers 71 and
@@ -680,8 +699,8 @@ void MPU6050_setYGyroFIFOEnabled(bool enabled) {
  * @see MPU6050_RA_FIFO_EN
  */
 bool MPU6050_getZGyroFIFOEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_FIFO_EN, MPU6050_ZG_FIFO_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_FIFO_EN, MPU6050_ZG_FIFO_EN_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set gyroscope Z-axis FIFO enabled value.
  * @param enabled New gyroscope Z-axis FIFO enabled value
@@ -689,7 +708,7 @@ bool MPU6050_getZGyroFIFOEnabled() {
  * @see MPU6050_RA_FIFO_EN
  */
 void MPU6050_setZGyroFIFOEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_FIFO_EN, MPU6050_ZG_FIFO_EN_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_FIFO_EN, MPU6050_ZG_FIFO_EN_BIT, enabled);
 }
 /** Get accelerometer FIFO enabled value.
  * When set to 1, this bit enables ACCEL_XOUT_H, ACCEL_XOUT_L, ACCEL_YOUT_H,
@@ -699,8 +718,8 @@ void MPU6050_setZGyroFIFOEnabled(bool enabled) {
  * @see MPU6050_RA_FIFO_EN
  */
 bool MPU6050_getAccelFIFOEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_FIFO_EN, MPU6050_ACCEL_FIFO_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_FIFO_EN, MPU6050_ACCEL_FIFO_EN_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set accelerometer FIFO enabled value.
  * @param enabled New accelerometer FIFO enabled value
@@ -708,7 +727,7 @@ bool MPU6050_getAccelFIFOEnabled() {
  * @see MPU6050_RA_FIFO_EN
  */
 void MPU6050_setAccelFIFOEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_FIFO_EN, MPU6050_ACCEL_FIFO_EN_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_FIFO_EN, MPU6050_ACCEL_FIFO_EN_BIT, enabled);
 }
 /** Get Slave 2 FIFO enabled value.
  * When set to 1, this bit enables EXT_SENS_DATA registers (Registers 73 to 96)
@@ -717,8 +736,8 @@ void MPU6050_setAccelFIFOEnabled(bool enabled) {
  * @see MPU6050_RA_FIFO_EN
  */
 bool MPU6050_getSlave2FIFOEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_FIFO_EN, MPU6050_SLV2_FIFO_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_FIFO_EN, MPU6050_SLV2_FIFO_EN_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set Slave 2 FIFO enabled value.
  * @param enabled New Slave 2 FIFO enabled value
@@ -726,7 +745,7 @@ bool MPU6050_getSlave2FIFOEnabled() {
  * @see MPU6050_RA_FIFO_EN
  */
 void MPU6050_setSlave2FIFOEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_FIFO_EN, MPU6050_SLV2_FIFO_EN_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_FIFO_EN, MPU6050_SLV2_FIFO_EN_BIT, enabled);
 }
 /** Get Slave 1 FIFO enabled value.
  * When set to 1, this bit enables EXT_SENS_DATA registers (Registers 73 to 96)
@@ -735,8 +754,8 @@ void MPU6050_setSlave2FIFOEnabled(bool enabled) {
  * @see MPU6050_RA_FIFO_EN
  */
 bool MPU6050_getSlave1FIFOEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_FIFO_EN, MPU6050_SLV1_FIFO_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_FIFO_EN, MPU6050_SLV1_FIFO_EN_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set Slave 1 FIFO enabled value.
  * @param enabled New Slave 1 FIFO enabled value
@@ -744,7 +763,7 @@ bool MPU6050_getSlave1FIFOEnabled() {
  * @see MPU6050_RA_FIFO_EN
  */
 void MPU6050_setSlave1FIFOEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_FIFO_EN, MPU6050_SLV1_FIFO_EN_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_FIFO_EN, MPU6050_SLV1_FIFO_EN_BIT, enabled);
 }
 /** Get Slave 0 FIFO enabled value.
  * When set to 1, this bit enables EXT_SENS_DATA registers (Registers 73 to 96)
@@ -753,8 +772,8 @@ void MPU6050_setSlave1FIFOEnabled(bool enabled) {
  * @see MPU6050_RA_FIFO_EN
  */
 bool MPU6050_getSlave0FIFOEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_FIFO_EN, MPU6050_SLV0_FIFO_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_FIFO_EN, MPU6050_SLV0_FIFO_EN_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set Slave 0 FIFO enabled value.
  * @param enabled New Slave 0 FIFO enabled value
@@ -762,7 +781,7 @@ bool MPU6050_getSlave0FIFOEnabled() {
  * @see MPU6050_RA_FIFO_EN
  */
 void MPU6050_setSlave0FIFOEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_FIFO_EN, MPU6050_SLV0_FIFO_EN_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_FIFO_EN, MPU6050_SLV0_FIFO_EN_BIT, enabled);
 }
 
 // I2C_MST_CTRL register
@@ -783,8 +802,8 @@ void MPU6050_setSlave0FIFOEnabled(bool enabled) {
  * @see MPU6050_RA_I2C_MST_CTRL
  */
 bool MPU6050_getMultiMasterEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_MULT_MST_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_I2C_MST_CTRL, MPU6050_MULT_MST_EN_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set multi-master enabled value.
  * @param enabled New multi-master enabled value
@@ -792,7 +811,7 @@ bool MPU6050_getMultiMasterEnabled() {
  * @see MPU6050_RA_I2C_MST_CTRL
  */
 void MPU6050_setMultiMasterEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_MULT_MST_EN_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_I2C_MST_CTRL, MPU6050_MULT_MST_EN_BIT, enabled);
 }
 /** Get wait-for-external-sensor-data enabled value.
  * When the WAIT_FOR_ES bit is set to 1, the Data Ready interrupt will be
@@ -806,8 +825,8 @@ void MPU6050_setMultiMasterEnabled(bool enabled) {
  * @see MPU6050_RA_I2C_MST_CTRL
  */
 bool MPU6050_getWaitForExternalSensorEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_WAIT_FOR_ES_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_I2C_MST_CTRL, MPU6050_WAIT_FOR_ES_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set wait-for-external-sensor-data enabled value.
  * @param enabled New wait-for-external-sensor-data enabled value
@@ -815,7 +834,7 @@ bool MPU6050_getWaitForExternalSensorEnabled() {
  * @see MPU6050_RA_I2C_MST_CTRL
  */
 void MPU6050_setWaitForExternalSensorEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_WAIT_FOR_ES_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_I2C_MST_CTRL, MPU6050_WAIT_FOR_ES_BIT, enabled);
 }
 /** Get Slave 3 FIFO enabled value.
  * When set to 1, this bit enables EXT_SENS_DATA registers (Registers 73 to 96)
@@ -824,8 +843,8 @@ void MPU6050_setWaitForExternalSensorEnabled(bool enabled) {
  * @see MPU6050_RA_MST_CTRL
  */
 bool MPU6050_getSlave3FIFOEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_SLV_3_FIFO_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_I2C_MST_CTRL, MPU6050_SLV_3_FIFO_EN_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set Slave 3 FIFO enabled value.
  * @param enabled New Slave 3 FIFO enabled value
@@ -833,7 +852,7 @@ bool MPU6050_getSlave3FIFOEnabled() {
  * @see MPU6050_RA_MST_CTRL
  */
 void MPU6050_setSlave3FIFOEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_SLV_3_FIFO_EN_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_I2C_MST_CTRL, MPU6050_SLV_3_FIFO_EN_BIT, enabled);
 }
 /** Get slave read/write transition enabled value.
  * The I2C_MST_P_NSR bit configures the I2C Master's transition from one slave
@@ -846,8 +865,8 @@ void MPU6050_setSlave3FIFOEnabled(bool enabled) {
  * @see MPU6050_RA_I2C_MST_CTRL
  */
 bool MPU6050_getSlaveReadWriteTransitionEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_I2C_MST_P_NSR_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_I2C_MST_CTRL, MPU6050_I2C_MST_P_NSR_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set slave read/write transition enabled value.
  * @param enabled New slave read/write transition enabled value
@@ -855,7 +874,7 @@ bool MPU6050_getSlaveReadWriteTransitionEnabled() {
  * @see MPU6050_RA_I2C_MST_CTRL
  */
 void MPU6050_setSlaveReadWriteTransitionEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_I2C_MST_P_NSR_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_I2C_MST_CTRL, MPU6050_I2C_MST_P_NSR_BIT, enabled);
 }
 /** Get I2C master clock speed.
  * I2C_MST_CLK is a 4 bit unsigned value which configures a divider on the
@@ -887,15 +906,15 @@ void MPU6050_setSlaveReadWriteTransitionEnabled(bool enabled) {
  * @see MPU6050_RA_I2C_MST_CTRL
  */
 uint8_t MPU6050_getMasterClockSpeed() {
-    I2C_readBits(devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_I2C_MST_CLK_BIT, MPU6050_I2C_MST_CLK_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBits(mpu_default.address, MPU6050_RA_I2C_MST_CTRL, MPU6050_I2C_MST_CLK_BIT, MPU6050_I2C_MST_CLK_LENGTH, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set I2C master clock speed.
  * @reparam speed Current I2C master clock speed
  * @see MPU6050_RA_I2C_MST_CTRL
  */
 void MPU6050_setMasterClockSpeed(uint8_t speed) {
-    I2C_writeBits(devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_I2C_MST_CLK_BIT, MPU6050_I2C_MST_CLK_LENGTH, speed);
+    I2C_writeBits(mpu_default.address, MPU6050_RA_I2C_MST_CTRL, MPU6050_I2C_MST_CLK_BIT, MPU6050_I2C_MST_CLK_LENGTH, speed);
 }
 
 // I2C_SLV* registers (Slave 0-3)
@@ -943,8 +962,8 @@ void MPU6050_setMasterClockSpeed(uint8_t speed) {
  */
 uint8_t MPU6050_getSlaveAddress(uint8_t num) {
     if (num > 3) return 0;
-    I2C_readByte(devAddr, MPU6050_RA_I2C_SLV0_ADDR + num*3, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readByte(mpu_default.address, MPU6050_RA_I2C_SLV0_ADDR + num*3, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set the I2C address of the specified slave (0-3).
  * @param num Slave number (0-3)
@@ -954,7 +973,7 @@ uint8_t MPU6050_getSlaveAddress(uint8_t num) {
  */
 void MPU6050_setSlaveAddress(uint8_t num, uint8_t address) {
     if (num > 3) return;
-    I2C_writeByte(devAddr, MPU6050_RA_I2C_SLV0_ADDR + num*3, address);
+    I2C_writeByte(mpu_default.address, MPU6050_RA_I2C_SLV0_ADDR + num*3, address);
 }
 /** Get the active internal register for the specified slave (0-3).
  * Read/write operations for this slave will be done to whatever internal
@@ -969,8 +988,8 @@ void MPU6050_setSlaveAddress(uint8_t num, uint8_t address) {
  */
 uint8_t MPU6050_getSlaveRegister(uint8_t num) {
     if (num > 3) return 0;
-    I2C_readByte(devAddr, MPU6050_RA_I2C_SLV0_REG + num*3, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readByte(mpu_default.address, MPU6050_RA_I2C_SLV0_REG + num*3, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set the active internal register for the specified slave (0-3).
  * @param num Slave number (0-3)
@@ -980,7 +999,7 @@ uint8_t MPU6050_getSlaveRegister(uint8_t num) {
  */
 void MPU6050_setSlaveRegister(uint8_t num, uint8_t reg) {
     if (num > 3) return;
-    I2C_writeByte(devAddr, MPU6050_RA_I2C_SLV0_REG + num*3, reg);
+    I2C_writeByte(mpu_default.address, MPU6050_RA_I2C_SLV0_REG + num*3, reg);
 }
 /** Get the enabled value for the specified slave (0-3).
  * When set to 1, this bit enables Slave 0 for data transfer operations. When
@@ -991,8 +1010,8 @@ void MPU6050_setSlaveRegister(uint8_t num, uint8_t reg) {
  */
 bool MPU6050_getSlaveEnabled(uint8_t num) {
     if (num > 3) return 0;
-    I2C_readBit(devAddr, MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_EN_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set the enabled value for the specified slave (0-3).
  * @param num Slave number (0-3)
@@ -1002,7 +1021,7 @@ bool MPU6050_getSlaveEnabled(uint8_t num) {
  */
 void MPU6050_setSlaveEnabled(uint8_t num, bool enabled) {
     if (num > 3) return;
-    I2C_writeBit(devAddr, MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_EN_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_EN_BIT, enabled);
 }
 /** Get word pair byte-swapping enabled for the specified slave (0-3).
  * When set to 1, this bit enables byte swapping. When byte swapping is enabled,
@@ -1017,8 +1036,8 @@ void MPU6050_setSlaveEnabled(uint8_t num, bool enabled) {
  */
 bool MPU6050_getSlaveWordByteSwap(uint8_t num) {
     if (num > 3) return 0;
-    I2C_readBit(devAddr, MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_BYTE_SW_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_BYTE_SW_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set word pair byte-swapping enabled for the specified slave (0-3).
  * @param num Slave number (0-3)
@@ -1028,7 +1047,7 @@ bool MPU6050_getSlaveWordByteSwap(uint8_t num) {
  */
 void MPU6050_setSlaveWordByteSwap(uint8_t num, bool enabled) {
     if (num > 3) return;
-    I2C_writeBit(devAddr, MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_BYTE_SW_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_BYTE_SW_BIT, enabled);
 }
 /** Get write mode for the specified slave (0-3).
  * When set to 1, the transaction will read or write data only. When cleared to
@@ -1042,8 +1061,8 @@ void MPU6050_setSlaveWordByteSwap(uint8_t num, bool enabled) {
  */
 bool MPU6050_getSlaveWriteMode(uint8_t num) {
     if (num > 3) return 0;
-    I2C_readBit(devAddr, MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_REG_DIS_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_REG_DIS_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set write mode for the specified slave (0-3).
  * @param num Slave number (0-3)
@@ -1053,7 +1072,7 @@ bool MPU6050_getSlaveWriteMode(uint8_t num) {
  */
 void MPU6050_setSlaveWriteMode(uint8_t num, bool mode) {
     if (num > 3) return;
-    I2C_writeBit(devAddr, MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_REG_DIS_BIT, mode);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_REG_DIS_BIT, mode);
 }
 /** Get word pair grouping order offset for the specified slave (0-3).
  * This sets specifies the grouping order of word pairs received from registers.
@@ -1068,8 +1087,8 @@ void MPU6050_setSlaveWriteMode(uint8_t num, bool mode) {
  */
 bool MPU6050_getSlaveWordGroupOffset(uint8_t num) {
     if (num > 3) return 0;
-    I2C_readBit(devAddr, MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_GRP_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_GRP_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set word pair grouping order offset for the specified slave (0-3).
  * @param num Slave number (0-3)
@@ -1079,7 +1098,7 @@ bool MPU6050_getSlaveWordGroupOffset(uint8_t num) {
  */
 void MPU6050_setSlaveWordGroupOffset(uint8_t num, bool enabled) {
     if (num > 3) return;
-    I2C_writeBit(devAddr, MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_GRP_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_GRP_BIT, enabled);
 }
 /** Get number of bytes to read for the specified slave (0-3).
  * Specifies the number of bytes transferred to and from Slave 0. Clearing this
@@ -1090,8 +1109,8 @@ void MPU6050_setSlaveWordGroupOffset(uint8_t num, bool enabled) {
  */
 uint8_t MPU6050_getSlaveDataLength(uint8_t num) {
     if (num > 3) return 0;
-    I2C_readBits(devAddr, MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_LEN_BIT, MPU6050_I2C_SLV_LEN_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBits(mpu_default.address, MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_LEN_BIT, MPU6050_I2C_SLV_LEN_LENGTH, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set number of bytes to read for the specified slave (0-3).
  * @param num Slave number (0-3)
@@ -1101,7 +1120,7 @@ uint8_t MPU6050_getSlaveDataLength(uint8_t num) {
  */
 void MPU6050_setSlaveDataLength(uint8_t num, uint8_t length) {
     if (num > 3) return;
-    I2C_writeBits(devAddr, MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_LEN_BIT, MPU6050_I2C_SLV_LEN_LENGTH, length);
+    I2C_writeBits(mpu_default.address, MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_LEN_BIT, MPU6050_I2C_SLV_LEN_LENGTH, length);
 }
 
 // I2C_SLV* registers (Slave 4)
@@ -1116,8 +1135,8 @@ void MPU6050_setSlaveDataLength(uint8_t num, uint8_t length) {
  * @see MPU6050_RA_I2C_SLV4_ADDR
  */
 uint8_t MPU6050_getSlave4Address() {
-    I2C_readByte(devAddr, MPU6050_RA_I2C_SLV4_ADDR, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readByte(mpu_default.address, MPU6050_RA_I2C_SLV4_ADDR, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set the I2C address of Slave 4.
  * @param address New address for Slave 4
@@ -1125,7 +1144,7 @@ uint8_t MPU6050_getSlave4Address() {
  * @see MPU6050_RA_I2C_SLV4_ADDR
  */
 void MPU6050_setSlave4Address(uint8_t address) {
-    I2C_writeByte(devAddr, MPU6050_RA_I2C_SLV4_ADDR, address);
+    I2C_writeByte(mpu_default.address, MPU6050_RA_I2C_SLV4_ADDR, address);
 }
 /** Get the active internal register for the Slave 4.
  * Read/write operations for this slave will be done to whatever internal
@@ -1135,8 +1154,8 @@ void MPU6050_setSlave4Address(uint8_t address) {
  * @see MPU6050_RA_I2C_SLV4_REG
  */
 uint8_t MPU6050_getSlave4Register() {
-    I2C_readByte(devAddr, MPU6050_RA_I2C_SLV4_REG, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readByte(mpu_default.address, MPU6050_RA_I2C_SLV4_REG, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set the active internal register for Slave 4.
  * @param reg New active register for Slave 4
@@ -1144,7 +1163,7 @@ uint8_t MPU6050_getSlave4Register() {
  * @see MPU6050_RA_I2C_SLV4_REG
  */
 void MPU6050_setSlave4Register(uint8_t reg) {
-    I2C_writeByte(devAddr, MPU6050_RA_I2C_SLV4_REG, reg);
+    I2C_writeByte(mpu_default.address, MPU6050_RA_I2C_SLV4_REG, reg);
 }
 /** Set new byte to write to Slave 4.
  * This register stores the data to be written into the Slave 4. If I2C_SLV4_RW
@@ -1153,7 +1172,7 @@ void MPU6050_setSlave4Register(uint8_t reg) {
  * @see MPU6050_RA_I2C_SLV4_DO
  */
 void MPU6050_setSlave4OutputByte(uint8_t data) {
-    I2C_writeByte(devAddr, MPU6050_RA_I2C_SLV4_DO, data);
+    I2C_writeByte(mpu_default.address, MPU6050_RA_I2C_SLV4_DO, data);
 }
 /** Get the enabled value for the Slave 4.
  * When set to 1, this bit enables Slave 4 for data transfer operations. When
@@ -1162,8 +1181,8 @@ void MPU6050_setSlave4OutputByte(uint8_t data) {
  * @see MPU6050_RA_I2C_SLV4_CTRL
  */
 bool MPU6050_getSlave4Enabled() {
-    I2C_readBit(devAddr, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_EN_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set the enabled value for Slave 4.
  * @param enabled New enabled value for Slave 4
@@ -1171,7 +1190,7 @@ bool MPU6050_getSlave4Enabled() {
  * @see MPU6050_RA_I2C_SLV4_CTRL
  */
 void MPU6050_setSlave4Enabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_EN_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_EN_BIT, enabled);
 }
 /** Get the enabled value for Slave 4 transaction interrupts.
  * When set to 1, this bit enables the generation of an interrupt signal upon
@@ -1183,8 +1202,8 @@ void MPU6050_setSlave4Enabled(bool enabled) {
  * @see MPU6050_RA_I2C_SLV4_CTRL
  */
 bool MPU6050_getSlave4InterruptEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_INT_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_INT_EN_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set the enabled value for Slave 4 transaction interrupts.
  * @param enabled New enabled value for Slave 4 transaction interrupts.
@@ -1192,7 +1211,7 @@ bool MPU6050_getSlave4InterruptEnabled() {
  * @see MPU6050_RA_I2C_SLV4_CTRL
  */
 void MPU6050_setSlave4InterruptEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_INT_EN_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_INT_EN_BIT, enabled);
 }
 /** Get write mode for Slave 4.
  * When set to 1, the transaction will read or write data only. When cleared to
@@ -1204,8 +1223,8 @@ void MPU6050_setSlave4InterruptEnabled(bool enabled) {
  * @see MPU6050_RA_I2C_SLV4_CTRL
  */
 bool MPU6050_getSlave4WriteMode() {
-    I2C_readBit(devAddr, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_REG_DIS_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_REG_DIS_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set write mode for the Slave 4.
  * @param mode New write mode for Slave 4 (0 = register address + data, 1 = data only)
@@ -1213,7 +1232,7 @@ bool MPU6050_getSlave4WriteMode() {
  * @see MPU6050_RA_I2C_SLV4_CTRL
  */
 void MPU6050_setSlave4WriteMode(bool mode) {
-    I2C_writeBit(devAddr, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_REG_DIS_BIT, mode);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_REG_DIS_BIT, mode);
 }
 /** Get Slave 4 master delay value.
  * This configures the reduced access rate of I2C slaves relative to the Sample
@@ -1231,8 +1250,8 @@ void MPU6050_setSlave4WriteMode(bool mode) {
  * @see MPU6050_RA_I2C_SLV4_CTRL
  */
 uint8_t MPU6050_getSlave4MasterDelay() {
-    I2C_readBits(devAddr, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_MST_DLY_BIT, MPU6050_I2C_SLV4_MST_DLY_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBits(mpu_default.address, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_MST_DLY_BIT, MPU6050_I2C_SLV4_MST_DLY_LENGTH, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set Slave 4 master delay value.
  * @param delay New Slave 4 master delay value
@@ -1240,7 +1259,7 @@ uint8_t MPU6050_getSlave4MasterDelay() {
  * @see MPU6050_RA_I2C_SLV4_CTRL
  */
 void MPU6050_setSlave4MasterDelay(uint8_t delay) {
-    I2C_writeBits(devAddr, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_MST_DLY_BIT, MPU6050_I2C_SLV4_MST_DLY_LENGTH, delay);
+    I2C_writeBits(mpu_default.address, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_MST_DLY_BIT, MPU6050_I2C_SLV4_MST_DLY_LENGTH, delay);
 }
 /** Get last available byte read from Slave 4.
  * This register stores the data read from Slave 4. This field is populated
@@ -1249,8 +1268,8 @@ void MPU6050_setSlave4MasterDelay(uint8_t delay) {
  * @see MPU6050_RA_I2C_SLV4_DI
  */
 uint8_t MPU6050_getSlate4InputByte() {
-    I2C_readByte(devAddr, MPU6050_RA_I2C_SLV4_DI, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readByte(mpu_default.address, MPU6050_RA_I2C_SLV4_DI, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 
 // I2C_MST_STATUS register
@@ -1265,8 +1284,8 @@ uint8_t MPU6050_getSlate4InputByte() {
  * @see MPU6050_RA_I2C_MST_STATUS
  */
 bool MPU6050_getPassthroughStatus() {
-    I2C_readBit(devAddr, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_PASS_THROUGH_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_PASS_THROUGH_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Get Slave 4 transaction done status.
  * Automatically sets to 1 when a Slave 4 transaction has completed. This
@@ -1277,8 +1296,8 @@ bool MPU6050_getPassthroughStatus() {
  * @see MPU6050_RA_I2C_MST_STATUS
  */
 bool MPU6050_getSlave4IsDone() {
-    I2C_readBit(devAddr, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV4_DONE_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV4_DONE_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Get master arbitration lost status.
  * This bit automatically sets to 1 when the I2C Master has lost arbitration of
@@ -1288,8 +1307,8 @@ bool MPU6050_getSlave4IsDone() {
  * @see MPU6050_RA_I2C_MST_STATUS
  */
 bool MPU6050_getLostArbitration() {
-    I2C_readBit(devAddr, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_LOST_ARB_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_LOST_ARB_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Get Slave 4 NACK status.
  * This bit automatically sets to 1 when the I2C Master receives a NACK in a
@@ -1299,8 +1318,8 @@ bool MPU6050_getLostArbitration() {
  * @see MPU6050_RA_I2C_MST_STATUS
  */
 bool MPU6050_getSlave4Nack() {
-    I2C_readBit(devAddr, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV4_NACK_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV4_NACK_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Get Slave 3 NACK status.
  * This bit automatically sets to 1 when the I2C Master receives a NACK in a
@@ -1310,8 +1329,8 @@ bool MPU6050_getSlave4Nack() {
  * @see MPU6050_RA_I2C_MST_STATUS
  */
 bool MPU6050_getSlave3Nack() {
-    I2C_readBit(devAddr, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV3_NACK_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV3_NACK_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Get Slave 2 NACK status.
  * This bit automatically sets to 1 when the I2C Master receives a NACK in a
@@ -1321,8 +1340,8 @@ bool MPU6050_getSlave3Nack() {
  * @see MPU6050_RA_I2C_MST_STATUS
  */
 bool MPU6050_getSlave2Nack() {
-    I2C_readBit(devAddr, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV2_NACK_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV2_NACK_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Get Slave 1 NACK status.
  * This bit automatically sets to 1 when the I2C Master receives a NACK in a
@@ -1332,8 +1351,8 @@ bool MPU6050_getSlave2Nack() {
  * @see MPU6050_RA_I2C_MST_STATUS
  */
 bool MPU6050_getSlave1Nack() {
-    I2C_readBit(devAddr, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV1_NACK_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV1_NACK_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Get Slave 0 NACK status.
  * This bit automatically sets to 1 when the I2C Master receives a NACK in a
@@ -1343,8 +1362,8 @@ bool MPU6050_getSlave1Nack() {
  * @see MPU6050_RA_I2C_MST_STATUS
  */
 bool MPU6050_getSlave0Nack() {
-    I2C_readBit(devAddr, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV0_NACK_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV0_NACK_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 
 // INT_PIN_CFG register
@@ -1356,8 +1375,8 @@ bool MPU6050_getSlave0Nack() {
  * @see MPU6050_INTCFG_INT_LEVEL_BIT
  */
 bool MPU6050_getInterruptMode() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_LEVEL_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_LEVEL_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set interrupt logic level mode.
  * @param mode New interrupt mode (0=active-high, 1=active-low)
@@ -1366,7 +1385,7 @@ bool MPU6050_getInterruptMode() {
  * @see MPU6050_INTCFG_INT_LEVEL_BIT
  */
 void MPU6050_setInterruptMode(bool mode) {
-   I2C_writeBit(devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_LEVEL_BIT, mode);
+   I2C_writeBit(mpu_default.address, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_LEVEL_BIT, mode);
 }
 /** Get interrupt drive mode.
  * Will be set 0 for push-pull, 1 for open-drain.
@@ -1375,8 +1394,8 @@ void MPU6050_setInterruptMode(bool mode) {
  * @see MPU6050_INTCFG_INT_OPEN_BIT
  */
 bool MPU6050_getInterruptDrive() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_OPEN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_OPEN_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set interrupt drive mode.
  * @param drive New interrupt drive mode (0=push-pull, 1=open-drain)
@@ -1385,7 +1404,7 @@ bool MPU6050_getInterruptDrive() {
  * @see MPU6050_INTCFG_INT_OPEN_BIT
  */
 void MPU6050_setInterruptDrive(bool drive) {
-    I2C_writeBit(devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_OPEN_BIT, drive);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_OPEN_BIT, drive);
 }
 /** Get interrupt latch mode.
  * Will be set 0 for 50us-pulse, 1 for latch-until-int-cleared.
@@ -1394,8 +1413,8 @@ void MPU6050_setInterruptDrive(bool drive) {
  * @see MPU6050_INTCFG_LATCH_INT_EN_BIT
  */
 bool MPU6050_getInterruptLatch() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_LATCH_INT_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_LATCH_INT_EN_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set interrupt latch mode.
  * @param latch New latch mode (0=50us-pulse, 1=latch-until-int-cleared)
@@ -1404,7 +1423,7 @@ bool MPU6050_getInterruptLatch() {
  * @see MPU6050_INTCFG_LATCH_INT_EN_BIT
  */
 void MPU6050_setInterruptLatch(bool latch) {
-    I2C_writeBit(devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_LATCH_INT_EN_BIT, latch);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_LATCH_INT_EN_BIT, latch);
 }
 /** Get interrupt latch clear mode.
  * Will be set 0 for status-read-only, 1 for any-register-read.
@@ -1413,8 +1432,8 @@ void MPU6050_setInterruptLatch(bool latch) {
  * @see MPU6050_INTCFG_INT_RD_CLEAR_BIT
  */
 bool MPU6050_getInterruptLatchClear() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_RD_CLEAR_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_RD_CLEAR_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set interrupt latch clear mode.
  * @param clear New latch clear mode (0=status-read-only, 1=any-register-read)
@@ -1423,7 +1442,7 @@ bool MPU6050_getInterruptLatchClear() {
  * @see MPU6050_INTCFG_INT_RD_CLEAR_BIT
  */
 void MPU6050_setInterruptLatchClear(bool clear) {
-    I2C_writeBit(devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_RD_CLEAR_BIT, clear);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_RD_CLEAR_BIT, clear);
 }
 /** Get FSYNC interrupt logic level mode.
  * @return Current FSYNC interrupt mode (0=active-high, 1=active-low)
@@ -1432,8 +1451,8 @@ void MPU6050_setInterruptLatchClear(bool clear) {
  * @see MPU6050_INTCFG_FSYNC_INT_LEVEL_BIT
  */
 bool MPU6050_getFSyncInterruptLevel() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_FSYNC_INT_LEVEL_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_FSYNC_INT_LEVEL_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set FSYNC interrupt logic level mode.
  * @param mode New FSYNC interrupt mode (0=active-high, 1=active-low)
@@ -1442,7 +1461,7 @@ bool MPU6050_getFSyncInterruptLevel() {
  * @see MPU6050_INTCFG_FSYNC_INT_LEVEL_BIT
  */
 void MPU6050_setFSyncInterruptLevel(bool level) {
-    I2C_writeBit(devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_FSYNC_INT_LEVEL_BIT, level);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_FSYNC_INT_LEVEL_BIT, level);
 }
 /** Get FSYNC pin interrupt enabled setting.
  * Will be set 0 for disabled, 1 for enabled.
@@ -1451,8 +1470,8 @@ void MPU6050_setFSyncInterruptLevel(bool level) {
  * @see MPU6050_INTCFG_FSYNC_INT_EN_BIT
  */
 bool MPU6050_getFSyncInterruptEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_FSYNC_INT_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_FSYNC_INT_EN_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set FSYNC pin interrupt enabled setting.
  * @param enabled New FSYNC pin interrupt enabled setting
@@ -1461,7 +1480,7 @@ bool MPU6050_getFSyncInterruptEnabled() {
  * @see MPU6050_INTCFG_FSYNC_INT_EN_BIT
  */
 void MPU6050_setFSyncInterruptEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_FSYNC_INT_EN_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_FSYNC_INT_EN_BIT, enabled);
 }
 /** Get I2C bypass enabled status.
  * When this bit is equal to 1 and I2C_MST_EN (Register 106 bit[5]) is equal to
@@ -1475,8 +1494,8 @@ void MPU6050_setFSyncInterruptEnabled(bool enabled) {
  * @see MPU6050_INTCFG_I2C_BYPASS_EN_BIT
  */
 bool MPU6050_getI2CBypassEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_I2C_BYPASS_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_I2C_BYPASS_EN_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set I2C bypass enabled status.
  * When this bit is equal to 1 and I2C_MST_EN (Register 106 bit[5]) is equal to
@@ -1490,7 +1509,7 @@ bool MPU6050_getI2CBypassEnabled() {
  * @see MPU6050_INTCFG_I2C_BYPASS_EN_BIT
  */
 void MPU6050_setI2CBypassEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_I2C_BYPASS_EN_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_I2C_BYPASS_EN_BIT, enabled);
 }
 /** Get reference clock output enabled status.
  * When this bit is equal to 1, a reference clock output is provided at the
@@ -1502,8 +1521,8 @@ void MPU6050_setI2CBypassEnabled(bool enabled) {
  * @see MPU6050_INTCFG_CLKOUT_EN_BIT
  */
 bool MPU6050_getClockOutputEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_CLKOUT_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_CLKOUT_EN_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set reference clock output enabled status.
  * When this bit is equal to 1, a reference clock output is provided at the
@@ -1515,7 +1534,7 @@ bool MPU6050_getClockOutputEnabled() {
  * @see MPU6050_INTCFG_CLKOUT_EN_BIT
  */
 void MPU6050_setClockOutputEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_CLKOUT_EN_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_CLKOUT_EN_BIT, enabled);
 }
 
 // INT_ENABLE register
@@ -1528,8 +1547,8 @@ void MPU6050_setClockOutputEnabled(bool enabled) {
  * @see MPU6050_INTERRUPT_FF_BIT
  **/
 uint8_t MPU6050_getIntEnabled() {
-    I2C_readByte(devAddr, MPU6050_RA_INT_ENABLE, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readByte(mpu_default.address, MPU6050_RA_INT_ENABLE, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set full interrupt enabled status.
  * Full register byte for all interrupts, for quick reading. Each bit should be
@@ -1540,7 +1559,7 @@ uint8_t MPU6050_getIntEnabled() {
  * @see MPU6050_INTERRUPT_FF_BIT
  **/
 void MPU6050_setIntEnabled(uint8_t enabled) {
-    I2C_writeByte(devAddr, MPU6050_RA_INT_ENABLE, enabled);
+    I2C_writeByte(mpu_default.address, MPU6050_RA_INT_ENABLE, enabled);
 }
 /** Get Free Fall interrupt enabled status.
  * Will be set 0 for disabled, 1 for enabled.
@@ -1549,8 +1568,8 @@ void MPU6050_setIntEnabled(uint8_t enabled) {
  * @see MPU6050_INTERRUPT_FF_BIT
  **/
 bool MPU6050_getIntFreefallEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_FF_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_FF_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set Free Fall interrupt enabled status.
  * @param enabled New interrupt enabled status
@@ -1559,7 +1578,7 @@ bool MPU6050_getIntFreefallEnabled() {
  * @see MPU6050_INTERRUPT_FF_BIT
  **/
 void MPU6050_setIntFreefallEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_FF_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_FF_BIT, enabled);
 }
 /** Get Motion Detection interrupt enabled status.
  * Will be set 0 for disabled, 1 for enabled.
@@ -1568,8 +1587,8 @@ void MPU6050_setIntFreefallEnabled(bool enabled) {
  * @see MPU6050_INTERRUPT_MOT_BIT
  **/
 bool MPU6050_getIntMotionEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_MOT_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_MOT_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set Motion Detection interrupt enabled status.
  * @param enabled New interrupt enabled status
@@ -1578,7 +1597,7 @@ bool MPU6050_getIntMotionEnabled() {
  * @see MPU6050_INTERRUPT_MOT_BIT
  **/
 void MPU6050_setIntMotionEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_MOT_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_MOT_BIT, enabled);
 }
 /** Get Zero Motion Detection interrupt enabled status.
  * Will be set 0 for disabled, 1 for enabled.
@@ -1587,8 +1606,8 @@ void MPU6050_setIntMotionEnabled(bool enabled) {
  * @see MPU6050_INTERRUPT_ZMOT_BIT
  **/
 bool MPU6050_getIntZeroMotionEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_ZMOT_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_ZMOT_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set Zero Motion Detection interrupt enabled status.
  * @param enabled New interrupt enabled status
@@ -1597,7 +1616,7 @@ bool MPU6050_getIntZeroMotionEnabled() {
  * @see MPU6050_INTERRUPT_ZMOT_BIT
  **/
 void MPU6050_setIntZeroMotionEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_ZMOT_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_ZMOT_BIT, enabled);
 }
 /** Get FIFO Buffer Overflow interrupt enabled status.
  * Will be set 0 for disabled, 1 for enabled.
@@ -1606,8 +1625,8 @@ void MPU6050_setIntZeroMotionEnabled(bool enabled) {
  * @see MPU6050_INTERRUPT_FIFO_OFLOW_BIT
  **/
 bool MPU6050_getIntFIFOBufferOverflowEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_FIFO_OFLOW_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_FIFO_OFLOW_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set FIFO Buffer Overflow interrupt enabled status.
  * @param enabled New interrupt enabled status
@@ -1616,7 +1635,7 @@ bool MPU6050_getIntFIFOBufferOverflowEnabled() {
  * @see MPU6050_INTERRUPT_FIFO_OFLOW_BIT
  **/
 void MPU6050_setIntFIFOBufferOverflowEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_FIFO_OFLOW_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_FIFO_OFLOW_BIT, enabled);
 }
 /** Get I2C Master interrupt enabled status.
  * This enables any of the I2C Master interrupt sources to generate an
@@ -1626,8 +1645,8 @@ void MPU6050_setIntFIFOBufferOverflowEnabled(bool enabled) {
  * @see MPU6050_INTERRUPT_I2C_MST_INT_BIT
  **/
 bool MPU6050_getIntI2CMasterEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_I2C_MST_INT_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_I2C_MST_INT_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set I2C Master interrupt enabled status.
  * @param enabled New interrupt enabled status
@@ -1636,7 +1655,7 @@ bool MPU6050_getIntI2CMasterEnabled() {
  * @see MPU6050_INTERRUPT_I2C_MST_INT_BIT
  **/
 void MPU6050_setIntI2CMasterEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_I2C_MST_INT_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_I2C_MST_INT_BIT, enabled);
 }
 /** Get Data Ready interrupt enabled setting.
  * This event occurs each time a write operation to all of the sensor registers
@@ -1646,8 +1665,8 @@ void MPU6050_setIntI2CMasterEnabled(bool enabled) {
  * @see MPU6050_INTERRUPT_DATA_RDY_BIT
  */
 bool MPU6050_getIntDataReadyEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_DATA_RDY_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_DATA_RDY_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set Data Ready interrupt enabled status.
  * @param enabled New interrupt enabled status
@@ -1656,7 +1675,7 @@ bool MPU6050_getIntDataReadyEnabled() {
  * @see MPU6050_INTERRUPT_DATA_RDY_BIT
  */
 void MPU6050_setIntDataReadyEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_DATA_RDY_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_DATA_RDY_BIT, enabled);
 }
 
 // INT_STATUS register
@@ -1669,8 +1688,8 @@ void MPU6050_setIntDataReadyEnabled(bool enabled) {
  * @see MPU6050_RA_INT_STATUS
  */
 uint8_t MPU6050_getIntStatus() {
-    I2C_readByte(devAddr, MPU6050_RA_INT_STATUS, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readByte(mpu_default.address, MPU6050_RA_INT_STATUS, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Get Free Fall interrupt status.
  * This bit automatically sets to 1 when a Free Fall interrupt has been
@@ -1680,8 +1699,8 @@ uint8_t MPU6050_getIntStatus() {
  * @see MPU6050_INTERRUPT_FF_BIT
  */
 bool MPU6050_getIntFreefallStatus() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_FF_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_FF_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Get Motion Detection interrupt status.
  * This bit automatically sets to 1 when a Motion Detection interrupt has been
@@ -1691,8 +1710,8 @@ bool MPU6050_getIntFreefallStatus() {
  * @see MPU6050_INTERRUPT_MOT_BIT
  */
 bool MPU6050_getIntMotionStatus() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_MOT_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_MOT_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Get Zero Motion Detection interrupt status.
  * This bit automatically sets to 1 when a Zero Motion Detection interrupt has
@@ -1702,8 +1721,8 @@ bool MPU6050_getIntMotionStatus() {
  * @see MPU6050_INTERRUPT_ZMOT_BIT
  */
 bool MPU6050_getIntZeroMotionStatus() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_ZMOT_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_ZMOT_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Get FIFO Buffer Overflow interrupt status.
  * This bit automatically sets to 1 when a Free Fall interrupt has been
@@ -1713,8 +1732,8 @@ bool MPU6050_getIntZeroMotionStatus() {
  * @see MPU6050_INTERRUPT_FIFO_OFLOW_BIT
  */
 bool MPU6050_getIntFIFOBufferOverflowStatus() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_FIFO_OFLOW_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_FIFO_OFLOW_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Get I2C Master interrupt status.
  * This bit automatically sets to 1 when an I2C Master interrupt has been
@@ -1725,8 +1744,8 @@ bool MPU6050_getIntFIFOBufferOverflowStatus() {
  * @see MPU6050_INTERRUPT_I2C_MST_INT_BIT
  */
 bool MPU6050_getIntI2CMasterStatus() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_I2C_MST_INT_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_I2C_MST_INT_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Get Data Ready interrupt status.
  * This bit automatically sets to 1 when a Data Ready interrupt has been
@@ -1736,14 +1755,15 @@ bool MPU6050_getIntI2CMasterStatus() {
  * @see MPU6050_INTERRUPT_DATA_RDY_BIT
  */
 bool MPU6050_getIntDataReadyStatus() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_DATA_RDY_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_DATA_RDY_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 
 // ACCEL_*OUT_* registers
 
 /** Get raw 9-axis motion sensor readings (accel/gyro/compass).
- * FUNCTION NOT FULLY IMPLEMENTED YET.
+ * Magnetometer words are read from the first 6 bytes of EXT_SENS_DATA, so
+ * slave 0 must be attached to the magnetometer (see MPU6050_DevAuxAttach()).
  * @param ax 16-bit signed integer container for accelerometer X-axis value
  * @param ay 16-bit signed integer container for accelerometer Y-axis value
  * @param az 16-bit signed integer container for accelerometer Z-axis value
@@ -1759,8 +1779,18 @@ bool MPU6050_getIntDataReadyStatus() {
  * @see MPU6050_RA_ACCEL_XOUT_H
  */
 void MPU6050_getMotion9(int16_t* ax, int16_t* ay, int16_t* az, int16_t* gx, int16_t* gy, int16_t* gz, int16_t* mx, int16_t* my, int16_t* mz) {
-    MPU6050_getMotion6(ax, ay, az, gx, gy, gz);
-    // TODO: magnetometer integration
+    uint8_t *b = mpu_default.buffer;
+    // magnetometer words are the first 6 bytes of EXT_SENS_DATA (see MPU6050_DevAuxAttach())
+    MPU6050_DevReadRegister(&mpu_default, MPU6050_RA_ACCEL_XOUT_H, b, MPU6050_MOTION_BYTES + 6);
+    *ax = (((int16_t)b[0]) << 8) | b[1];
+    *ay = (((int16_t)b[2]) << 8) | b[3];
+    *az = (((int16_t)b[4]) << 8) | b[5];
+    *gx = (((int16_t)b[8]) << 8) | b[9];
+    *gy = (((int16_t)b[10]) << 8) | b[11];
+    *gz = (((int16_t)b[12]) << 8) | b[13];
+    *mx = (((int16_t)b[14]) << 8) | b[15];
+    *my = (((int16_t)b[16]) << 8) | b[17];
+    *mz = (((int16_t)b[18]) << 8) | b[19];
 }
 /** Get raw 6-axis motion sensor readings (accel/gyro).
  * Retrieves all currently available motion sensor values.
@@ -1775,13 +1805,13 @@ void MPU6050_getMotion9(int16_t* ax, int16_t* ay, int16_t* az, int16_t* gx, int1
  * @see MPU6050_RA_ACCEL_XOUT_H
  */
 void MPU6050_getMotion6(int16_t* ax, int16_t* ay, int16_t* az, int16_t* gx, int16_t* gy, int16_t* gz) {
-    I2C_readBytes(devAddr, MPU6050_RA_ACCEL_XOUT_H, 14, buffer, I2C_MASTER_TIMEOUT_MS);
-    *ax = (((int16_t)buffer[0]) << 8) | buffer[1];
-    *ay = (((int16_t)buffer[2]) << 8) | buffer[3];
-    *az = (((int16_t)buffer[4]) << 8) | buffer[5];
-    *gx = (((int16_t)buffer[8]) << 8) | buffer[9];
-    *gy = (((int16_t)buffer[10]) << 8) | buffer[11];
-    *gz = (((int16_t)buffer[12]) << 8) | buffer[13];
+    I2C_readBytes(mpu_default.address, MPU6050_RA_ACCEL_XOUT_H, 14, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    *ax = (((int16_t)mpu_default.buffer[0]) << 8) | mpu_default.buffer[1];
+    *ay = (((int16_t)mpu_default.buffer[2]) << 8) | mpu_default.buffer[3];
+    *az = (((int16_t)mpu_default.buffer[4]) << 8) | mpu_default.buffer[5];
+    *gx = (((int16_t)mpu_default.buffer[8]) << 8) | mpu_default.buffer[9];
+    *gy = (((int16_t)mpu_default.buffer[10]) << 8) | mpu_default.buffer[11];
+    *gz = (((int16_t)mpu_default.buffer[12]) << 8) | mpu_default.buffer[13];
 }
 /** Get 3-axis accelerometer readings.
  * These registers store the most recent accelerometer measurements.
@@ -1820,10 +1850,10 @@ void MPU6050_getMotion6(int16_t* ax, int16_t* ay, int16_t* az, int16_t* gx, int1
  * @see MPU6050_RA_GYRO_XOUT_H
  */
 void MPU6050_getAcceleration(int16_t* x, int16_t* y, int16_t* z) {
-    I2C_readBytes(devAddr, MPU6050_RA_ACCEL_XOUT_H, 6, buffer, I2C_MASTER_TIMEOUT_MS);
-    *x = (((int16_t)buffer[0]) << 8) | buffer[1];
-    *y = (((int16_t)buffer[2]) << 8) | buffer[3];
-    *z = (((int16_t)buffer[4]) << 8) | buffer[5];
+    I2C_readBytes(mpu_default.address, MPU6050_RA_ACCEL_XOUT_H, 6, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    *x = (((int16_t)mpu_default.buffer[0]) << 8) | mpu_default.buffer[1];
+    *y = (((int16_t)mpu_default.buffer[2]) << 8) | mpu_default.buffer[3];
+    *z = (((int16_t)mpu_default.buffer[4]) << 8) | mpu_default.buffer[5];
 }
 /** Get X-axis accelerometer reading.
  * @return X-axis acceleration measurement in 16-bit 2's complement format
@@ -1831,8 +1861,8 @@ void MPU6050_getAcceleration(int16_t* x, int16_t* y, int16_t* z) {
  * @see MPU6050_RA_ACCEL_XOUT_H
  */
 int16_t MPU6050_getAccelerationX() {
-    I2C_readBytes(devAddr, MPU6050_RA_ACCEL_XOUT_H, 2, buffer, I2C_MASTER_TIMEOUT_MS);
-    return (((int16_t)buffer[0]) << 8) | buffer[1];
+    I2C_readBytes(mpu_default.address, MPU6050_RA_ACCEL_XOUT_H, 2, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return (((int16_t)mpu_default.buffer[0]) << 8) | mpu_default.buffer[1];
 }
 /** Get Y-axis accelerometer reading.
  * @return Y-axis acceleration measurement in 16-bit 2's complement format
@@ -1840,8 +1870,8 @@ int16_t MPU6050_getAccelerationX() {
  * @see MPU6050_RA_ACCEL_YOUT_H
  */
 int16_t MPU6050_getAccelerationY() {
-    I2C_readBytes(devAddr, MPU6050_RA_ACCEL_YOUT_H, 2, buffer, I2C_MASTER_TIMEOUT_MS);
-    return (((int16_t)buffer[0]) << 8) | buffer[1];
+    I2C_readBytes(mpu_default.address, MPU6050_RA_ACCEL_YOUT_H, 2, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return (((int16_t)mpu_default.buffer[0]) << 8) | mpu_default.buffer[1];
 }
 /** Get Z-axis accelerometer reading.
  * @return Z-axis acceleration measurement in 16-bit 2's complement format
@@ -1849,8 +1879,8 @@ int16_t MPU6050_getAccelerationY() {
  * @see MPU6050_RA_ACCEL_ZOUT_H
  */
 int16_t MPU6050_getAccelerationZ() {
-    I2C_readBytes(devAddr, MPU6050_RA_ACCEL_ZOUT_H, 2, buffer, I2C_MASTER_TIMEOUT_MS);
-    return (((int16_t)buffer[0]) << 8) | buffer[1];
+    I2C_readBytes(mpu_default.address, MPU6050_RA_ACCEL_ZOUT_H, 2, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return (((int16_t)mpu_default.buffer[0]) << 8) | mpu_default.buffer[1];
 }
 
 // TEMP_OUT_* registers
@@ -1860,8 +1890,8 @@ int16_t MPU6050_getAccelerationZ() {
  * @see MPU6050_RA_TEMP_OUT_H
  */
 int16_t MPU6050_getTemperature() {
-    I2C_readBytes(devAddr, MPU6050_RA_TEMP_OUT_H, 2, buffer, I2C_MASTER_TIMEOUT_MS);
-    return (((int16_t)buffer[0]) << 8) | buffer[1];
+    I2C_readBytes(mpu_default.address, MPU6050_RA_TEMP_OUT_H, 2, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return (((int16_t)mpu_default.buffer[0]) << 8) | mpu_default.buffer[1];
 }
 
 // GYRO_*OUT_* registers
@@ -1899,10 +1929,10 @@ int16_t MPU6050_getTemperature() {
  * @see MPU6050_RA_GYRO_XOUT_H
  */
 void MPU6050_getRotation(int16_t* x, int16_t* y, int16_t* z) {
-    I2C_readBytes(devAddr, MPU6050_RA_GYRO_XOUT_H, 6, buffer, I2C_MASTER_TIMEOUT_MS);
-    *x = (((int16_t)buffer[0]) << 8) | buffer[1];
-    *y = (((int16_t)buffer[2]) << 8) | buffer[3];
-    *z = (((int16_t)buffer[4]) << 8) | buffer[5];
+    I2C_readBytes(mpu_default.address, MPU6050_RA_GYRO_XOUT_H, 6, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    *x = (((int16_t)mpu_default.buffer[0]) << 8) | mpu_default.buffer[1];
+    *y = (((int16_t)mpu_default.buffer[2]) << 8) | mpu_default.buffer[3];
+    *z = (((int16_t)mpu_default.buffer[4]) << 8) | mpu_default.buffer[5];
 }
 /** Get X-axis gyroscope reading.
  * @return X-axis rotation measurement in 16-bit 2's complement format
@@ -1910,8 +1940,8 @@ void MPU6050_getRotation(int16_t* x, int16_t* y, int16_t* z) {
  * @see MPU6050_RA_GYRO_XOUT_H
  */
 int16_t MPU6050_getRotationX() {
-    I2C_readBytes(devAddr, MPU6050_RA_GYRO_XOUT_H, 2, buffer, I2C_MASTER_TIMEOUT_MS);
-    return (((int16_t)buffer[0]) << 8) | buffer[1];
+    I2C_readBytes(mpu_default.address, MPU6050_RA_GYRO_XOUT_H, 2, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return (((int16_t)mpu_default.buffer[0]) << 8) | mpu_default.buffer[1];
 }
 /** Get Y-axis gyroscope reading.
  * @return Y-axis rotation measurement in 16-bit 2's complement format
@@ -1919,8 +1949,8 @@ int16_t MPU6050_getRotationX() {
  * @see MPU6050_RA_GYRO_YOUT_H
  */
 int16_t MPU6050_getRotationY() {
-    I2C_readBytes(devAddr, MPU6050_RA_GYRO_YOUT_H, 2, buffer, I2C_MASTER_TIMEOUT_MS);
-    return (((int16_t)buffer[0]) << 8) | buffer[1];
+    I2C_readBytes(mpu_default.address, MPU6050_RA_GYRO_YOUT_H, 2, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return (((int16_t)mpu_default.buffer[0]) << 8) | mpu_default.buffer[1];
 }
 /** Get Z-axis gyroscope reading.
  * @return Z-axis rotation measurement in 16-bit 2's complement format
@@ -1928,8 +1958,8 @@ int16_t MPU6050_getRotationY() {
  * @see MPU6050_RA_GYRO_ZOUT_H
  */
 int16_t MPU6050_getRotationZ() {
-    I2C_readBytes(devAddr, MPU6050_RA_GYRO_ZOUT_H, 2, buffer, I2C_MASTER_TIMEOUT_MS);
-    return (((int16_t)buffer[0]) << 8) | buffer[1];
+    I2C_readBytes(mpu_default.address, MPU6050_RA_GYRO_ZOUT_H, 2, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return (((int16_t)mpu_default.buffer[0]) << 8) | mpu_default.buffer[1];
 }
 
 // EXT_SENS_DATA_* registers
@@ -2009,8 +2039,8 @@ int16_t MPU6050_getRotationZ() {
  * @return Byte read from register
  */
 uint8_t MPU6050_getExternalSensorByte(int position) {
-    I2C_readByte(devAddr, MPU6050_RA_EXT_SENS_DATA_00 + position, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readByte(mpu_default.address, MPU6050_RA_EXT_SENS_DATA_00 + position, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Read word (2 bytes) from external sensor data registers.
  * @param position Starting position (0-21)
@@ -2018,8 +2048,8 @@ uint8_t MPU6050_getExternalSensorByte(int position) {
  * @see getExternalSensorByte()
  */
 uint16_t MPU6050_getExternalSensorWord(int position) {
-    I2C_readBytes(devAddr, MPU6050_RA_EXT_SENS_DATA_00 + position, 2, buffer, I2C_MASTER_TIMEOUT_MS);
-    return (((uint16_t)buffer[0]) << 8) | buffer[1];
+    I2C_readBytes(mpu_default.address, MPU6050_RA_EXT_SENS_DATA_00 + position, 2, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return (((uint16_t)mpu_default.buffer[0]) << 8) | mpu_default.buffer[1];
 }
 /** Read double word (4 bytes) from external sensor data registers.
  * @param position Starting position (0-20)
@@ -2027,8 +2057,8 @@ uint16_t MPU6050_getExternalSensorWord(int position) {
  * @see getExternalSensorByte()
  */
 uint32_t MPU6050_getExternalSensorDWord(int position) {
-    I2C_readBytes(devAddr, MPU6050_RA_EXT_SENS_DATA_00 + position, 4, buffer, I2C_MASTER_TIMEOUT_MS);
-    return (((uint32_t)buffer[0]) << 24) | (((uint32_t)buffer[1]) << 16) | (((uint16_t)buffer[2]) << 8) | buffer[3];
+    I2C_readBytes(mpu_default.address, MPU6050_RA_EXT_SENS_DATA_00 + position, 4, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return (((uint32_t)mpu_default.buffer[0]) << 24) | (((uint32_t)mpu_default.buffer[1]) << 16) | (((uint16_t)mpu_default.buffer[2]) << 8) | mpu_default.buffer[3];
 }
 
 // MOT_DETECT_STATUS register
@@ -2038,8 +2068,8 @@ uint32_t MPU6050_getExternalSensorDWord(int position) {
  * @see MPU6050_RA_MOT_DETECT_STATUS
  */
 uint8_t MPU6050_getMotionStatus() {
-    I2C_readByte(devAddr, MPU6050_RA_MOT_DETECT_STATUS, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readByte(mpu_default.address, MPU6050_RA_MOT_DETECT_STATUS, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Get X-axis negative motion detection interrupt status.
  * @return Motion detection status
@@ -2047,8 +2077,8 @@ uint8_t MPU6050_getMotionStatus() {
  * @see MPU6050_MOTION_MOT_XNEG_BIT
  */
 bool MPU6050_getXNegMotionDetected() {
-    I2C_readBit(devAddr, MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_XNEG_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_XNEG_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Get X-axis positive motion detection interrupt status.
  * @return Motion detection status
@@ -2056,8 +2086,8 @@ bool MPU6050_getXNegMotionDetected() {
  * @see MPU6050_MOTION_MOT_XPOS_BIT
  */
 bool MPU6050_getXPosMotionDetected() {
-    I2C_readBit(devAddr, MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_XPOS_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_XPOS_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Get Y-axis negative motion detection interrupt status.
  * @return Motion detection status
@@ -2065,8 +2095,8 @@ bool MPU6050_getXPosMotionDetected() {
  * @see MPU6050_MOTION_MOT_YNEG_BIT
  */
 bool MPU6050_getYNegMotionDetected() {
-    I2C_readBit(devAddr, MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_YNEG_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_YNEG_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Get Y-axis positive motion detection interrupt status.
  * @return Motion detection status
@@ -2074,8 +2104,8 @@ bool MPU6050_getYNegMotionDetected() {
  * @see MPU6050_MOTION_MOT_YPOS_BIT
  */
 bool MPU6050_getYPosMotionDetected() {
-    I2C_readBit(devAddr, MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_YPOS_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_YPOS_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Get Z-axis negative motion detection interrupt status.
  * @return Motion detection status
@@ -2083,8 +2113,8 @@ bool MPU6050_getYPosMotionDetected() {
  * @see MPU6050_MOTION_MOT_ZNEG_BIT
  */
 bool MPU6050_getZNegMotionDetected() {
-    I2C_readBit(devAddr, MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_ZNEG_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_ZNEG_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Get Z-axis positive motion detection interrupt status.
  * @return Motion detection status
@@ -2092,8 +2122,8 @@ bool MPU6050_getZNegMotionDetected() {
  * @see MPU6050_MOTION_MOT_ZPOS_BIT
  */
 bool MPU6050_getZPosMotionDetected() {
-    I2C_readBit(devAddr, MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_ZPOS_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_ZPOS_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Get zero motion detection interrupt status.
  * @return Motion detection status
@@ -2101,8 +2131,8 @@ bool MPU6050_getZPosMotionDetected() {
  * @see MPU6050_MOTION_MOT_ZRMOT_BIT
  */
 bool MPU6050_getZeroMotionDetected() {
-    I2C_readBit(devAddr, MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_ZRMOT_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_ZRMOT_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 
 // I2C_SLV*_DO register
@@ -2117,7 +2147,7 @@ bool MPU6050_getZeroMotionDetected() {
  */
 void MPU6050_setSlaveOutputByte(uint8_t num, uint8_t data) {
     if (num > 3) return;
-    I2C_writeByte(devAddr, MPU6050_RA_I2C_SLV0_DO + num, data);
+    I2C_writeByte(mpu_default.address, MPU6050_RA_I2C_SLV0_DO + num, data);
 }
 
 // I2C_MST_DELAY_CTRL register
@@ -2131,8 +2161,8 @@ void MPU6050_setSlaveOutputByte(uint8_t num, uint8_t data) {
  * @see MPU6050_DELAYCTRL_DELAY_ES_SHADOW_BIT
  */
 bool MPU6050_getExternalShadowDelayEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_I2C_MST_DELAY_CTRL, MPU6050_DELAYCTRL_DELAY_ES_SHADOW_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_I2C_MST_DELAY_CTRL, MPU6050_DELAYCTRL_DELAY_ES_SHADOW_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set external data shadow delay enabled status.
  * @param enabled New external data shadow delay enabled status.
@@ -2141,7 +2171,7 @@ bool MPU6050_getExternalShadowDelayEnabled() {
  * @see MPU6050_DELAYCTRL_DELAY_ES_SHADOW_BIT
  */
 void MPU6050_setExternalShadowDelayEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_I2C_MST_DELAY_CTRL, MPU6050_DELAYCTRL_DELAY_ES_SHADOW_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_I2C_MST_DELAY_CTRL, MPU6050_DELAYCTRL_DELAY_ES_SHADOW_BIT, enabled);
 }
 /** Get slave delay enabled status.
  * When a particular slave delay is enabled, the rate of access for the that
@@ -2164,8 +2194,8 @@ void MPU6050_setExternalShadowDelayEnabled(bool enabled) {
 bool MPU6050_getSlaveDelayEnabled(uint8_t num) {
     // MPU6050_DELAYCTRL_I2C_SLV4_DLY_EN_BIT is 4, SLV3 is 3, etc.
     if (num > 4) return 0;
-    I2C_readBit(devAddr, MPU6050_RA_I2C_MST_DELAY_CTRL, num, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_I2C_MST_DELAY_CTRL, num, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set slave delay enabled status.
  * @param num Slave number (0-4)
@@ -2174,7 +2204,7 @@ bool MPU6050_getSlaveDelayEnabled(uint8_t num) {
  * @see MPU6050_DELAYCTRL_I2C_SLV0_DLY_EN_BIT
  */
 void MPU6050_setSlaveDelayEnabled(uint8_t num, bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_I2C_MST_DELAY_CTRL, num, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_I2C_MST_DELAY_CTRL, num, enabled);
 }
 
 // SIGNAL_PATH_RESET register
@@ -2186,7 +2216,7 @@ void MPU6050_setSlaveDelayEnabled(uint8_t num, bool enabled) {
  * @see MPU6050_PATHRESET_GYRO_RESET_BIT
  */
 void MPU6050_resetGyroscopePath() {
-    I2C_writeBit(devAddr, MPU6050_RA_SIGNAL_PATH_RESET, MPU6050_PATHRESET_GYRO_RESET_BIT, true);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_SIGNAL_PATH_RESET, MPU6050_PATHRESET_GYRO_RESET_BIT, true);
 }
 /** Reset accelerometer signal path.
  * The reset will revert the signal path analog to digital converters and
@@ -2195,7 +2225,7 @@ void MPU6050_resetGyroscopePath() {
  * @see MPU6050_PATHRESET_ACCEL_RESET_BIT
  */
 void MPU6050_resetAccelerometerPath() {
-    I2C_writeBit(devAddr, MPU6050_RA_SIGNAL_PATH_RESET, MPU6050_PATHRESET_ACCEL_RESET_BIT, true);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_SIGNAL_PATH_RESET, MPU6050_PATHRESET_ACCEL_RESET_BIT, true);
 }
 /** Reset temperature sensor signal path.
  * The reset will revert the signal path analog to digital converters and
@@ -2204,7 +2234,7 @@ void MPU6050_resetAccelerometerPath() {
  * @see MPU6050_PATHRESET_TEMP_RESET_BIT
  */
 void MPU6050_resetTemperaturePath() {
-    I2C_writeBit(devAddr, MPU6050_RA_SIGNAL_PATH_RESET, MPU6050_PATHRESET_TEMP_RESET_BIT, true);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_SIGNAL_PATH_RESET, MPU6050_PATHRESET_TEMP_RESET_BIT, true);
 }
 
 // MOT_DETECT_CTRL register
@@ -2224,8 +2254,8 @@ void MPU6050_resetTemperaturePath() {
  * @see MPU6050_DETECT_ACCEL_ON_DELAY_BIT
  */
 uint8_t MPU6050_getAccelerometerPowerOnDelay() {
-    I2C_readBits(devAddr, MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_ACCEL_ON_DELAY_BIT, MPU6050_DETECT_ACCEL_ON_DELAY_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBits(mpu_default.address, MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_ACCEL_ON_DELAY_BIT, MPU6050_DETECT_ACCEL_ON_DELAY_LENGTH, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set accelerometer power-on delay.
  * @param delay New accelerometer power-on delay (0-3)
@@ -2234,7 +2264,7 @@ uint8_t MPU6050_getAccelerometerPowerOnDelay() {
  * @see MPU6050_DETECT_ACCEL_ON_DELAY_BIT
  */
 void MPU6050_setAccelerometerPowerOnDelay(uint8_t delay) {
-    I2C_writeBits(devAddr, MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_ACCEL_ON_DELAY_BIT, MPU6050_DETECT_ACCEL_ON_DELAY_LENGTH, delay);
+    I2C_writeBits(mpu_default.address, MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_ACCEL_ON_DELAY_BIT, MPU6050_DETECT_ACCEL_ON_DELAY_LENGTH, delay);
 }
 /** Get Free Fall detection counter decrement configuration.
  * Detection is registered by the Free Fall detection module after accelerometer
@@ -2263,8 +2293,8 @@ void MPU6050_setAccelerometerPowerOnDelay(uint8_t delay) {
  * @see MPU6050_DETECT_FF_COUNT_BIT
  */
 uint8_t MPU6050_getFreefallDetectionCounterDecrement() {
-    I2C_readBits(devAddr, MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_FF_COUNT_BIT, MPU6050_DETECT_FF_COUNT_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBits(mpu_default.address, MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_FF_COUNT_BIT, MPU6050_DETECT_FF_COUNT_LENGTH, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set Free Fall detection counter decrement configuration.
  * @param decrement New decrement configuration value
@@ -2273,7 +2303,7 @@ uint8_t MPU6050_getFreefallDetectionCounterDecrement() {
  * @see MPU6050_DETECT_FF_COUNT_BIT
  */
 void MPU6050_setFreefallDetectionCounterDecrement(uint8_t decrement) {
-    I2C_writeBits(devAddr, MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_FF_COUNT_BIT, MPU6050_DETECT_FF_COUNT_LENGTH, decrement);
+    I2C_writeBits(mpu_default.address, MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_FF_COUNT_BIT, MPU6050_DETECT_FF_COUNT_LENGTH, decrement);
 }
 /** Get Motion detection counter decrement configuration.
  * Detection is registered by the Motion detection module after accelerometer
@@ -2299,8 +2329,8 @@ void MPU6050_setFreefallDetectionCounterDecrement(uint8_t decrement) {
  *
  */
 uint8_t MPU6050_getMotionDetectionCounterDecrement() {
-    I2C_readBits(devAddr, MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_MOT_COUNT_BIT, MPU6050_DETECT_MOT_COUNT_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBits(mpu_default.address, MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_MOT_COUNT_BIT, MPU6050_DETECT_MOT_COUNT_LENGTH, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set Motion detection counter decrement configuration.
  * @param decrement New decrement configuration value
@@ -2309,7 +2339,7 @@ uint8_t MPU6050_getMotionDetectionCounterDecrement() {
  * @see MPU6050_DETECT_MOT_COUNT_BIT
  */
 void MPU6050_setMotionDetectionCounterDecrement(uint8_t decrement) {
-    I2C_writeBits(devAddr, MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_MOT_COUNT_BIT, MPU6050_DETECT_MOT_COUNT_LENGTH, decrement);
+    I2C_writeBits(mpu_default.address, MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_MOT_COUNT_BIT, MPU6050_DETECT_MOT_COUNT_LENGTH, decrement);
 }
 
 // USER_CTRL register
@@ -2323,8 +2353,8 @@ void MPU6050_setMotionDetectionCounterDecrement(uint8_t decrement) {
  * @see MPU6050_USERCTRL_FIFO_EN_BIT
  */
 bool MPU6050_getFIFOEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_FIFO_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_FIFO_EN_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set FIFO enabled status.
  * @param enabled New FIFO enabled status
@@ -2333,7 +2363,7 @@ bool MPU6050_getFIFOEnabled() {
  * @see MPU6050_USERCTRL_FIFO_EN_BIT
  */
 void MPU6050_setFIFOEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_FIFO_EN_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_FIFO_EN_BIT, enabled);
 }
 /** Get I2C Master Mode enabled status.
  * When this mode is enabled, the MPU-60X0 acts as the I2C Master to the
@@ -2347,8 +2377,8 @@ void MPU6050_setFIFOEnabled(bool enabled) {
  * @see MPU6050_USERCTRL_I2C_MST_EN_BIT
  */
 bool MPU6050_getI2CMasterModeEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_I2C_MST_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_I2C_MST_EN_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set I2C Master Mode enabled status.
  * @param enabled New I2C Master Mode enabled status
@@ -2357,14 +2387,14 @@ bool MPU6050_getI2CMasterModeEnabled() {
  * @see MPU6050_USERCTRL_I2C_MST_EN_BIT
  */
 void MPU6050_setI2CMasterModeEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_I2C_MST_EN_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_I2C_MST_EN_BIT, enabled);
 }
 /** Switch from I2C to SPI mode (MPU-6000 only)
  * If this is set, the primary SPI interface will be enabled in place of the
  * disabled primary I2C interface.
  */
 void MPU6050_switchSPIEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_I2C_IF_DIS_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_I2C_IF_DIS_BIT, enabled);
 }
 /** Reset the FIFO.
  * This bit resets the FIFO buffer when set to 1 while FIFO_EN equals 0. This
@@ -2373,7 +2403,7 @@ void MPU6050_switchSPIEnabled(bool enabled) {
  * @see MPU6050_USERCTRL_FIFO_RESET_BIT
  */
 void MPU6050_resetFIFO() {
-    I2C_writeBit(devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_FIFO_RESET_BIT, true);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_FIFO_RESET_BIT, true);
 }
 /** Reset the I2C Master.
  * This bit resets the I2C Master when set to 1 while I2C_MST_EN equals 0.
@@ -2382,7 +2412,7 @@ void MPU6050_resetFIFO() {
  * @see MPU6050_USERCTRL_I2C_MST_RESET_BIT
  */
 void MPU6050_resetI2CMaster() {
-    I2C_writeBit(devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_I2C_MST_RESET_BIT, true);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_I2C_MST_RESET_BIT, true);
 }
 /** Reset all sensor registers and signal paths.
  * When set to 1, this bit resets the signal paths for all sensors (gyroscopes,
@@ -2397,7 +2427,7 @@ void MPU6050_resetI2CMaster() {
  * @see MPU6050_USERCTRL_SIG_COND_RESET_BIT
  */
 void MPU6050_resetSensors() {
-    I2C_writeBit(devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_SIG_COND_RESET_BIT, true);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_SIG_COND_RESET_BIT, true);
 }
 
 // PWR_MGMT_1 register
@@ -2408,7 +2438,7 @@ void MPU6050_resetSensors() {
  * @see MPU6050_PWR1_DEVICE_RESET_BIT
  */
 void MPU6050_reset() {
-    I2C_writeBit(devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_DEVICE_RESET_BIT, true);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_DEVICE_RESET_BIT, true);
 }
 /** Get sleep mode status.
  * Setting the SLEEP bit in the register puts the device into very low power
@@ -2422,8 +2452,8 @@ void MPU6050_reset() {
  * @see MPU6050_PWR1_SLEEP_BIT
  */
 bool MPU6050_getSleepEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_SLEEP_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_SLEEP_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set sleep mode status.
  * @param enabled New sleep mode enabled status
@@ -2432,7 +2462,7 @@ bool MPU6050_getSleepEnabled() {
  * @see MPU6050_PWR1_SLEEP_BIT
  */
 void MPU6050_setSleepEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_SLEEP_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_SLEEP_BIT, enabled);
 }
 /** Get wake cycle enabled status.
  * When this bit is set to 1 and SLEEP is disabled, the MPU-60X0 will cycle
@@ -2443,8 +2473,8 @@ void MPU6050_setSleepEnabled(bool enabled) {
  * @see MPU6050_PWR1_CYCLE_BIT
  */
 bool MPU6050_getWakeCycleEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_CYCLE_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_CYCLE_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set wake cycle enabled status.
  * @param enabled New sleep mode enabled status
@@ -2453,7 +2483,7 @@ bool MPU6050_getWakeCycleEnabled() {
  * @see MPU6050_PWR1_CYCLE_BIT
  */
 void MPU6050_setWakeCycleEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_CYCLE_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_CYCLE_BIT, enabled);
 }
 /** Get temperature sensor enabled status.
  * Control the usage of the internal temperature sensor.
@@ -2467,8 +2497,8 @@ void MPU6050_setWakeCycleEnabled(bool enabled) {
  * @see MPU6050_PWR1_TEMP_DIS_BIT
  */
 bool MPU6050_getTempSensorEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_TEMP_DIS_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0] == 0; // 1 is actually disabled here
+    I2C_readBit(mpu_default.address, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_TEMP_DIS_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0] == 0; // 1 is actually disabled here
 }
 /** Set temperature sensor enabled status.
  * Note: this register stores the *disabled* value, but for consistency with the
@@ -2482,7 +2512,7 @@ bool MPU6050_getTempSensorEnabled() {
  */
 void MPU6050_setTempSensorEnabled(bool enabled) {
     // 1 is actually disabled here
-    I2C_writeBit(devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_TEMP_DIS_BIT, !enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_TEMP_DIS_BIT, !enabled);
 }
 /** Get clock source setting.
  * @return Current clock source setting
@@ -2491,8 +2521,8 @@ void MPU6050_setTempSensorEnabled(bool enabled) {
  * @see MPU6050_PWR1_CLKSEL_LENGTH
  */
 uint8_t MPU6050_getClockSource() {
-    I2C_readBits(devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_CLKSEL_BIT, MPU6050_PWR1_CLKSEL_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBits(mpu_default.address, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_CLKSEL_BIT, MPU6050_PWR1_CLKSEL_LENGTH, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set clock source setting.
  * An internal 8MHz oscillator, gyroscope based clock, or external sources can
@@ -2525,7 +2555,7 @@ uint8_t MPU6050_getClockSource() {
  * @see MPU6050_PWR1_CLKSEL_LENGTH
  */
 void MPU6050_setClockSource(uint8_t source) {
-    I2C_writeBits(devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_CLKSEL_BIT, MPU6050_PWR1_CLKSEL_LENGTH, source);
+    I2C_writeBits(mpu_default.address, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_CLKSEL_BIT, MPU6050_PWR1_CLKSEL_LENGTH, source);
 }
 
 // PWR_MGMT_2 register
@@ -2554,15 +2584,15 @@ void MPU6050_setClockSource(uint8_t source) {
  * @see MPU6050_RA_PWR_MGMT_2
  */
 uint8_t MPU6050_getWakeFrequency() {
-    I2C_readBits(devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_LP_WAKE_CTRL_BIT, MPU6050_PWR2_LP_WAKE_CTRL_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBits(mpu_default.address, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_LP_WAKE_CTRL_BIT, MPU6050_PWR2_LP_WAKE_CTRL_LENGTH, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set wake frequency in Accel-Only Low Power Mode.
  * @param frequency New wake frequency
  * @see MPU6050_RA_PWR_MGMT_2
  */
 void MPU6050_setWakeFrequency(uint8_t frequency) {
-    I2C_writeBits(devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_LP_WAKE_CTRL_BIT, MPU6050_PWR2_LP_WAKE_CTRL_LENGTH, frequency);
+    I2C_writeBits(mpu_default.address, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_LP_WAKE_CTRL_BIT, MPU6050_PWR2_LP_WAKE_CTRL_LENGTH, frequency);
 }
 
 /** Get X-axis accelerometer standby enabled status.
@@ -2572,8 +2602,8 @@ void MPU6050_setWakeFrequency(uint8_t frequency) {
  * @see MPU6050_PWR2_STBY_XA_BIT
  */
 bool MPU6050_getStandbyXAccelEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_XA_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_XA_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set X-axis accelerometer standby enabled status.
  * @param New X-axis standby enabled status
@@ -2582,7 +2612,7 @@ bool MPU6050_getStandbyXAccelEnabled() {
  * @see MPU6050_PWR2_STBY_XA_BIT
  */
 void MPU6050_setStandbyXAccelEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_XA_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_XA_BIT, enabled);
 }
 /** Get Y-axis accelerometer standby enabled status.
  * If enabled, the Y-axis will not gather or report data (or use power).
@@ -2591,8 +2621,8 @@ void MPU6050_setStandbyXAccelEnabled(bool enabled) {
  * @see MPU6050_PWR2_STBY_YA_BIT
  */
 bool MPU6050_getStandbyYAccelEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_YA_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_YA_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set Y-axis accelerometer standby enabled status.
  * @param New Y-axis standby enabled status
@@ -2601,7 +2631,7 @@ bool MPU6050_getStandbyYAccelEnabled() {
  * @see MPU6050_PWR2_STBY_YA_BIT
  */
 void MPU6050_setStandbyYAccelEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_YA_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_YA_BIT, enabled);
 }
 /** Get Z-axis accelerometer standby enabled status.
  * If enabled, the Z-axis will not gather or report data (or use power).
@@ -2610,8 +2640,8 @@ void MPU6050_setStandbyYAccelEnabled(bool enabled) {
  * @see MPU6050_PWR2_STBY_ZA_BIT
  */
 bool MPU6050_getStandbyZAccelEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_ZA_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_ZA_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set Z-axis accelerometer standby enabled status.
  * @param New Z-axis standby enabled status
@@ -2620,7 +2650,7 @@ bool MPU6050_getStandbyZAccelEnabled() {
  * @see MPU6050_PWR2_STBY_ZA_BIT
  */
 void MPU6050_setStandbyZAccelEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_ZA_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_ZA_BIT, enabled);
 }
 /** Get X-axis gyroscope standby enabled status.
  * If enabled, the X-axis will not gather or report data (or use power).
@@ -2629,8 +2659,8 @@ void MPU6050_setStandbyZAccelEnabled(bool enabled) {
  * @see MPU6050_PWR2_STBY_XG_BIT
  */
 bool MPU6050_getStandbyXGyroEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_XG_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_XG_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set X-axis gyroscope standby enabled status.
  * @param New X-axis standby enabled status
@@ -2639,7 +2669,7 @@ bool MPU6050_getStandbyXGyroEnabled() {
  * @see MPU6050_PWR2_STBY_XG_BIT
  */
 void MPU6050_setStandbyXGyroEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_XG_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_XG_BIT, enabled);
 }
 /** Get Y-axis gyroscope standby enabled status.
  * If enabled, the Y-axis will not gather or report data (or use power).
@@ -2648,8 +2678,8 @@ void MPU6050_setStandbyXGyroEnabled(bool enabled) {
  * @see MPU6050_PWR2_STBY_YG_BIT
  */
 bool MPU6050_getStandbyYGyroEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_YG_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_YG_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set Y-axis gyroscope standby enabled status.
  * @param New Y-axis standby enabled status
@@ -2658,7 +2688,7 @@ bool MPU6050_getStandbyYGyroEnabled() {
  * @see MPU6050_PWR2_STBY_YG_BIT
  */
 void MPU6050_setStandbyYGyroEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_YG_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_YG_BIT, enabled);
 }
 /** Get Z-axis gyroscope standby enabled status.
  * If enabled, the Z-axis will not gather or report data (or use power).
@@ -2667,8 +2697,8 @@ void MPU6050_setStandbyYGyroEnabled(bool enabled) {
  * @see MPU6050_PWR2_STBY_ZG_BIT
  */
 bool MPU6050_getStandbyZGyroEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_ZG_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBit(mpu_default.address, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_ZG_BIT, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set Z-axis gyroscope standby enabled status.
  * @param New Z-axis standby enabled status
@@ -2677,7 +2707,7 @@ bool MPU6050_getStandbyZGyroEnabled() {
  * @see MPU6050_PWR2_STBY_ZG_BIT
  */
 void MPU6050_setStandbyZGyroEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_ZG_BIT, enabled);
+    I2C_writeBit(mpu_default.address, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_ZG_BIT, enabled);
 }
 
 // FIFO_COUNT* registers
@@ -2690,8 +2720,8 @@ void MPU6050_setStandbyZGyroEnabled(bool enabled) {
  * @return Current FIFO buffer size
  */
 uint16_t MPU6050_getFIFOCount() {
-    I2C_readBytes(devAddr, MPU6050_RA_FIFO_COUNTH, 2, buffer, I2C_MASTER_TIMEOUT_MS);
-    return (((uint16_t)buffer[0]) << 8) | buffer[1];
+    I2C_readBytes(mpu_default.address, MPU6050_RA_FIFO_COUNTH, 2, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return (((uint16_t)mpu_default.buffer[0]) << 8) | mpu_default.buffer[1];
 }
 
 // FIFO_R_W register
@@ -2722,12 +2752,12 @@ uint16_t MPU6050_getFIFOCount() {
  * @return Byte from FIFO buffer
  */
 uint8_t MPU6050_getFIFOByte() {
-    I2C_readByte(devAddr, MPU6050_RA_FIFO_R_W, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readByte(mpu_default.address, MPU6050_RA_FIFO_R_W, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 void MPU6050_getFIFOBytes(uint8_t *data, uint8_t length) {
     if(length > 0){
-        I2C_readBytes(devAddr, MPU6050_RA_FIFO_R_W, length, data, I2C_MASTER_TIMEOUT_MS);
+        I2C_readBytes(mpu_default.address, MPU6050_RA_FIFO_R_W, length, data, I2C_MASTER_TIMEOUT_MS);
     } else {
     	*data = 0;
     }
@@ -2737,7 +2767,7 @@ void MPU6050_getFIFOBytes(uint8_t *data, uint8_t length) {
  * @see MPU6050_RA_FIFO_R_W
  */
 void MPU6050_setFIFOByte(uint8_t data) {
-    I2C_writeByte(devAddr, MPU6050_RA_FIFO_R_W, data);
+    I2C_writeByte(mpu_default.address, MPU6050_RA_FIFO_R_W, data);
 }
 
 // WHO_AM_I register
@@ -2750,8 +2780,8 @@ void MPU6050_setFIFOByte(uint8_t data) {
  * @see MPU6050_WHO_AM_I_LENGTH
  */
 uint8_t MPU6050_getDeviceID() {
-    I2C_readBits(devAddr, MPU6050_RA_WHO_AM_I, MPU6050_WHO_AM_I_BIT, MPU6050_WHO_AM_I_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
-    return buffer[0];
+    I2C_readBits(mpu_default.address, MPU6050_RA_WHO_AM_I, MPU6050_WHO_AM_I_BIT, MPU6050_WHO_AM_I_LENGTH, mpu_default.buffer, I2C_MASTER_TIMEOUT_MS);
+    return mpu_default.buffer[0];
 }
 /** Set Device ID.
  * Write a new ID into the WHO_AM_I register (no idea why this should ever be
@@ -2763,7 +2793,324 @@ uint8_t MPU6050_getDeviceID() {
  * @see MPU6050_WHO_AM_I_LENGTH
  */
 void MPU6050_setDeviceID(uint8_t id) {
-    I2C_writeBits(devAddr, MPU6050_RA_WHO_AM_I, MPU6050_WHO_AM_I_BIT, MPU6050_WHO_AM_I_LENGTH, id);
+    I2C_writeBits(mpu_default.address, MPU6050_RA_WHO_AM_I, MPU6050_WHO_AM_I_BIT, MPU6050_WHO_AM_I_LENGTH, id);
+}
+
+// Multi-device API
+
+/** Read consecutive registers from one device.
+ * Register selection and data read are chained with a repeated start in a
+ * single I2C transaction, so no other transfer can be interleaved between
+ * them and the whole burst comes from the same sampling instant.
+ * @param dev Device context
+ * @param reg First register to read
+ * @param data Buffer to store read data in
+ * @param len Number of bytes to read
+ * @return Status of read operation (true = success)
+ */
+bool MPU6050_DevReadRegister(mpu6050_t *dev, uint8_t reg, uint8_t *data, uint8_t len) {
+	esp_err_t ret;
+	i2c_cmd_handle_t cmd;
+
+	cmd = i2c_cmd_link_create();
+	i2c_master_start(cmd);
+	i2c_master_write_byte(cmd, (dev->address << 1) | I2C_MASTER_WRITE, true);
+	i2c_master_write_byte(cmd, reg, true);
+	i2c_master_start(cmd);
+	i2c_master_write_byte(cmd, (dev->address << 1) | I2C_MASTER_READ, true);
+	i2c_master_read(cmd, data, len, I2C_MASTER_LAST_NACK);
+	i2c_master_stop(cmd);
+	ret = i2c_master_cmd_begin(I2C_NUM, cmd, I2C_MASTER_TIMEOUT_MS / portTICK_PERIOD_MS);
+	i2c_cmd_link_delete(cmd);
+
+	return ret == ESP_OK;
+}
+
+/** Power on and prepare one device for general usage.
+ * Same settings as MPU6050_initialize(), applied to the given context.
+ * @param dev Device context
+ * @param address I2C address
+ */
+void MPU6050_DevInit(mpu6050_t *dev, uint8_t address) {
+	dev->address = address;
+	dev->ext_len = 0;
+	memset(dev->aux_len, 0, sizeof(dev->aux_len));
+	MPU6050_DevSetClockSource(dev, MPU6050_CLOCK_PLL_XGYRO);
+	MPU6050_DevSetFullScaleGyroRange(dev, MPU6050_GYRO_FS_250);
+	MPU6050_DevSetFullScaleAccelRange(dev, MPU6050_ACCEL_FS_2);
+	MPU6050_DevSetSleepEnabled(dev, false);
+}
+
+/** Verify the I2C connection of one device.
+ * @param dev Device context
+ * @return True if connection is valid, false otherwise
+ */
+bool MPU6050_DevTestConnection(mpu6050_t *dev) {
+	if (!MPU6050_DevReadRegister(dev, MPU6050_RA_WHO_AM_I, dev->buffer, 1)) {
+		return false;
+	}
+	return ((dev->buffer[0] >> 1) & 0x3F) == 0x34;
+}
+
+/** Set clock source of one device.
+ * @param dev Device context
+ * @param source New clock source setting
+ * @see MPU6050_setClockSource()
+ */
+void MPU6050_DevSetClockSource(mpu6050_t *dev, uint8_t source) {
+	I2C_writeBits(dev->address, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_CLKSEL_BIT, MPU6050_PWR1_CLKSEL_LENGTH, source);
+}
+
+/** Set sleep mode status of one device.
+ * @param dev Device context
+ * @param enabled New sleep mode enabled status
+ * @see MPU6050_setSleepEnabled()
+ */
+void MPU6050_DevSetSleepEnabled(mpu6050_t *dev, bool enabled) {
+	I2C_writeBit(dev->address, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_SLEEP_BIT, enabled);
+}
+
+/** Set full-scale gyroscope range of one device.
+ * @param dev Device context
+ * @param range New full-scale gyroscope range value
+ * @see MPU6050_setFullScaleGyroRange()
+ */
+void MPU6050_DevSetFullScaleGyroRange(mpu6050_t *dev, uint8_t range) {
+	I2C_writeBits(dev->address, MPU6050_RA_GYRO_CONFIG, MPU6050_GCONFIG_FS_SEL_BIT, MPU6050_GCONFIG_FS_SEL_LENGTH, range);
+}
+
+/** Set full-scale accelerometer range of one device.
+ * @param dev Device context
+ * @param range New full-scale accelerometer range setting
+ * @see MPU6050_setFullScaleAccelRange()
+ */
+void MPU6050_DevSetFullScaleAccelRange(mpu6050_t *dev, uint8_t range) {
+	I2C_writeBits(dev->address, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_AFS_SEL_BIT, MPU6050_ACONFIG_AFS_SEL_LENGTH, range);
+}
+
+/** Set gyroscope sample rate divider of one device.
+ * @param dev Device context
+ * @param rate New sample rate divider
+ * @see MPU6050_setRate()
+ */
+void MPU6050_DevSetRate(mpu6050_t *dev, uint8_t rate) {
+	I2C_writeByte(dev->address, MPU6050_RA_SMPLRT_DIV, rate);
+}
+
+/** Set digital low-pass filter configuration of one device.
+ * @param dev Device context
+ * @param mode New DLFP configuration setting
+ * @see MPU6050_setDLPFMode()
+ */
+void MPU6050_DevSetDLPFMode(mpu6050_t *dev, uint8_t mode) {
+	I2C_writeBits(dev->address, MPU6050_RA_CONFIG, MPU6050_CFG_DLPF_CFG_BIT, MPU6050_CFG_DLPF_CFG_LENGTH, mode);
+}
+
+/** Get raw accel, temperature and gyro readings of one device.
+ * All 14 bytes (registers 59 to 72) are fetched in one burst into the
+ * device's own scratch buffer.
+ * @param dev Device context
+ * @param motion Container for the sample
+ * @return Status of read operation (true = success)
+ */
+bool MPU6050_DevGetMotion(mpu6050_t *dev, mpu6050_motion_t *motion) {
+	uint8_t *b = dev->buffer;
+	if (!MPU6050_DevReadRegister(dev, MPU6050_RA_ACCEL_XOUT_H, b, MPU6050_MOTION_BYTES)) {
+		return false;
+	}
+	MPU6050_ParseMotion(b, motion);
+	return true;
+}
+
+// Auxiliary I2C master
+
+/** Enable or disable the auxiliary bus pass-through of one device.
+ * While enabled, the external sensors appear directly on the host bus and
+ * the MPU6050's own I2C master is turned off.
+ * @param dev Device context
+ * @param enabled true: host talks to external sensors, false: MPU6050 master owns the aux bus
+ */
+void MPU6050_DevAuxBypass(mpu6050_t *dev, bool enabled) {
+	if (enabled) {
+		I2C_writeBit(dev->address, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_I2C_MST_EN_BIT, false);
+	}
+	I2C_writeBit(dev->address, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_I2C_BYPASS_EN_BIT, enabled);
+}
+
+/** Attach an external sensor to one of the slave 0-3 channels.
+ * The sensor's init sequence is written through the pass-through, then the
+ * slave channel is programmed to read data_len bytes from data_reg on every
+ * sample. Slaves must be attached in order, since their data is stored
+ * back to back in EXT_SENS_DATA.
+ * @param dev Device context
+ * @param slave Slave channel (0-3)
+ * @param sensor External sensor description
+ * @return true if the channel was configured
+ */
+bool MPU6050_DevAuxAttach(mpu6050_t *dev, uint8_t slave, const mpu6050_aux_sensor_t *sensor) {
+	uint8_t ctrl, ext_len = 0;
+
+	if ((slave >= MPU6050_AUX_SLAVES) || (sensor->data_len == 0) || (sensor->data_len > 15)) {
+		return false;
+	}
+	for (uint8_t i = 0; i < MPU6050_AUX_SLAVES; i++) {
+		ext_len += (i == slave) ? sensor->data_len : dev->aux_len[i];
+	}
+	if (ext_len > MPU6050_EXT_SENS_BYTES) {
+		return false;
+	}
+
+	MPU6050_DevAuxBypass(dev, true);
+	for (uint8_t i = 0; i < sensor->init_len; i++) {
+		I2C_writeByte(sensor->address, sensor->init[2 * i], sensor->init[2 * i + 1]);
+	}
+	MPU6050_DevAuxBypass(dev, false);
+
+	ctrl = (1 << MPU6050_I2C_SLV_EN_BIT) | sensor->data_len;
+	if (sensor->byte_swap) {
+		ctrl |= (1 << MPU6050_I2C_SLV_BYTE_SW_BIT);
+		if (sensor->data_reg & 0x01) {
+			ctrl |= (1 << MPU6050_I2C_SLV_GRP_BIT);
+		}
+	}
+	I2C_writeByte(dev->address, MPU6050_RA_I2C_SLV0_ADDR + slave * 3, (1 << MPU6050_I2C_SLV_RW_BIT) | sensor->address);
+	I2C_writeByte(dev->address, MPU6050_RA_I2C_SLV0_REG + slave * 3, sensor->data_reg);
+	I2C_writeByte(dev->address, MPU6050_RA_I2C_SLV0_CTRL + slave * 3, ctrl);
+
+	dev->aux_len[slave] = sensor->data_len;
+	dev->ext_len = ext_len;
+	return true;
+}
+
+/** Start the auxiliary I2C master.
+ * Data ready is held until all external sensors have been read and their
+ * data is shadowed, so every frame is sample aligned. When fifo is true the
+ * accel, temperature, gyro and attached slave data are also pushed to the
+ * FIFO in the same layout as a register burst.
+ * @param dev Device context
+ * @param fifo true to stream frames through the FIFO
+ * @return Frame length in bytes (14 + external sensor bytes)
+ */
+uint8_t MPU6050_DevAuxStart(mpu6050_t *dev, bool fifo) {
+	uint8_t mst_ctrl = (1 << MPU6050_WAIT_FOR_ES_BIT) | MPU6050_CLOCK_DIV_400;
+	uint8_t fifo_en = 0;
+
+	if (fifo) {
+		fifo_en = (1 << MPU6050_TEMP_FIFO_EN_BIT) | (1 << MPU6050_XG_FIFO_EN_BIT) | (1 << MPU6050_YG_FIFO_EN_BIT) |
+				  (1 << MPU6050_ZG_FIFO_EN_BIT) | (1 << MPU6050_ACCEL_FIFO_EN_BIT);
+		if (dev->aux_len[0]) fifo_en |= (1 << MPU6050_SLV0_FIFO_EN_BIT);
+		if (dev->aux_len[1]) fifo_en |= (1 << MPU6050_SLV1_FIFO_EN_BIT);
+		if (dev->aux_len[2]) fifo_en |= (1 << MPU6050_SLV2_FIFO_EN_BIT);
+		if (dev->aux_len[3]) mst_ctrl |= (1 << MPU6050_SLV_3_FIFO_EN_BIT);
+	}
+	I2C_writeByte(dev->address, MPU6050_RA_I2C_MST_CTRL, mst_ctrl);
+	I2C_writeByte(dev->address, MPU6050_RA_I2C_MST_DELAY_CTRL, (1 << MPU6050_DELAYCTRL_DELAY_ES_SHADOW_BIT));
+	I2C_writeByte(dev->address, MPU6050_RA_FIFO_EN, fifo_en);
+	I2C_writeBit(dev->address, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_I2C_BYPASS_EN_BIT, false);
+	I2C_writeByte(dev->address, MPU6050_RA_USER_CTRL, (1 << MPU6050_USERCTRL_I2C_MST_EN_BIT) |
+				  (fifo ? ((1 << MPU6050_USERCTRL_FIFO_EN_BIT) | (1 << MPU6050_USERCTRL_FIFO_RESET_BIT)) : 0));
+
+	return MPU6050_MOTION_BYTES + dev->ext_len;
+}
+
+/** Get a synchronized accel/gyro + external sensor frame from the registers.
+ * EXT_SENS_DATA directly follows GYRO_ZOUT_L, so the whole frame is read in
+ * one burst.
+ * @param dev Device context
+ * @param motion Container for the accel/temperature/gyro sample
+ * @param ext Container for the external sensor bytes (dev->ext_len bytes, may be NULL)
+ * @return Status of read operation (true = success)
+ */
+bool MPU6050_DevGetFrame(mpu6050_t *dev, mpu6050_motion_t *motion, uint8_t *ext) {
+	uint8_t *b = dev->buffer;
+	if (!MPU6050_DevReadRegister(dev, MPU6050_RA_ACCEL_XOUT_H, b, MPU6050_MOTION_BYTES + dev->ext_len)) {
+		return false;
+	}
+	MPU6050_ParseMotion(b, motion);
+	if (ext != NULL) {
+		memcpy(ext, &b[MPU6050_MOTION_BYTES], dev->ext_len);
+	}
+	return true;
+}
+
+/** Pop one synchronized frame from the FIFO.
+ * Requires MPU6050_DevAuxStart() with fifo enabled.
+ * @param dev Device context
+ * @param motion Container for the accel/temperature/gyro sample
+ * @param ext Container for the external sensor bytes (dev->ext_len bytes, may be NULL)
+ * @return true if a complete frame was read, false if the FIFO holds less than one frame
+ */
+bool MPU6050_DevGetFifoFrame(mpu6050_t *dev, mpu6050_motion_t *motion, uint8_t *ext) {
+	uint8_t *b = dev->buffer;
+	uint8_t frame_len = MPU6050_MOTION_BYTES + dev->ext_len;
+	if (!MPU6050_DevReadRegister(dev, MPU6050_RA_FIFO_COUNTH, b, 2)) {
+		return false;
+	}
+	if ((((uint16_t)b[0] << 8) | b[1]) < frame_len) {
+		return false;
+	}
+	if (!MPU6050_DevReadRegister(dev, MPU6050_RA_FIFO_R_W, b, frame_len)) {
+		return false;
+	}
+	MPU6050_ParseMotion(b, motion);
+	if (ext != NULL) {
+		memcpy(ext, &b[MPU6050_MOTION_BYTES], dev->ext_len);
+	}
+	return true;
+}
+
+// Round-robin sampler
+
+/** Prepare a sampler for a group of devices sharing the bus.
+ * @param sampler Sampler context
+ * @param devices Array of initialized device contexts
+ * @param qty Number of devices in the array
+ */
+void MPU6050_SamplerInit(mpu6050_sampler_t *sampler, mpu6050_t **devices, uint8_t qty) {
+	sampler->devices = devices;
+	sampler->qty = qty;
+	sampler->next = 0;
+}
+
+/** Read the next device in round-robin order.
+ * Successive calls spread the bus load evenly across all devices.
+ * @param sampler Sampler context
+ * @param motion Container for the sample
+ * @return Index of the device that was read, or -1 on bus error or empty group
+ */
+int8_t MPU6050_SamplerNext(mpu6050_sampler_t *sampler, mpu6050_motion_t *motion) {
+	uint8_t idx = sampler->next;
+	if (sampler->qty == 0) {
+		return -1;
+	}
+	sampler->next = (idx + 1 < sampler->qty) ? idx + 1 : 0;
+	if (!MPU6050_DevGetMotion(sampler->devices[idx], motion)) {
+		return -1;
+	}
+	return idx;
+}
+
+/** Read every device of the group back to back.
+ * Bursts are issued one right after the other, so the time skew between
+ * devices is a single 14 byte transfer. The starting device rotates on each
+ * call, so no sensor is always sampled last.
+ * @param sampler Sampler context
+ * @param motions Array of qty containers, indexed like the device array
+ * @return Number of devices read successfully
+ */
+uint8_t MPU6050_SamplerReadAll(mpu6050_sampler_t *sampler, mpu6050_motion_t *motions) {
+	uint8_t ok = 0;
+	if (sampler->qty == 0) {
+		return 0;
+	}
+	for (uint8_t i = 0; i < sampler->qty; i++) {
+		int8_t idx = MPU6050_SamplerNext(sampler, &motions[sampler->next]);
+		if (idx >= 0) {
+			ok++;
+		}
+	}
+	sampler->next = (sampler->next + 1 < sampler->qty) ? sampler->next + 1 : 0;
+	return ok;
 }
 
 /*==================[end of file]============================================*/
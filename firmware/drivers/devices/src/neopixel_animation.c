@@ -0,0 +1,338 @@
+/**
+ * @file neopixel_animation.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#include "neopixel_animation.h"
+/*==================[macros and definitions]=================================*/
+#define CHUNK_PIXELS    16      /* Pixels computed before each write to the stripe */
+#define US_PER_SECOND   1000000
+/*==================[internal data declaration]==============================*/
+typedef struct {
+	neopixel_effect_t effect;	/* Configuration */
+	bool active;				/* Effect running */
+	bool redraw;				/* Draw the whole segment in the next frame */
+	uint32_t start;				/* Frame number when started */
+	uint16_t pos;				/* Rotation offset or chase position */
+	neopixel_color_t last;		/* Last color of solid, fade and breathe */
+} anim_layer_t;
+
+static anim_layer_t layers[NEOPIXEL_ANIM_LAYERS];
+static SemaphoreHandle_t anim_mutex = NULL;
+static TaskHandle_t anim_task = NULL;
+static uint16_t anim_fps = 1;
+static bool anim_run = true;
+static uint32_t anim_frame = 0;
+static neopixel_anim_stats_t anim_stats;
+static uint64_t anim_total_us = 0;
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static void IRAM_ATTR NeoPixelAnimTimerIsr(void *param){
+	BaseType_t task_woken = pdFALSE;
+	/* The timer_mcu alarm handler already asks for a context switch on exit */
+	vTaskNotifyGiveFromISR(anim_task, &task_woken);
+}
+
+/* Time since the effect started */
+static uint32_t NeoPixelAnimElapsed(const anim_layer_t *layer){
+	return ((uint64_t)(anim_frame - layer->start) * 1000) / anim_fps;
+}
+
+/* Colors of qty pixels of a rotating effect (rainbow, palette) from segment position k */
+static void NeoPixelAnimGradient(const anim_layer_t *layer, uint16_t k, uint16_t qty, neopixel_color_t *colors){
+	const neopixel_effect_t *e = &layer->effect;
+	/* A whole rainbow or palette is 1 << 32 in 16.16 fixed point, so the
+	 * rotation offset wraps around for free and no division is done per pixel */
+	uint32_t step = ((uint64_t)e->reps << 32) / e->length;
+	uint32_t start = e->upwards ? ((uint32_t)k - layer->pos) * step : ((uint32_t)k + layer->pos) * step;
+
+	if(e->type == NEOPIXEL_EFFECT_RAINBOW){
+		NeoPixelHSV2ColorArray(colors, qty, start, step, e->sat, e->val);
+	}else{
+		NeoPixelPaletteArray(e->palette, colors, qty, start, step);
+	}
+}
+
+/* Color of a pixel of the chase effect */
+static neopixel_color_t NeoPixelAnimChase(const anim_layer_t *layer, uint16_t pixel){
+	const neopixel_effect_t *e = &layer->effect;
+	uint16_t k;
+
+	k = (pixel - e->first + e->length - layer->pos) % e->length;
+	if(!e->upwards){
+		k = (e->length - 1 - (pixel - e->first) + e->length - layer->pos) % e->length;
+	}
+	return (k < e->size) ? e->color : e->background;
+}
+
+/* Draw pixels first to last of a layer (no overlap checks) */
+static void NeoPixelAnimDraw(const anim_layer_t *layer, uint16_t first, uint16_t last){
+	neopixel_color_t chunk[CHUNK_PIXELS];
+	uint16_t qty;
+
+	if(layer->effect.type == NEOPIXEL_EFFECT_SOLID || layer->effect.type == NEOPIXEL_EFFECT_FADE ||
+	   layer->effect.type == NEOPIXEL_EFFECT_BREATHE){
+		NeoPixelFill(first, last - first + 1, layer->last);
+		return;
+	}
+	while(first <= last){
+		qty = last - first + 1;
+		if(qty > CHUNK_PIXELS){
+			qty = CHUNK_PIXELS;
+		}
+		if(layer->effect.type == NEOPIXEL_EFFECT_CHASE){
+			for (uint16_t i = 0; i < qty; i++){
+				chunk[i] = NeoPixelAnimChase(layer, first + i);
+			}
+		}else{
+			NeoPixelAnimGradient(layer, first - layer->effect.first, qty, chunk);
+		}
+		NeoPixelSetRange(first, qty, chunk);
+		first += qty;
+	}
+}
+
+/* Draw pixels first to last of layer n, skipping pixels covered by layers above */
+static void NeoPixelAnimPaint(uint8_t n, uint8_t above, uint16_t first, uint16_t last){
+	uint16_t s_first, s_last;
+
+	for (uint8_t j = above; j < NEOPIXEL_ANIM_LAYERS; j++){
+		if(!layers[j].active){
+			continue;
+		}
+		s_first = layers[j].effect.first;
+		s_last = s_first + layers[j].effect.length - 1;
+		if(s_first > last || s_last < first){
+			continue;
+		}
+		if(s_first > first){
+			NeoPixelAnimPaint(n, j + 1, first, s_first - 1);
+		}
+		if(s_last < last){
+			NeoPixelAnimPaint(n, j + 1, s_last + 1, last);
+		}
+		return;
+	}
+	NeoPixelAnimDraw(&layers[n], first, last);
+}
+
+/* true if a layer above n covers part of its segment */
+static bool NeoPixelAnimCovered(uint8_t n){
+	uint16_t first = layers[n].effect.first;
+	uint16_t last = first + layers[n].effect.length - 1;
+
+	for (uint8_t j = n + 1; j < NEOPIXEL_ANIM_LAYERS; j++){
+		if(layers[j].active && layers[j].effect.first <= last &&
+		   layers[j].effect.first + layers[j].effect.length - 1 >= first){
+			return true;
+		}
+	}
+	return false;
+}
+
+/* Advance layer n one frame and write the pixels that changed */
+static void NeoPixelAnimStep(uint8_t n){
+	anim_layer_t *layer = &layers[n];
+	neopixel_effect_t *e = &layer->effect;
+	uint16_t first = e->first;
+	uint16_t last = first + e->length - 1;
+	uint32_t t = NeoPixelAnimElapsed(layer);
+	uint32_t phase;
+	uint16_t target, steps;
+	neopixel_color_t color;
+	uint16_t off, on;
+
+	switch(e->type){
+		case NEOPIXEL_EFFECT_RAINBOW:
+		case NEOPIXEL_EFFECT_PALETTE:
+			target = ((uint64_t)(t % e->period_ms) * e->length) / e->period_ms;
+			steps = (target + e->length - layer->pos) % e->length;
+			layer->pos = target;
+			if(layer->redraw || (steps && NeoPixelAnimCovered(n))){
+				NeoPixelAnimPaint(n, n + 1, first, last);
+			}else if(steps){
+				/* The gradient repeats over the segment: moving it is a rotation */
+				NeoPixelRotate(first, e->length, steps, e->upwards);
+			}
+			break;
+		case NEOPIXEL_EFFECT_CHASE:
+			target = ((uint64_t)(t % e->period_ms) * e->length) / e->period_ms;
+			steps = (target + e->length - layer->pos) % e->length;
+			if(layer->redraw || steps > e->size){
+				layer->pos = target;
+				NeoPixelAnimPaint(n, n + 1, first, last);
+				break;
+			}
+			/* Only the pixels leaving and entering the block change */
+			while(steps--){
+				layer->pos = (layer->pos + 1) % e->length;
+				off = (layer->pos + e->length - 1) % e->length;
+				on = (layer->pos + e->size - 1) % e->length;
+				if(!e->upwards){
+					off = e->length - 1 - off;
+					on = e->length - 1 - on;
+				}
+				NeoPixelAnimPaint(n, n + 1, first + off, first + off);
+				NeoPixelAnimPaint(n, n + 1, first + on, first + on);
+			}
+			break;
+		default:
+			if(e->type == NEOPIXEL_EFFECT_FADE){
+				color = (t >= e->period_ms) ? e->color :
+						NeoPixelBlend(e->background, e->color, ((uint64_t)t * 255) / e->period_ms);
+			}else if(e->type == NEOPIXEL_EFFECT_BREATHE){
+				phase = t % e->period_ms;
+				if(phase >= e->period_ms / 2){
+					phase = e->period_ms - phase;
+				}
+				color = NeoPixelBlend(0, e->color, ((uint64_t)phase * 510) / e->period_ms);
+			}else{
+				color = e->color;
+			}
+			/* One color for the whole segment, only written when it changes */
+			if(layer->redraw || color != layer->last){
+				layer->last = color;
+				NeoPixelAnimPaint(n, n + 1, first, last);
+			}
+			break;
+	}
+	layer->redraw = false;
+}
+
+static void NeoPixelAnimTask(void *param){
+	uint32_t ticks;
+	int64_t start;
+	uint32_t elapsed;
+
+	while(true){
+		ticks = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		if(!anim_run){
+			continue;
+		}
+		start = esp_timer_get_time();
+		xSemaphoreTake(anim_mutex, portMAX_DELAY);
+		anim_frame += ticks;
+		for (uint8_t n = 0; n < NEOPIXEL_ANIM_LAYERS; n++){
+			if(layers[n].active){
+				NeoPixelAnimStep(n);
+			}
+		}
+		xSemaphoreGive(anim_mutex);
+		NeoPixelShow();
+		elapsed = esp_timer_get_time() - start;
+		anim_stats.frames++;
+		anim_stats.missed += ticks - 1;
+		anim_stats.last_us = elapsed;
+		if(elapsed > anim_stats.max_us){
+			anim_stats.max_us = elapsed;
+		}
+		anim_total_us += elapsed;
+	}
+}
+
+/*==================[external functions definition]==========================*/
+
+void NeoPixelAnimInit(timer_mcu_t timer, uint16_t fps){
+	timer_config_t timer_anim = {
+		.timer = timer,
+		.period = US_PER_SECOND / (fps ? fps : 1),
+		.func_p = NeoPixelAnimTimerIsr,
+		.param_p = NULL
+	};
+
+	if(anim_task != NULL){
+		return;
+	}
+	anim_fps = fps ? fps : 1;
+	anim_mutex = xSemaphoreCreateMutex();
+	memset(layers, 0, sizeof(layers));
+	NeoPixelShowMode(NEOPIXEL_SHOW_MANUAL, 0);
+	xTaskCreate(NeoPixelAnimTask, "neopixel_anim", 3072, NULL, 5, &anim_task);
+	TimerInit(&timer_anim);
+	TimerStart(timer);
+}
+
+bool NeoPixelAnimStart(uint8_t layer, const neopixel_effect_t *effect){
+	anim_layer_t *l;
+	uint16_t length = NeoPixelLength();
+
+	if(anim_mutex == NULL || layer >= NEOPIXEL_ANIM_LAYERS || effect->first >= length){
+		return false;
+	}
+	if(effect->period_ms == 0 && effect->type != NEOPIXEL_EFFECT_SOLID){
+		return false;
+	}
+	if(effect->type == NEOPIXEL_EFFECT_PALETTE && effect->palette == NULL){
+		return false;
+	}
+	xSemaphoreTake(anim_mutex, portMAX_DELAY);
+	l = &layers[layer];
+	l->effect = *effect;
+	if(l->effect.length == 0 || l->effect.length > length - l->effect.first){
+		l->effect.length = length - l->effect.first;
+	}
+	if(l->effect.reps == 0){
+		l->effect.reps = 1;
+	}
+	if(l->effect.type == NEOPIXEL_EFFECT_CHASE && l->effect.size == 0){
+		l->effect.size = 1;
+	}
+	l->start = anim_frame;
+	l->pos = 0;
+	l->last = 0;
+	l->redraw = true;
+	l->active = true;
+	xSemaphoreGive(anim_mutex);
+	return true;
+}
+
+void NeoPixelAnimStop(uint8_t layer){
+	uint16_t first, last;
+
+	if(anim_mutex == NULL || layer >= NEOPIXEL_ANIM_LAYERS){
+		return;
+	}
+	xSemaphoreTake(anim_mutex, portMAX_DELAY);
+	if(layers[layer].active){
+		layers[layer].active = false;
+		first = layers[layer].effect.first;
+		last = first + layers[layer].effect.length - 1;
+		NeoPixelFill(first, last - first + 1, 0);
+		/* Other layers on the freed pixels draw them again in the next frame */
+		for (uint8_t j = 0; j < NEOPIXEL_ANIM_LAYERS; j++){
+			if(layers[j].active && layers[j].effect.first <= last &&
+			   layers[j].effect.first + layers[j].effect.length - 1 >= first){
+				layers[j].redraw = true;
+			}
+		}
+	}
+	xSemaphoreGive(anim_mutex);
+}
+
+void NeoPixelAnimRun(bool run){
+	anim_run = run;
+}
+
+void NeoPixelAnimGetStats(neopixel_anim_stats_t *stats){
+	*stats = anim_stats;
+	stats->avg_us = anim_stats.frames ? anim_total_us / anim_stats.frames : 0;
+}
+
+/*==================[end of file]============================================*/
@@ -10,6 +10,11 @@
  */
 
 /*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
 #include "neopixel_stripe.h"
 #include "ws2812b.h"
 /*==================[macros and definitions]=================================*/
@@ -21,10 +26,25 @@
 #define BLUE_OFFSET     0
 #define MAX_BRIGHT  	255
 #define BRIGHT_OFFSET   8
+#define FRAME_BUFFERS   2		/* One buffer is encoded while the other is sent */
 /*==================[internal data declaration]==============================*/
 uint16_t stripe_length;
 uint8_t stripe_bright = MAX_BRIGHT;
-neopixel_color_t *stripe_colors; 
+neopixel_color_t *stripe_colors;						/* Back buffer, edited by the application */
+static uint8_t level_lut[256];							/* Color level with brightness and gamma applied */
+static uint8_t *stripe_frame[FRAME_BUFFERS];			/* Front buffers, G, R, B bytes sent by the RMT */
+static uint16_t dirty_first[FRAME_BUFFERS];				/* First pixel to encode again in each front buffer */
+static uint16_t dirty_last[FRAME_BUFFERS];				/* Last pixel to encode again (first > last: clean) */
+static uint8_t frame_next = 0;							/* Front buffer used by the next frame */
+static bool stripe_changed = false;						/* Back buffer changed since the last frame */
+static neopixel_show_t show_mode = NEOPIXEL_SHOW_IMMEDIATE;
+static TickType_t show_period = 1;
+static TaskHandle_t show_task = NULL;
+static SemaphoreHandle_t stripe_mutex = NULL;			/* Protects back buffer and dirty ranges */
+static SemaphoreHandle_t frame_free = NULL;				/* Front buffers not being sent */
+static uint8_t *parallel_frame[WS2812B_MAX_STRIPS];		/* Encoded frame of each parallel stripe */
+static uint32_t parallel_size[WS2812B_MAX_STRIPS];		/* Size of each parallel_frame */
+static uint8_t parallel_qty = 0;						/* Number of parallel stripes */
 /*==================[internal functions declaration]=========================*/
 
 /*==================[internal data definition]===============================*/
@@ -32,90 +52,413 @@ neopixel_color_t *stripe_colors;
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+static void IRAM_ATTR NeoPixelSentIsr(void *param){
+	BaseType_t task_woken = pdFALSE;
+	xSemaphoreGiveFromISR(frame_free, &task_woken);
+	portYIELD_FROM_ISR(task_woken);
+}
+
+/* hue: 0 to 1530, s1 and v1: 1 to 256, s2: 255 - sat */
+static inline neopixel_color_t NeoPixelHue2Color(uint16_t hue, uint16_t s1, uint8_t s2, uint32_t v1){
+
+  uint8_t r, g, b;
+
+  // Convert hue to R,G,B (nested ifs faster than divide+mod+switch):
+  if (hue < 510) { // Red to Green-1
+    b = 0;
+    if (hue < 255) { //   Red to Yellow-1
+      r = 255;
+      g = hue;       //     g = 0 to 254
+    } else {         //   Yellow to Green-1
+      r = 510 - hue; //     r = 255 to 1
+      g = 255;
+    }
+  } else if (hue < 1020) { // Green to Blue-1
+    r = 0;
+    if (hue < 765) { //   Green to Cyan-1
+      g = 255;
+      b = hue - 510;  //     b = 0 to 254
+    } else {          //   Cyan to Blue-1
+      g = 1020 - hue; //     g = 255 to 1
+      b = 255;
+    }
+  } else if (hue < 1530) { // Blue to Red-1
+    g = 0;
+    if (hue < 1275) { //   Blue to Magenta-1
+      r = hue - 1020; //     r = 0 to 254
+      b = 255;
+    } else { //   Magenta to Red-1
+      r = 255;
+      b = 1530 - hue; //     b = 255 to 1
+    }
+  } else { // Last 0.5 Red (quicker than % operator)
+    r = 255;
+    g = b = 0;
+  }
+
+  // Apply saturation and value to R,G,B, pack into 32-bit result:
+  return ((((((r * s1) >> 8) + s2) * v1) & 0xff00) << 8) |
+         (((((g * s1) >> 8) + s2) * v1) & 0xff00) |
+         (((((b * s1) >> 8) + s2) * v1) >> 8);
+}
+
+/* Mark pixels first to last as changed in every front buffer */
+static void NeoPixelMark(uint16_t first, uint16_t last){
+	for (uint8_t i = 0; i < FRAME_BUFFERS; i++){
+		if(dirty_first[i] > dirty_last[i]){
+			dirty_first[i] = first;
+			dirty_last[i] = last;
+		}else{
+			if(first < dirty_first[i]){
+				dirty_first[i] = first;
+			}
+			if(last > dirty_last[i]){
+				dirty_last[i] = last;
+			}
+		}
+	}
+	stripe_changed = true;
+}
+
+/* Combined brightness and gamma correction of a color level */
+static void NeoPixelBuildLut(void){
+	for (uint16_t i = 0; i < 256; i++){
+		level_lut[i] = ws2812bGammaCorrection((i * stripe_bright) >> BRIGHT_OFFSET);
+	}
+}
+
+static inline void NeoPixelEncodePixel(uint8_t *frame, neopixel_color_t color){
+	frame[0] = level_lut[(color >> GREEN_OFFSET) & 0xFF];
+	frame[1] = level_lut[(color >> RED_OFFSET) & 0xFF];
+	frame[2] = level_lut[(color >> BLUE_OFFSET) & 0xFF];
+}
+
+static void NeoPixelEncode(uint8_t *frame, uint16_t first, uint16_t last){
+	const neopixel_color_t *color = &stripe_colors[first];
+	uint32_t *word;
+	uint32_t g, r, b;
+	uint16_t i = first;
+
+	/* Single pixels until the output is word aligned (pixel multiple of 4) */
+	for (; i <= last && (i & 3); i++){
+		NeoPixelEncodePixel(&frame[3 * i], *color++);
+	}
+	/* 4 pixels = 12 bytes = 3 words (little endian: G0 R0 B0 G1 | R1 B1 G2 R2 | B2 G3 R3 B3) */
+	word = (uint32_t *)&frame[3 * i];
+	for (; i + 3 <= last; i += 4){
+		g = level_lut[(color[0] >> GREEN_OFFSET) & 0xFF];
+		r = level_lut[(color[0] >> RED_OFFSET) & 0xFF];
+		b = level_lut[(color[0] >> BLUE_OFFSET) & 0xFF];
+		word[0] = g | (r << 8) | (b << 16) | ((uint32_t)level_lut[(color[1] >> GREEN_OFFSET) & 0xFF] << 24);
+		r = level_lut[(color[1] >> RED_OFFSET) & 0xFF];
+		b = level_lut[(color[1] >> BLUE_OFFSET) & 0xFF];
+		g = level_lut[(color[2] >> GREEN_OFFSET) & 0xFF];
+		word[1] = r | (b << 8) | (g << 16) | ((uint32_t)level_lut[(color[2] >> RED_OFFSET) & 0xFF] << 24);
+		b = level_lut[(color[2] >> BLUE_OFFSET) & 0xFF];
+		g = level_lut[(color[3] >> GREEN_OFFSET) & 0xFF];
+		r = level_lut[(color[3] >> RED_OFFSET) & 0xFF];
+		word[2] = b | (g << 8) | (r << 16) | ((uint32_t)level_lut[(color[3] >> BLUE_OFFSET) & 0xFF] << 24);
+		word += 3;
+		color += 4;
+	}
+	for (; i <= last; i++){
+		NeoPixelEncodePixel(&frame[3 * i], *color++);
+	}
+}
+
+/* Called after every change of the back buffer */
+static void NeoPixelUpdate(void){
+	if(show_mode == NEOPIXEL_SHOW_IMMEDIATE){
+		NeoPixelShow();
+	}
+}
+
+static void NeoPixelShowTask(void *param){
+	TickType_t last_wake = xTaskGetTickCount();
+	while(true){
+		vTaskDelayUntil(&last_wake, show_period);
+		if(show_mode == NEOPIXEL_SHOW_AUTO){
+			NeoPixelShow();
+		}
+	}
+}
 
 /*==================[external functions definition]==========================*/
 
 void NeoPixelInit(gpio_t pin, uint16_t len, neopixel_color_t *color_array){
+	if(stripe_mutex == NULL){
+		stripe_mutex = xSemaphoreCreateMutex();
+		frame_free = xSemaphoreCreateCounting(FRAME_BUFFERS, FRAME_BUFFERS);
+		NeoPixelBuildLut();
+	}
+    ws2812bInit(pin);
+	ws2812bSetCallback(NeoPixelSentIsr, NULL);
+	ws2812bWait(-1);
+	xSemaphoreTake(stripe_mutex, portMAX_DELAY);
     stripe_length = len;
 	stripe_colors = color_array;
-    ws2812bInit(pin);
+	for (uint8_t i = 0; i < FRAME_BUFFERS; i++){
+		free(stripe_frame[i]);
+		stripe_frame[i] = calloc(len, 3);
+		dirty_first[i] = 1;
+		dirty_last[i] = 0;
+	}
+	NeoPixelMark(0, len - 1);
+	stripe_changed = false;
+	xSemaphoreGive(stripe_mutex);
+}
+
+void NeoPixelShow(void){
+	uint8_t *frame;
+	uint8_t idx;
+	if(stripe_length == 0 || stripe_frame[frame_next] == NULL){
+		return;
+	}
+	xSemaphoreTake(stripe_mutex, portMAX_DELAY);
+	if(!stripe_changed){
+		xSemaphoreGive(stripe_mutex);
+		return;
+	}
+	/* Wait until the RMT is done with this buffer (frames end in order) */
+	xSemaphoreTake(frame_free, portMAX_DELAY);
+	idx = frame_next;
+	frame = stripe_frame[idx];
+	if(dirty_first[idx] <= dirty_last[idx]){
+		NeoPixelEncode(frame, dirty_first[idx], dirty_last[idx]);
+		dirty_first[idx] = 1;
+		dirty_last[idx] = 0;
+	}
+	stripe_changed = false;
+	frame_next = (idx + 1) % FRAME_BUFFERS;
+	if(ws2812bTransmit(frame, 3 * stripe_length) != ESP_OK){
+		xSemaphoreGive(frame_free);
+	}
+	xSemaphoreGive(stripe_mutex);
+}
+
+void NeoPixelShowMode(neopixel_show_t mode, uint16_t fps){
+	if(mode == NEOPIXEL_SHOW_AUTO){
+		show_period = (fps == 0) ? 1 : pdMS_TO_TICKS(1000 / fps);
+		if(show_period == 0){
+			show_period = 1;
+		}
+		if(show_task == NULL){
+			xTaskCreate(NeoPixelShowTask, "neopixel_show", 2048, NULL, 5, &show_task);
+		}
+	}
+	show_mode = mode;
+	if(mode == NEOPIXEL_SHOW_IMMEDIATE){
+		NeoPixelShow();
+	}
 }
 
 void NeoPixelAllOff(void){
-    rgb_led_t led;
-	ws2812bSendRet();
-	ws2812bSendRet();
-	ws2812bSendRet();
-	for (uint16_t i = 0; i < stripe_length; i++){
-		led.red = 0;
-		led.green = 0;
-		led.blue = 0;
-		ws2812bSend(led);
+	uint8_t idx;
+	if(stripe_length == 0 || stripe_frame[frame_next] == NULL){
+		return;
+	}
+	/* Send a black frame without touching the back buffer */
+	xSemaphoreTake(stripe_mutex, portMAX_DELAY);
+	xSemaphoreTake(frame_free, portMAX_DELAY);
+	idx = frame_next;
+	memset(stripe_frame[idx], 0, 3 * stripe_length);
+	dirty_first[idx] = 0;
+	dirty_last[idx] = stripe_length - 1;
+	frame_next = (idx + 1) % FRAME_BUFFERS;
+	if(ws2812bTransmit(stripe_frame[idx], 3 * stripe_length) != ESP_OK){
+		xSemaphoreGive(frame_free);
 	}
-	ws2812bSendRet();
+	xSemaphoreGive(stripe_mutex);
 }
 
 void NeoPixelAllColor(neopixel_color_t color){
+	xSemaphoreTake(stripe_mutex, portMAX_DELAY);
 	for (uint16_t i = 0; i < stripe_length; i++){
 		stripe_colors[i] = color;
 	}
-	NeoPixelSetArray(stripe_colors);
+	NeoPixelMark(0, stripe_length - 1);
+	xSemaphoreGive(stripe_mutex);
+	NeoPixelUpdate();
 }
 
 void NeoPixelSetPixel(uint16_t pixel, neopixel_color_t color){
-	stripe_colors[pixel] = color;
-	NeoPixelSetArray(stripe_colors);
+	if(pixel >= stripe_length){
+		return;
+	}
+	xSemaphoreTake(stripe_mutex, portMAX_DELAY);
+	if(stripe_colors[pixel] != color){
+		stripe_colors[pixel] = color;
+		NeoPixelMark(pixel, pixel);
+	}
+	xSemaphoreGive(stripe_mutex);
+	NeoPixelUpdate();
+}
+
+void NeoPixelFill(uint16_t first, uint16_t qty, neopixel_color_t color){
+	if(first >= stripe_length || qty == 0){
+		return;
+	}
+	if(qty > stripe_length - first){
+		qty = stripe_length - first;
+	}
+	xSemaphoreTake(stripe_mutex, portMAX_DELAY);
+	for (uint16_t i = first; i < first + qty; i++){
+		stripe_colors[i] = color;
+	}
+	NeoPixelMark(first, first + qty - 1);
+	xSemaphoreGive(stripe_mutex);
+	NeoPixelUpdate();
+}
+
+void NeoPixelSetRange(uint16_t first, uint16_t qty, const neopixel_color_t *colors){
+	if(first >= stripe_length || qty == 0){
+		return;
+	}
+	if(qty > stripe_length - first){
+		qty = stripe_length - first;
+	}
+	xSemaphoreTake(stripe_mutex, portMAX_DELAY);
+	memcpy(&stripe_colors[first], colors, qty * sizeof(neopixel_color_t));
+	NeoPixelMark(first, first + qty - 1);
+	xSemaphoreGive(stripe_mutex);
+	NeoPixelUpdate();
+}
+
+/* Reverse colors first to last */
+static void NeoPixelReverse(uint16_t first, uint16_t last){
+	neopixel_color_t aux;
+	while(first < last){
+		aux = stripe_colors[first];
+		stripe_colors[first++] = stripe_colors[last];
+		stripe_colors[last--] = aux;
+	}
+}
+
+void NeoPixelRotate(uint16_t first, uint16_t qty, uint16_t steps, bool upwards){
+	uint16_t last;
+	if(first >= stripe_length || qty < 2){
+		return;
+	}
+	if(qty > stripe_length - first){
+		qty = stripe_length - first;
+	}
+	steps %= qty;
+	if(steps == 0){
+		return;
+	}
+	if(!upwards){
+		steps = qty - steps;
+	}
+	last = first + qty - 1;
+	/* Rotation by three reversals, no extra memory */
+	xSemaphoreTake(stripe_mutex, portMAX_DELAY);
+	NeoPixelReverse(first, last);
+	NeoPixelReverse(first, first + steps - 1);
+	NeoPixelReverse(first + steps, last);
+	NeoPixelMark(first, last);
+	xSemaphoreGive(stripe_mutex);
+	NeoPixelUpdate();
+}
+
+bool NeoPixelParallelInit(gpio_t *pins, uint8_t qty){
+	if(qty > WS2812B_MAX_STRIPS){
+		qty = WS2812B_MAX_STRIPS;
+	}
+	NeoPixelBuildLut();
+	if(!ws2812bParallelInit(pins, qty)){
+		return false;
+	}
+	parallel_qty = qty;
+	return true;
+}
+
+void NeoPixelParallelShow(neopixel_color_t *const color_arrays[], const uint16_t len[]){
+	const uint8_t *frames[WS2812B_MAX_STRIPS];
+	uint32_t frame_len[WS2812B_MAX_STRIPS];
+	uint8_t *aux;
+
+	for (uint8_t s = 0; s < parallel_qty; s++){
+		frame_len[s] = 3 * len[s];
+		if(frame_len[s] > parallel_size[s]){
+			aux = realloc(parallel_frame[s], frame_len[s]);
+			if(aux == NULL){
+				return;
+			}
+			parallel_frame[s] = aux;
+			parallel_size[s] = frame_len[s];
+		}
+		for (uint16_t i = 0; i < len[s]; i++){
+			NeoPixelEncodePixel(&parallel_frame[s][3 * i], color_arrays[s][i]);
+		}
+		frames[s] = parallel_frame[s];
+	}
+	ws2812bParallelTransmit(frames, frame_len);
+}
+
+uint16_t NeoPixelLength(void){
+	return stripe_length;
+}
+
+neopixel_color_t NeoPixelGetPixel(uint16_t pixel){
+	if(pixel >= stripe_length){
+		return 0;
+	}
+	return stripe_colors[pixel];
 }
 
 void NeoPixelSetArray(neopixel_color_t *color_array){
-    rgb_led_t led;
-	uint16_t red, green, blue;
-	ws2812bSendRet();
-	ws2812bSendRet();
-	ws2812bSendRet();
-	for (uint16_t i = 0; i < stripe_length; i++){
-		red = ((color_array[i] & RED_MSK) >> RED_OFFSET) * stripe_bright;
-		green = ((color_array[i] & GREEN_MSK) >> GREEN_OFFSET) * stripe_bright;
-		blue = ((color_array[i] & BLUE_MSK) >> BLUE_OFFSET) * stripe_bright;
-		led.red = red >> BRIGHT_OFFSET;
-		led.green = green >> BRIGHT_OFFSET;
-		led.blue = blue >> BRIGHT_OFFSET;
-		ws2812bSend(led);
+	xSemaphoreTake(stripe_mutex, portMAX_DELAY);
+	if(color_array != stripe_colors){
+		memcpy(stripe_colors, color_array, stripe_length * sizeof(neopixel_color_t));
 	}
-	ws2812bSendRet();
+	/* The application may have written the back buffer directly */
+	NeoPixelMark(0, stripe_length - 1);
+	xSemaphoreGive(stripe_mutex);
+	NeoPixelUpdate();
 }
 
 void NeoPixelShift(bool upwards){
 	neopixel_color_t carry;
 
+	if(stripe_length == 0){
+		return;
+	}
+	xSemaphoreTake(stripe_mutex, portMAX_DELAY);
 	if(upwards){
 		carry = stripe_colors[stripe_length-1];
-		for (uint16_t i = 0; i < stripe_length-1; i++){
-			stripe_colors[stripe_length-1-i] = stripe_colors[stripe_length-2-i]; 
-		}
+		memmove(&stripe_colors[1], &stripe_colors[0], (stripe_length-1) * sizeof(neopixel_color_t));
 		stripe_colors[0] = carry;
 	}else{
 		carry = stripe_colors[0];
-		for (uint16_t i = 0; i < stripe_length-1; i++){
-			stripe_colors[i] = stripe_colors[i+1]; 
-		}
+		memmove(&stripe_colors[0], &stripe_colors[1], (stripe_length-1) * sizeof(neopixel_color_t));
 		stripe_colors[stripe_length-1] = carry;
 	}
-	NeoPixelSetArray(stripe_colors);
+	NeoPixelMark(0, stripe_length - 1);
+	xSemaphoreGive(stripe_mutex);
+	NeoPixelUpdate();
 }
 
 void NeoPixelBrightness(uint8_t bright){
-	stripe_bright = bright;
-	NeoPixelSetArray(stripe_colors);
+	xSemaphoreTake(stripe_mutex, portMAX_DELAY);
+	if(bright != stripe_bright){
+		stripe_bright = bright;
+		NeoPixelBuildLut();
+		NeoPixelMark(0, stripe_length - 1);
+	}
+	xSemaphoreGive(stripe_mutex);
+	NeoPixelUpdate();
 }
 
 void NeoPixelRainbow(uint16_t first_hue, uint8_t sat, uint8_t val, uint8_t reps){
-	for (uint16_t i=0; i<stripe_length; i++) {
-		uint16_t hue = first_hue + (i * reps * 65536) / stripe_length;
-		neopixel_color_t color = NeoPixelHSV2Color(hue, sat, val);
-		stripe_colors[i] = color;
-  	}
-	NeoPixelSetArray(stripe_colors);
+	if(stripe_length == 0){
+		return;
+	}
+	xSemaphoreTake(stripe_mutex, portMAX_DELAY);
+	NeoPixelHSV2ColorArray(stripe_colors, stripe_length, (uint32_t)first_hue << 16,
+						   ((uint64_t)reps << 32) / stripe_length, sat, val);
+	NeoPixelMark(0, stripe_length - 1);
+	xSemaphoreGive(stripe_mutex);
+	NeoPixelUpdate();
 }
 
 neopixel_color_t NeoPixelRgb2Color(uint8_t red, uint8_t green, uint8_t blue){
@@ -123,50 +466,51 @@ neopixel_color_t NeoPixelRgb2Color(uint8_t red, uint8_t green, uint8_t blue){
 }
 
 neopixel_color_t NeoPixelHSV2Color(uint16_t hue, uint8_t sat, uint8_t val){
+  /* 1 to 256 factors allow >>8 instead of /255 */
+  return NeoPixelHue2Color((hue * 1530UL + 32768) >> 16, 1 + sat, 255 - sat, 1 + val);
+}
 
-  uint8_t r, g, b;
+void NeoPixelHSV2ColorArray(neopixel_color_t *color_array, uint16_t qty, uint32_t first_hue,
+                            uint32_t hue_step, uint8_t sat, uint8_t val){
+  uint32_t hue = first_hue;
+  uint16_t s1 = 1 + sat;
+  uint8_t s2 = 255 - sat;
+  uint32_t v1 = 1 + val;
 
-  hue = (hue * 1530L + 32768) / 65536;
-  // Convert hue to R,G,B (nested ifs faster than divide+mod+switch):
-  if (hue < 510) { // Red to Green-1
-    b = 0;
-    if (hue < 255) { //   Red to Yellow-1
-      r = 255;
-      g = hue;       //     g = 0 to 254
-    } else {         //   Yellow to Green-1
-      r = 510 - hue; //     r = 255 to 1
-      g = 255;
-    }
-  } else if (hue < 1020) { // Green to Blue-1
-    r = 0;
-    if (hue < 765) { //   Green to Cyan-1
-      g = 255;
-      b = hue - 510;  //     b = 0 to 254
-    } else {          //   Cyan to Blue-1
-      g = 1020 - hue; //     g = 255 to 1
-      b = 255;
-    }
-  } else if (hue < 1530) { // Blue to Red-1
-    g = 0;
-    if (hue < 1275) { //   Blue to Magenta-1
-      r = hue - 1020; //     r = 0 to 254
-      b = 255;
-    } else { //   Magenta to Red-1
-      r = 255;
-      b = 1530 - hue; //     b = 255 to 1
-    }
-  } else { // Last 0.5 Red (quicker than % operator)
-    r = 255;
-    g = b = 0;
+  /* Hue in 16.16 fixed point: one multiply and shift per pixel, no divisions */
+  for (uint16_t i = 0; i < qty; i++){
+    color_array[i] = NeoPixelHue2Color(((hue >> 16) * 1530UL + 32768) >> 16, s1, s2, v1);
+    hue += hue_step;
   }
+}
 
-  // Apply saturation and value to R,G,B, pack into 32-bit result:
-  uint32_t v1 = 1 + val;  // 1 to 256; allows >>8 instead of /255
-  uint16_t s1 = 1 + sat;  // 1 to 256; same reason
-  uint8_t s2 = 255 - sat; // 255 to 0
-  return ((((((r * s1) >> 8) + s2) * v1) & 0xff00) << 8) |
-         (((((g * s1) >> 8) + s2) * v1) & 0xff00) |
-         (((((b * s1) >> 8) + s2) * v1) >> 8);
+neopixel_color_t NeoPixelBlend(neopixel_color_t c1, neopixel_color_t c2, uint8_t frac){
+  /* R and B mixed together, G apart (no overflow with 8 bits weights) */
+  uint32_t rb = ((c1 & 0xFF00FF) * (256 - frac) + (c2 & 0xFF00FF) * frac) >> 8;
+  uint32_t g = ((c1 & 0x00FF00) * (256 - frac) + (c2 & 0x00FF00) * frac) >> 8;
+  return (rb & 0xFF00FF) | (g & 0x00FF00);
+}
+
+neopixel_color_t NeoPixelPaletteColor(const neopixel_palette_t *palette, uint16_t index){
+  uint8_t entry = index >> 12;
+  uint8_t frac = (index >> 4) & 0xFF;
+  neopixel_color_t c1 = palette->colors[entry];
+
+  if(frac == 0){
+    return c1;
+  }
+  return NeoPixelBlend(c1, palette->colors[(entry + 1) & (NEOPIXEL_PALETTE_SIZE - 1)], frac);
+}
+
+void NeoPixelPaletteArray(const neopixel_palette_t *palette, neopixel_color_t *color_array,
+                          uint16_t qty, uint32_t first_index, uint32_t index_step){
+  uint32_t index = first_index;
+
+  /* Index in 16.16 fixed point, wraps around the palette */
+  for (uint16_t i = 0; i < qty; i++){
+    color_array[i] = NeoPixelPaletteColor(palette, index >> 16);
+    index += index_step;
+  }
 }
 
 /*==================[end of file]============================================*/
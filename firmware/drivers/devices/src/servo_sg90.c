@@ -6,10 +6,9 @@
 #define SERVO_FREQ 	50
 #define MIN_ANG		-90
 #define MAX_ANG		90
-#define ANG_RANGE	180.0
-#define PERIOD_MS   20.0
-#define PULSEW_MS   1.0
-#define PERCENT   	100.0
+#define ANG_RANGE	180
+#define PERIOD_US   20000
+#define PULSEW_US   1000
 /*==================[internal data declaration]==============================*/
 
 /*==================[internal functions declaration]=========================*/
@@ -19,14 +18,13 @@
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
-uint8_t Angle2DutyCicle(int8_t angle){
-	static float h_time;
-	static float duty_cicle;
-	static int16_t deg;
+/* High time in PWM timer ticks (max_ticks: ticks in a period) */
+uint32_t Angle2Ticks(int8_t angle, uint32_t max_ticks){
+	int16_t deg;
+	uint32_t h_time;
 	deg = 2 * angle + MAX_ANG;	// NOTE: adjusted (angle x 2) for the available servos
-	h_time = (float)(deg/ANG_RANGE) + PULSEW_MS;
-	duty_cicle = (float)(h_time/PERIOD_MS) * PERCENT;
-	return (uint8_t) duty_cicle;
+	h_time = deg * 1000 / ANG_RANGE + PULSEW_US;
+	return (h_time * max_ticks) / PERIOD_US;
 }
 /*==================[external functions definition]==========================*/
 
@@ -49,25 +47,23 @@ uint8_t ServoInit(servo_out_t servo, gpio_t gpio){
 }
 
 void ServoMove(servo_out_t servo, int8_t ang){
-	static uint8_t dc;
 	if(ang < MIN_ANG){
 		ang = MIN_ANG;
 	} else if(ang > MAX_ANG){
 		ang = MAX_ANG;
 	}
-	dc = Angle2DutyCicle(ang);
 	switch(servo){
 		case SERVO_0:
-			PWMSetDutyCycle(PWM_0, dc);
+			PWMSetDutyTicks(PWM_0, Angle2Ticks(ang, PWMGetMaxTicks(PWM_0)));
 			break;
 		case SERVO_1:
-			PWMSetDutyCycle(PWM_1, dc);
+			PWMSetDutyTicks(PWM_1, Angle2Ticks(ang, PWMGetMaxTicks(PWM_1)));
 			break;
 		case SERVO_2:
-			PWMSetDutyCycle(PWM_2, dc);
+			PWMSetDutyTicks(PWM_2, Angle2Ticks(ang, PWMGetMaxTicks(PWM_2)));
 			break;
 		case SERVO_3:
-			PWMSetDutyCycle(PWM_3, dc);
+			PWMSetDutyTicks(PWM_3, Angle2Ticks(ang, PWMGetMaxTicks(PWM_3)));
 			break;
 	}
 }
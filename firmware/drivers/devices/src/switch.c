@@ -37,9 +37,11 @@ int8_t SwitchesInit(void){
 
 int8_t SwitchesRead(void){
 	int8_t mask = 0;
-	if (!GPIORead(GPIO_SWITCH1))
+	/* Both switches are sampled at the same time */
+	uint32_t inputs = GPIOReadAll();
+	if (!(inputs & GPIO_MASK(GPIO_SWITCH1)))
 		  mask |= SWITCH_1;
-	if (!GPIORead(GPIO_SWITCH2))
+	if (!(inputs & GPIO_MASK(GPIO_SWITCH2)))
 		  mask |= SWITCH_2;
 	return mask;
 }
@@ -0,0 +1,186 @@
+/**
+ * @file telemetry.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include "telemetry.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+/*==================[macros and definitions]=================================*/
+#define RECORD_HEADER   3       /* id, type, qty */
+#define CRC_BYTES       2
+#define CRC_INIT        0xFFFF
+#define COBS_BYTES      (TELEMETRY_FRAME_BYTES + TELEMETRY_FRAME_BYTES / 254 + 2)
+/*==================[internal data declaration]==============================*/
+typedef struct {
+	bool declared;							/* Channel declared */
+	telemetry_type_t type;					/* Sample type */
+	uint8_t size;							/* Sample size in bytes */
+	uint8_t qty;							/* Stored samples */
+	uint8_t data[TELEMETRY_CHANNEL_BYTES];	/* Stored samples */
+} telemetry_channel_t;
+
+static uart_mcu_port_t telemetry_port;
+static telemetry_channel_t channels[TELEMETRY_MAX_CHANNELS];
+static uint8_t frame[TELEMETRY_FRAME_BYTES];
+static uint8_t encoded[COBS_BYTES];
+static uint8_t seq = 0;
+static telemetry_stats_t stats;
+static SemaphoreHandle_t telemetry_mutex = NULL;
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+static const uint8_t type_size[] = {1, 1, 2, 2, 4, 4, 4};
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/* CRC-16/CCITT-FALSE (poly 0x1021), byte at a time without table */
+static uint16_t TelemetryCrc(const uint8_t *data, uint16_t len){
+	uint16_t crc = CRC_INIT;
+	uint8_t x;
+	while(len--){
+		x = (crc >> 8) ^ *data++;
+		x ^= x >> 4;
+		crc = (crc << 8) ^ ((uint16_t)x << 12) ^ ((uint16_t)x << 5) ^ x;
+	}
+	return crc;
+}
+
+/* COBS encoding followed by the 0x00 delimiter, returns encoded length */
+static uint16_t TelemetryCobs(const uint8_t *in, uint16_t len, uint8_t *out){
+	uint16_t code_pos = 0;
+	uint16_t out_pos = 1;
+	uint8_t code = 1;
+
+	for(uint16_t i = 0; i < len; i++){
+		if(in[i] == 0){
+			out[code_pos] = code;
+			code_pos = out_pos++;
+			code = 1;
+		}else{
+			out[out_pos++] = in[i];
+			if(++code == 0xFF){
+				out[code_pos] = code;
+				code_pos = out_pos++;
+				code = 1;
+			}
+		}
+	}
+	out[code_pos] = code;
+	out[out_pos++] = 0;
+	return out_pos;
+}
+
+static void TelemetrySendFrame(uint16_t len){
+	uint16_t crc = TelemetryCrc(frame, len);
+	frame[len++] = crc & 0xFF;
+	frame[len++] = crc >> 8;
+	len = TelemetryCobs(frame, len, encoded);
+	UartSendBuffer(telemetry_port, (const char *)encoded, len);
+	stats.frames++;
+	stats.bytes += len;
+}
+
+/* Send every stored sample, called with the mutex taken */
+static void TelemetryFlushLocked(void){
+	uint16_t len = 0;
+	uint16_t bytes;
+	telemetry_channel_t *ch;
+
+	for(uint8_t id = 0; id < TELEMETRY_MAX_CHANNELS; id++){
+		ch = &channels[id];
+		if(ch->qty == 0){
+			continue;
+		}
+		bytes = ch->qty * ch->size;
+		if(len > 0 && len + RECORD_HEADER + bytes + CRC_BYTES > TELEMETRY_FRAME_BYTES){
+			TelemetrySendFrame(len);
+			len = 0;
+		}
+		if(len == 0){
+			frame[len++] = seq++;
+		}
+		frame[len++] = id;
+		frame[len++] = ch->type;
+		frame[len++] = ch->qty;
+		memcpy(&frame[len], ch->data, bytes);
+		len += bytes;
+		stats.samples += ch->qty;
+		ch->qty = 0;
+	}
+	if(len > 0){
+		TelemetrySendFrame(len);
+	}
+}
+/*==================[external functions definition]==========================*/
+
+void TelemetryInit(uart_mcu_port_t port){
+	telemetry_port = port;
+	if(telemetry_mutex == NULL){
+		telemetry_mutex = xSemaphoreCreateMutex();
+	}
+	memset(channels, 0, sizeof(channels));
+	memset(&stats, 0, sizeof(stats));
+}
+
+bool TelemetryChannel(uint8_t id, telemetry_type_t type){
+	if(id >= TELEMETRY_MAX_CHANNELS || type > TELEMETRY_FLOAT){
+		return false;
+	}
+	channels[id].declared = true;
+	channels[id].type = type;
+	channels[id].size = type_size[type];
+	channels[id].qty = 0;
+	return true;
+}
+
+bool TelemetryPush(uint8_t id, const void *samples, uint8_t qty){
+	telemetry_channel_t *ch;
+	const uint8_t *src = samples;
+	uint8_t n;
+
+	if(telemetry_mutex == NULL || id >= TELEMETRY_MAX_CHANNELS || !channels[id].declared){
+		return false;
+	}
+	ch = &channels[id];
+	xSemaphoreTake(telemetry_mutex, portMAX_DELAY);
+	while(qty > 0){
+		n = TELEMETRY_CHANNEL_BYTES / ch->size - ch->qty;
+		if(n == 0){
+			TelemetryFlushLocked();
+			continue;
+		}
+		if(n > qty){
+			n = qty;
+		}
+		memcpy(&ch->data[ch->qty * ch->size], src, n * ch->size);
+		ch->qty += n;
+		src += n * ch->size;
+		qty -= n;
+	}
+	xSemaphoreGive(telemetry_mutex);
+	return true;
+}
+
+void TelemetryFlush(void){
+	if(telemetry_mutex == NULL){
+		return;
+	}
+	xSemaphoreTake(telemetry_mutex, portMAX_DELAY);
+	TelemetryFlushLocked();
+	xSemaphoreGive(telemetry_mutex);
+}
+
+void TelemetryGetStats(telemetry_stats_t *stats_p){
+	*stats_p = stats;
+}
+
+/*==================[end of file]============================================*/
@@ -10,18 +10,51 @@
  */
 
 /*==================[inclusions]=============================================*/
+#include <stdlib.h>
 #include "ws2812b.h"
 #include "gpio_mcu.h"
+#include "gpio_fast_out_mcu.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
-#include "gpio_fast_out_mcu.h"
-#include "delay_mcu.h"
+#include "driver/rmt_tx.h"
+#include "esp_cpu.h"
+#include "esp_rom_sys.h"
 /*==================[macros and definitions]=================================*/
-#define RET_CMD (50)    // ret command 50us low
-#define BIT_0   (1)     // bit 0
-#define BIT_7   (1<<7)  // bit 0
+#define RMT_RESOLUTION  10000000        // 10 MHz, 1 tick = 0.1us
+#define T0H             4               // bit 0: 0.4us high
+#define T0L             8               // bit 0: 0.8us low
+#define T1H             8               // bit 1: 0.8us high
+#define T1L             4               // bit 1: 0.4us low
+#define RET_CMD         (300)           // ret command 300us low (50us on older parts)
+#define RET_TICKS       (RET_CMD * (RMT_RESOLUTION / 1000000) / 2)
+#define RMT_MEM_SYMBOLS 64              // RMT RAM used by the channel (refilled from ISR)
+#define RMT_QUEUE_DEPTH 4               // Frames that can be queued
+#define STAGE_BLOCK     (3 * 16)        // Growth step of the ws2812bSend() buffer
+#define PAR_T0H_NS      400             // Parallel output: bit 0 high time
+#define PAR_T1H_NS      800             // Parallel output: bit 1 high time
+#define PAR_BIT_NS      1250            // Parallel output: bit period
 /*==================[internal data declaration]==============================*/
-gpio_t pin_number;
+typedef struct {
+    rmt_encoder_t base;             // Encoder interface
+    rmt_encoder_t *bytes_encoder;   // GRB bytes to symbols
+    rmt_encoder_t *copy_encoder;    // Ret command
+    uint8_t state;                  // 0: sending data, 1: sending ret
+    rmt_symbol_word_t ret_code;     // Ret command symbol
+} ws2812b_encoder_t;
+
+static rmt_channel_handle_t rmt_channel = NULL;
+static ws2812b_encoder_t ws2812b_encoder;
+static volatile uint8_t pending = 0;        // Frames queued or being sent
+static portMUX_TYPE pending_mux = portMUX_INITIALIZER_UNLOCKED;    // pending is changed by tasks and the done ISR
+static void (*done_func_p)(void *param) = NULL;
+static void *done_param_p = NULL;
+static uint8_t *stage = NULL;               // ws2812bSend() buffer
+static uint32_t stage_len = 0;
+static uint32_t stage_size = 0;
+static gpio_fast_t par_pins;                // Parallel output pins (par_pins.handle is NULL until initialized)
+static uint32_t par_mask = 0;               // Every pin of the bundle
+static uint8_t par_qty = 0;                 // Number of parallel strips
+static portMUX_TYPE par_mux = portMUX_INITIALIZER_UNLOCKED;
 /*==================[internal functions declaration]=========================*/
 
 /*==================[internal data definition]===============================*/
@@ -47,283 +80,93 @@ static const uint8_t gamma_table[256] = {
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
-void IRAM_ATTR ws2812bSendHigh(gpio_t pin){
-    GPIOFastWrite(1);
-    //delay 0.8us
-    __asm__ __volatile__ ("nop");   // 1
-    __asm__ __volatile__ ("nop");   // 2
-    __asm__ __volatile__ ("nop");   // 3
-    __asm__ __volatile__ ("nop");   // 4
-    __asm__ __volatile__ ("nop");   // 5
-    __asm__ __volatile__ ("nop");   // 6
-    __asm__ __volatile__ ("nop");   // 7
-    __asm__ __volatile__ ("nop");   // 8
-    __asm__ __volatile__ ("nop");   // 9
-    __asm__ __volatile__ ("nop");   // 10
-    __asm__ __volatile__ ("nop");   // 11
-    __asm__ __volatile__ ("nop");   // 12
-    __asm__ __volatile__ ("nop");   // 13
-    __asm__ __volatile__ ("nop");   // 14
-    __asm__ __volatile__ ("nop");   // 15
-    __asm__ __volatile__ ("nop");   // 16
-    __asm__ __volatile__ ("nop");   // 17
-    __asm__ __volatile__ ("nop");   // 18
-    __asm__ __volatile__ ("nop");   // 19
-    __asm__ __volatile__ ("nop");   // 20
-    __asm__ __volatile__ ("nop");   // 21
-    __asm__ __volatile__ ("nop");   // 22
-    __asm__ __volatile__ ("nop");   // 23
-    __asm__ __volatile__ ("nop");   // 24  
-    __asm__ __volatile__ ("nop");   // 25
-    __asm__ __volatile__ ("nop");   // 26
-    __asm__ __volatile__ ("nop");   // 27
-    __asm__ __volatile__ ("nop");   // 28
-    __asm__ __volatile__ ("nop");   // 29
-    __asm__ __volatile__ ("nop");   // 30
-    __asm__ __volatile__ ("nop");   // 31
-    __asm__ __volatile__ ("nop");   // 32
-    __asm__ __volatile__ ("nop");   // 33
-    __asm__ __volatile__ ("nop");   // 34
-    __asm__ __volatile__ ("nop");   // 35
-    __asm__ __volatile__ ("nop");   // 36
-    __asm__ __volatile__ ("nop");   // 37
-    __asm__ __volatile__ ("nop");   // 38
-    __asm__ __volatile__ ("nop");   // 39
-    __asm__ __volatile__ ("nop");   // 40
-    __asm__ __volatile__ ("nop");   // 41
-    __asm__ __volatile__ ("nop");   // 42
-    __asm__ __volatile__ ("nop");   // 43
-    __asm__ __volatile__ ("nop");   // 44
-    __asm__ __volatile__ ("nop");   // 45
-    __asm__ __volatile__ ("nop");   // 46
-    __asm__ __volatile__ ("nop");   // 47
-    __asm__ __volatile__ ("nop");   // 48
-    __asm__ __volatile__ ("nop");   // 49
-    __asm__ __volatile__ ("nop");   // 50
-    __asm__ __volatile__ ("nop");   // 51
-    __asm__ __volatile__ ("nop");   // 52
-    __asm__ __volatile__ ("nop");   // 53
-    __asm__ __volatile__ ("nop");   // 54
-    __asm__ __volatile__ ("nop");   // 55
-    __asm__ __volatile__ ("nop");   // 56
-    __asm__ __volatile__ ("nop");   // 57
-    __asm__ __volatile__ ("nop");   // 58
-    __asm__ __volatile__ ("nop");   // 59
-    __asm__ __volatile__ ("nop");   // 47
-    __asm__ __volatile__ ("nop");   // 50
-    __asm__ __volatile__ ("nop");   // 51
-    __asm__ __volatile__ ("nop");   // 52
-    __asm__ __volatile__ ("nop");   // 53
-    __asm__ __volatile__ ("nop");   // 54
-    __asm__ __volatile__ ("nop");   // 55
-    __asm__ __volatile__ ("nop");   // 56
-    __asm__ __volatile__ ("nop");   // 57
-    __asm__ __volatile__ ("nop");   // 58
-    __asm__ __volatile__ ("nop");   // 59
-    __asm__ __volatile__ ("nop");   // 60
-    __asm__ __volatile__ ("nop");   // 61
-    __asm__ __volatile__ ("nop");   // 62
-    __asm__ __volatile__ ("nop");   // 63
-    __asm__ __volatile__ ("nop");   // 64
-    __asm__ __volatile__ ("nop");   // 65
-    __asm__ __volatile__ ("nop");   // 66
-    __asm__ __volatile__ ("nop");   // 67
-    __asm__ __volatile__ ("nop");   // 68
-    __asm__ __volatile__ ("nop");   // 69
-    __asm__ __volatile__ ("nop");   // 70
-    __asm__ __volatile__ ("nop");   // 71
-    __asm__ __volatile__ ("nop");   // 72
-    __asm__ __volatile__ ("nop");   // 73
-    __asm__ __volatile__ ("nop");   // 74
-    __asm__ __volatile__ ("nop");   // 75
-    __asm__ __volatile__ ("nop");   // 76
-    __asm__ __volatile__ ("nop");   // 77
-    __asm__ __volatile__ ("nop");   // 78
-    __asm__ __volatile__ ("nop");   // 79
-    __asm__ __volatile__ ("nop");   // 80
-    __asm__ __volatile__ ("nop");   // 81
-    __asm__ __volatile__ ("nop");   // 82
-    __asm__ __volatile__ ("nop");   // 83
-    __asm__ __volatile__ ("nop");   // 84
-    __asm__ __volatile__ ("nop");   // 85
-    __asm__ __volatile__ ("nop");   // 86
-    __asm__ __volatile__ ("nop");   // 87
-    __asm__ __volatile__ ("nop");   // 88
-    __asm__ __volatile__ ("nop");   // 89
-    __asm__ __volatile__ ("nop");   // 90
-    __asm__ __volatile__ ("nop");   // 91
-    
-    GPIOFastWrite(0);
-	//delay 0.45us
-    __asm__ __volatile__ ("nop");   // 1
-    __asm__ __volatile__ ("nop");   // 2
-    __asm__ __volatile__ ("nop");   // 3
-    __asm__ __volatile__ ("nop");   // 4
-    __asm__ __volatile__ ("nop");   // 5
-    __asm__ __volatile__ ("nop");   // 6
-    __asm__ __volatile__ ("nop");   // 7
-    __asm__ __volatile__ ("nop");   // 8
-    __asm__ __volatile__ ("nop");   // 9
-    __asm__ __volatile__ ("nop");   // 10
-    __asm__ __volatile__ ("nop");   // 11
-    __asm__ __volatile__ ("nop");   // 12
-    __asm__ __volatile__ ("nop");   // 13
-    __asm__ __volatile__ ("nop");   // 14
-    __asm__ __volatile__ ("nop");   // 15
-    __asm__ __volatile__ ("nop");   // 16
-    __asm__ __volatile__ ("nop");   // 17
-    __asm__ __volatile__ ("nop");   // 18
-    __asm__ __volatile__ ("nop");   // 19
-    __asm__ __volatile__ ("nop");   // 20
-    __asm__ __volatile__ ("nop");   // 21
-    __asm__ __volatile__ ("nop");   // 22
-    __asm__ __volatile__ ("nop");   // 23
-    __asm__ __volatile__ ("nop");   // 24  
-    __asm__ __volatile__ ("nop");   // 25
-    __asm__ __volatile__ ("nop");   // 26
-    __asm__ __volatile__ ("nop");   // 27
-    __asm__ __volatile__ ("nop");   // 28
-    __asm__ __volatile__ ("nop");   // 29
+static size_t IRAM_ATTR ws2812bEncode(rmt_encoder_t *encoder, rmt_channel_handle_t channel,
+                                      const void *data, size_t len, rmt_encode_state_t *ret_state){
+    ws2812b_encoder_t *enc = __containerof(encoder, ws2812b_encoder_t, base);
+    rmt_encode_state_t session_state = RMT_ENCODING_RESET;
+    rmt_encode_state_t state = RMT_ENCODING_RESET;
+    size_t symbols = 0;
+
+    /* Called again from the RMT ISR each time the channel memory runs out */
+    if(enc->state == 0){
+        symbols += enc->bytes_encoder->encode(enc->bytes_encoder, channel, data, len, &session_state);
+        if(session_state & RMT_ENCODING_COMPLETE){
+            enc->state = 1;
+        }
+        if(session_state & RMT_ENCODING_MEM_FULL){
+            *ret_state = state | RMT_ENCODING_MEM_FULL;
+            return symbols;
+        }
+    }
+    symbols += enc->copy_encoder->encode(enc->copy_encoder, channel, &enc->ret_code,
+                                         sizeof(enc->ret_code), &session_state);
+    if(session_state & RMT_ENCODING_COMPLETE){
+        enc->state = 0;
+        state |= RMT_ENCODING_COMPLETE;
+    }
+    if(session_state & RMT_ENCODING_MEM_FULL){
+        state |= RMT_ENCODING_MEM_FULL;
+    }
+    *ret_state = state;
+    return symbols;
 }
 
-void IRAM_ATTR ws2812bSendLow(gpio_t pin){
-    GPIOFastWrite(1);
-    //delay 0.4us
-    __asm__ __volatile__ ("nop");   // 1
-    __asm__ __volatile__ ("nop");   // 2
-    __asm__ __volatile__ ("nop");   // 3
-    __asm__ __volatile__ ("nop");   // 4
-    __asm__ __volatile__ ("nop");   // 5
-    __asm__ __volatile__ ("nop");   // 6
-    __asm__ __volatile__ ("nop");   // 7
-    __asm__ __volatile__ ("nop");   // 8
-    __asm__ __volatile__ ("nop");   // 9
-    __asm__ __volatile__ ("nop");   // 10
-    __asm__ __volatile__ ("nop");   // 11
-    __asm__ __volatile__ ("nop");   // 12
-    __asm__ __volatile__ ("nop");   // 13
-    __asm__ __volatile__ ("nop");   // 14
-    __asm__ __volatile__ ("nop");   // 15
-    __asm__ __volatile__ ("nop");   // 16
-    __asm__ __volatile__ ("nop");   // 17
-    __asm__ __volatile__ ("nop");   // 18
-    __asm__ __volatile__ ("nop");   // 19
-    __asm__ __volatile__ ("nop");   // 20
-    __asm__ __volatile__ ("nop");   // 21
-    __asm__ __volatile__ ("nop");   // 22
-    __asm__ __volatile__ ("nop");   // 23
-    __asm__ __volatile__ ("nop");   // 24  
-    __asm__ __volatile__ ("nop");   // 25
-    __asm__ __volatile__ ("nop");   // 26
-    __asm__ __volatile__ ("nop");   // 27
+static esp_err_t ws2812bEncoderReset(rmt_encoder_t *encoder){
+    ws2812b_encoder_t *enc = __containerof(encoder, ws2812b_encoder_t, base);
+    rmt_encoder_reset(enc->bytes_encoder);
+    rmt_encoder_reset(enc->copy_encoder);
+    enc->state = 0;
+    return ESP_OK;
+}
 
-    GPIOFastWrite(0);
-	//delay 0.85us
-    __asm__ __volatile__ ("nop");   // 1
-    __asm__ __volatile__ ("nop");   // 2
-    __asm__ __volatile__ ("nop");   // 3
-    __asm__ __volatile__ ("nop");   // 4
-    __asm__ __volatile__ ("nop");   // 5
-    __asm__ __volatile__ ("nop");   // 6
-    __asm__ __volatile__ ("nop");   // 7
-    __asm__ __volatile__ ("nop");   // 8
-    __asm__ __volatile__ ("nop");   // 9
-    __asm__ __volatile__ ("nop");   // 10
-    __asm__ __volatile__ ("nop");   // 11
-    __asm__ __volatile__ ("nop");   // 12
-    __asm__ __volatile__ ("nop");   // 13
-    __asm__ __volatile__ ("nop");   // 14
-    __asm__ __volatile__ ("nop");   // 15
-    __asm__ __volatile__ ("nop");   // 16
-    __asm__ __volatile__ ("nop");   // 17
-    __asm__ __volatile__ ("nop");   // 18
-    __asm__ __volatile__ ("nop");   // 19
-    __asm__ __volatile__ ("nop");   // 20
-    __asm__ __volatile__ ("nop");   // 21
-    __asm__ __volatile__ ("nop");   // 22
-    __asm__ __volatile__ ("nop");   // 23
-    __asm__ __volatile__ ("nop");   // 24  
-    __asm__ __volatile__ ("nop");   // 25
-    __asm__ __volatile__ ("nop");   // 26
-    __asm__ __volatile__ ("nop");   // 27
-    __asm__ __volatile__ ("nop");   // 28
-    __asm__ __volatile__ ("nop");   // 29
-    __asm__ __volatile__ ("nop");   // 30
-    __asm__ __volatile__ ("nop");   // 31
-    __asm__ __volatile__ ("nop");   // 32
-    __asm__ __volatile__ ("nop");   // 33
-    __asm__ __volatile__ ("nop");   // 34
-    __asm__ __volatile__ ("nop");   // 35
-    __asm__ __volatile__ ("nop");   // 36
-    __asm__ __volatile__ ("nop");   // 37
-    __asm__ __volatile__ ("nop");   // 38
-    __asm__ __volatile__ ("nop");   // 39
-    __asm__ __volatile__ ("nop");   // 40
-    __asm__ __volatile__ ("nop");   // 41
-    __asm__ __volatile__ ("nop");   // 42
-    __asm__ __volatile__ ("nop");   // 43
-    __asm__ __volatile__ ("nop");   // 44
-    __asm__ __volatile__ ("nop");   // 45
-    __asm__ __volatile__ ("nop");   // 46
-    __asm__ __volatile__ ("nop");   // 47
-    __asm__ __volatile__ ("nop");   // 48
-    __asm__ __volatile__ ("nop");   // 49
-    __asm__ __volatile__ ("nop");   // 50
-    __asm__ __volatile__ ("nop");   // 51
-    __asm__ __volatile__ ("nop");   // 52
-    __asm__ __volatile__ ("nop");   // 53
-    __asm__ __volatile__ ("nop");   // 54
-    __asm__ __volatile__ ("nop");   // 55
-    __asm__ __volatile__ ("nop");   // 56
-    __asm__ __volatile__ ("nop");   // 57
-    __asm__ __volatile__ ("nop");   // 58
-    __asm__ __volatile__ ("nop");   // 59
-    __asm__ __volatile__ ("nop");   // 47
-    __asm__ __volatile__ ("nop");   // 50
-    __asm__ __volatile__ ("nop");   // 51
-    __asm__ __volatile__ ("nop");   // 52
-    __asm__ __volatile__ ("nop");   // 53
-    __asm__ __volatile__ ("nop");   // 54
-    __asm__ __volatile__ ("nop");   // 55
-    __asm__ __volatile__ ("nop");   // 56
-    __asm__ __volatile__ ("nop");   // 57
-    __asm__ __volatile__ ("nop");   // 58
-    __asm__ __volatile__ ("nop");   // 59
-    __asm__ __volatile__ ("nop");   // 60
-    __asm__ __volatile__ ("nop");   // 61
-    __asm__ __volatile__ ("nop");   // 62
-    __asm__ __volatile__ ("nop");   // 63
-    __asm__ __volatile__ ("nop");   // 64
-    __asm__ __volatile__ ("nop");   // 65
-    __asm__ __volatile__ ("nop");   // 66
-    __asm__ __volatile__ ("nop");   // 67
-    __asm__ __volatile__ ("nop");   // 68
-    __asm__ __volatile__ ("nop");   // 69
-    __asm__ __volatile__ ("nop");   // 70
-    __asm__ __volatile__ ("nop");   // 71
-    __asm__ __volatile__ ("nop");   // 72
-    __asm__ __volatile__ ("nop");   // 73
-    __asm__ __volatile__ ("nop");   // 74
-    __asm__ __volatile__ ("nop");   // 75
-    __asm__ __volatile__ ("nop");   // 76
-    __asm__ __volatile__ ("nop");   // 77
-    __asm__ __volatile__ ("nop");   // 78
-    __asm__ __volatile__ ("nop");   // 79
-    __asm__ __volatile__ ("nop");   // 80
-    __asm__ __volatile__ ("nop");   // 81
-    __asm__ __volatile__ ("nop");   // 82
-    __asm__ __volatile__ ("nop");   // 83
-    __asm__ __volatile__ ("nop");   // 84
-    __asm__ __volatile__ ("nop");   // 85
-    __asm__ __volatile__ ("nop");   // 86
-    __asm__ __volatile__ ("nop");   // 87
-    __asm__ __volatile__ ("nop");   // 88
-    __asm__ __volatile__ ("nop");   // 89
-    __asm__ __volatile__ ("nop");   // 90
-    __asm__ __volatile__ ("nop");   // 91
-    __asm__ __volatile__ ("nop");   // 92
-    __asm__ __volatile__ ("nop");   // 93
-    __asm__ __volatile__ ("nop");   // 94
+static esp_err_t ws2812bEncoderDel(rmt_encoder_t *encoder){
+    ws2812b_encoder_t *enc = __containerof(encoder, ws2812b_encoder_t, base);
+    rmt_del_encoder(enc->bytes_encoder);
+    rmt_del_encoder(enc->copy_encoder);
+    return ESP_OK;
+}
+
+static bool IRAM_ATTR ws2812bDoneIsr(rmt_channel_handle_t channel, const rmt_tx_done_event_data_t *edata, void *ctx){
+    portENTER_CRITICAL_ISR(&pending_mux);
+    if(pending){
+        pending--;
+    }
+    portEXIT_CRITICAL_ISR(&pending_mux);
+    if(done_func_p != NULL){
+        done_func_p(done_param_p);
+    }
+    return false;
+}
+
+/* Bit c of byte s of x moves to bit s of byte c (8x8 bit matrix transpose) */
+static inline uint64_t ws2812bTranspose(uint64_t x){
+    uint64_t t;
+    t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+    x = x ^ t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+    x = x ^ t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+    x = x ^ t ^ (t << 28);
+    return x;
+}
+
+/* Send 24 bits on every strip at once, bits[n] holds bit n of each strip (strip s in bit s) */
+static void IRAM_ATTR ws2812bParallelLed(const uint8_t *bits, uint32_t t0h, uint32_t t1h, uint32_t period){
+    uint32_t start;
+
+    portENTER_CRITICAL(&par_mux);
+    start = esp_cpu_get_cycle_count();
+    for(uint8_t i = 0; i < 24; i++){
+        GPIOFastWriteMask(&par_pins, par_mask, par_mask);
+        while(esp_cpu_get_cycle_count() - start < t0h);
+        /* Strips sending a 1 stay high until t1h */
+        GPIOFastWriteMask(&par_pins, par_mask, bits[i]);
+        while(esp_cpu_get_cycle_count() - start < t1h);
+        GPIOFastWriteMask(&par_pins, par_mask, 0);
+        while(esp_cpu_get_cycle_count() - start < period);
+        start += period;
+    }
+    portEXIT_CRITICAL(&par_mux);
 }
 
 uint8_t ws2812bGammaCorrection(uint8_t component){
@@ -333,44 +176,156 @@ uint8_t ws2812bGammaCorrection(uint8_t component){
 /*==================[external functions definition]==========================*/
 
 void ws2812bInit(gpio_t pin){
-    pin_number = pin;
-    GPIOFastInit(&pin, 1);
+    rmt_tx_channel_config_t channel_config = {
+        .gpio_num = pin,
+        .clk_src = RMT_CLK_SRC_DEFAULT,
+        .resolution_hz = RMT_RESOLUTION,
+        .mem_block_symbols = RMT_MEM_SYMBOLS,
+        .trans_queue_depth = RMT_QUEUE_DEPTH,
+    };
+    rmt_bytes_encoder_config_t bytes_config = {
+        .bit0 = {.level0 = 1, .duration0 = T0H, .level1 = 0, .duration1 = T0L},
+        .bit1 = {.level0 = 1, .duration0 = T1H, .level1 = 0, .duration1 = T1L},
+        .flags.msb_first = 1,
+    };
+    rmt_copy_encoder_config_t copy_config = {};
+    rmt_tx_event_callbacks_t callbacks = {
+        .on_trans_done = ws2812bDoneIsr,
+    };
+
+    if(rmt_channel != NULL){
+        return;
+    }
+    ws2812b_encoder.base.encode = ws2812bEncode;
+    ws2812b_encoder.base.reset = ws2812bEncoderReset;
+    ws2812b_encoder.base.del = ws2812bEncoderDel;
+    ws2812b_encoder.state = 0;
+    ws2812b_encoder.ret_code = (rmt_symbol_word_t){.level0 = 0, .duration0 = RET_TICKS,
+                                                   .level1 = 0, .duration1 = RET_TICKS};
+    ESP_ERROR_CHECK(rmt_new_bytes_encoder(&bytes_config, &ws2812b_encoder.bytes_encoder));
+    ESP_ERROR_CHECK(rmt_new_copy_encoder(&copy_config, &ws2812b_encoder.copy_encoder));
+    ESP_ERROR_CHECK(rmt_new_tx_channel(&channel_config, &rmt_channel));
+    ESP_ERROR_CHECK(rmt_tx_register_event_callbacks(rmt_channel, &callbacks, NULL));
+    ESP_ERROR_CHECK(rmt_enable(rmt_channel));
 }
 
-void ws2812bSend(rgb_led_t led_color){
-    uint8_t i;
-	// Blue
-	for(i=0; i<=7; i++){
-        if(ws2812bGammaCorrection(led_color.green) & (BIT_7>>i)){
-            ws2812bSendHigh(pin_number);
-        }
-        else{
-            ws2812bSendLow(pin_number);
-        }
+void ws2812bSetCallback(void (*func_p)(void *param), void *param_p){
+    done_func_p = func_p;
+    done_param_p = param_p;
+}
+
+esp_err_t ws2812bTransmit(const uint8_t *grb, uint32_t len){
+    rmt_transmit_config_t tx_config = {
+        .loop_count = 0,
+    };
+    esp_err_t ret;
+
+    if(rmt_channel == NULL){
+        return ESP_ERR_INVALID_STATE;
     }
-	// Red
-    for(i=0; i<=7; i++){
-        if(ws2812bGammaCorrection(led_color.red) & (BIT_7>>i)){
-            ws2812bSendHigh(pin_number);
-        }
-        else{
-            ws2812bSendLow(pin_number);
+    portENTER_CRITICAL(&pending_mux);
+    pending++;
+    portEXIT_CRITICAL(&pending_mux);
+    ret = rmt_transmit(rmt_channel, &ws2812b_encoder.base, grb, len, &tx_config);
+    if(ret != ESP_OK){
+        portENTER_CRITICAL(&pending_mux);
+        pending--;
+        portEXIT_CRITICAL(&pending_mux);
+    }
+    return ret;
+}
+
+bool ws2812bBusy(void){
+    return pending != 0;
+}
+
+esp_err_t ws2812bWait(int32_t timeout_ms){
+    if(rmt_channel == NULL){
+        return ESP_ERR_INVALID_STATE;
+    }
+    return rmt_tx_wait_all_done(rmt_channel, timeout_ms);
+}
+
+bool ws2812bParallelInit(gpio_t *pins, uint8_t qty){
+    if(par_pins.handle != NULL || qty > WS2812B_MAX_STRIPS){
+        return false;
+    }
+    /* The dedicated channels may be taken by other bundles */
+    if(!GPIOFastInit(&par_pins, pins, qty, GPIO_FAST_OUTPUT)){
+        return false;
+    }
+    par_qty = qty;
+    par_mask = (1UL << qty) - 1;
+    GPIOFastWrite(&par_pins, 0);
+    return true;
+}
+
+void ws2812bParallelTransmit(const uint8_t *const grb[], const uint32_t len[]){
+    uint32_t ticks_us = esp_rom_get_cpu_ticks_per_us();
+    uint32_t t0h = (PAR_T0H_NS * ticks_us) / 1000;
+    uint32_t t1h = (PAR_T1H_NS * ticks_us) / 1000;
+    uint32_t period = (PAR_BIT_NS * ticks_us) / 1000;
+    uint32_t max_len = 0;
+    uint8_t bits[24];
+    uint64_t x;
+
+    if(par_pins.handle == NULL){
+        return;
+    }
+    for(uint8_t s = 0; s < par_qty; s++){
+        if(len[s] > max_len){
+            max_len = len[s];
         }
     }
-	// Green
-    for(i=0; i<=7; i++){
-        if(ws2812bGammaCorrection(led_color.blue) & (BIT_7>>i)){
-            ws2812bSendHigh(pin_number);
+    /* Interrupts are only disabled for each led, but no task may run between
+     * them: a pause longer than the reset time would latch a partial frame */
+    vTaskSuspendAll();
+    for(uint32_t led = 0; led < max_len; led += 3){
+        /* Transposed between leds, the line stays low for a few hundred ns more */
+        for(uint8_t c = 0; c < 3; c++){
+            x = 0;
+            for(uint8_t s = 0; s < par_qty; s++){
+                if(led + c < len[s]){
+                    x |= (uint64_t)grb[s][led + c] << (8 * s);
+                }
+            }
+            x = ws2812bTranspose(x);
+            /* MSB first */
+            for(uint8_t b = 0; b < 8; b++){
+                bits[8 * c + b] = x >> (8 * (7 - b));
+            }
         }
-        else{
-            ws2812bSendLow(pin_number);
+        ws2812bParallelLed(bits, t0h, t1h, period);
+    }
+    xTaskResumeAll();
+    esp_rom_delay_us(RET_CMD);
+}
+
+void ws2812bSend(rgb_led_t led_color){
+    uint8_t *aux;
+
+    if(stage_len + 3 > stage_size){
+        aux = realloc(stage, stage_size + STAGE_BLOCK);
+        if(aux == NULL){
+            return;
         }
+        stage = aux;
+        stage_size += STAGE_BLOCK;
     }
+    stage[stage_len++] = ws2812bGammaCorrection(led_color.green);
+    stage[stage_len++] = ws2812bGammaCorrection(led_color.red);
+    stage[stage_len++] = ws2812bGammaCorrection(led_color.blue);
 }
 
 void ws2812bSendRet(void){
-    GPIOFastWrite(0);
-    DelayUs(RET_CMD);
+    /* The ret command is appended by the encoder, only flush the pending leds */
+    if(stage_len == 0){
+        return;
+    }
+    if(ws2812bTransmit(stage, stage_len) == ESP_OK){
+        ws2812bWait(-1);
+    }
+    stage_len = 0;
 }
 
 /*==================[end of file]============================================*/
@@ -13,6 +13,14 @@
  * so it can be used to communicate with common Android apps, like "Bluetooth Electronics"
  * (https://play.google.com/store/apps/details?id=com.keuwl.arduinobluetooth)
  * 
+ * Data sent with BleSendByte(), BleSendString() and BleSendBuffer() is copied
+ * to a transmission buffer and sent as notifications by a task. Transmission pauses
+ * while the controller reports congestion, so no notification is lost.
+ * 
+ * Besides the HM-10 characteristic, the application can add its own characteristics
+ * (with BleAddCharacteristic() before BleInit()) to a second service, e.g. one per
+ * sensor with a binary value. Clients subscribe only to the ones they need.
+ * 
  * @author Albano Peñalva
  *
  * @section changelog
@@ -20,6 +28,12 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 22/03/2024 | Document creation		                         						|
+ * | 19/10/2026 | ATT MTU negotiation, Data Length Extension and 2M PHY					|
+ * | 19/10/2026 | Event driven transmission without delays and latency statistics		|
+ * | 19/10/2026 | Transmission ring with congestion control and full buffer policies	|
+ * | 19/10/2026 | Service with characteristics added by the application					|
+ * | 19/10/2026 | Batching of small messages in MTU sized notifications					|
+ * | 19/10/2026 | Connection and power profiles											|
  * 
  **/
 
@@ -28,6 +42,11 @@
 #include <stdint.h>
 /*==================[macros]=================================================*/
 #define BLE_NO_INT	0		/*!< Flag used when no reading interruption is required */
+#define BLE_MTU_MAX	247		/*!< ATT MTU offered to the client (a notification fills one 251 bytes link layer packet) */
+#define BLE_MAX_CHARS	8		/*!< Max number of characteristics added with BleAddCharacteristic() */
+#define BLE_CHAR_READ	(1 << 0)	/*!< The client can read the characteristic */
+#define BLE_CHAR_WRITE	(1 << 1)	/*!< The client can write the characteristic */
+#define BLE_CHAR_NOTIFY	(1 << 2)	/*!< The client can subscribe to notifications of the characteristic */
 /*==================[typedef]================================================*/
 /**
  * @brief Prototype of callback function for reading received data 
@@ -37,12 +56,73 @@
  */
 typedef void (*read_func) (uint8_t * data, uint8_t length);
 
+/**
+ * @brief Prototype of function that returns the value of a characteristic
+ * 
+ * @note Called from the Bluetooth task on client reads and from the driver task
+ * on periodic notifications, so it should return quickly.
+ * 
+ * @param value      pointer to store the value
+ * @param max_length max number of bytes of the value
+ * @param param_p    parameter given in the characteristic configuration
+ * @return uint16_t  number of bytes of the value
+ */
+typedef uint16_t (*ble_char_read_t) (uint8_t * value, uint16_t max_length, void * param_p);
+
+/**
+ * @brief Prototype of function called when the client writes a characteristic
+ * 
+ * @param value      pointer to written value
+ * @param length     number of bytes of the value
+ * @param param_p    parameter given in the characteristic configuration
+ */
+typedef void (*ble_char_write_t) (const uint8_t * value, uint16_t length, void * param_p);
+
+/**
+ * @brief Characteristic configuration struct
+ */
+typedef struct {
+	uint16_t uuid;				/*!< 16 bit characteristic UUID */
+	uint8_t properties;			/*!< BLE_CHAR_READ, BLE_CHAR_WRITE and/or BLE_CHAR_NOTIFY */
+	uint16_t max_length;		/*!< Max value length in bytes (up to 512) */
+	uint16_t notify_period_ms;	/*!< Period to notify the value given by read_p while subscribed (0: only with BleNotify()) */
+	ble_char_read_t read_p;		/*!< Function that gives the value (NULL: reads return the last value given to BleNotify()) */
+	ble_char_write_t write_p;	/*!< Function called when the client writes the value (NULL if not requiered) */
+	void * param_p;				/*!< Parameter passed to read_p and write_p */
+	const char * description;	/*!< User description shown by client apps (NULL: none) */
+} ble_char_config_t;
+
+/**
+ * @brief What to do when data is sent and the transmission buffer is full
+ */
+typedef enum {
+	BLE_TX_BLOCK,			/*!< Wait until there is space (or the device disconnects) */
+	BLE_TX_DROP_OLDEST		/*!< Discard the oldest messages not sent yet */
+} ble_tx_policy_t;
+
+/**
+ * @brief Connection and power profiles
+ * 
+ * The central (phone) has the last word on connection parameters and PHY, it
+ * may choose other values within its own limits (see BleGetLink()).
+ */
+typedef enum {
+	BLE_PROFILE_DEFAULT,		/*!< 7.5-20 ms connection interval, 20-40 ms advertising interval */
+	BLE_PROFILE_LOW_LATENCY,	/*!< 7.5 ms connection interval, 2M PHY (e.g. remote control) */
+	BLE_PROFILE_THROUGHPUT,		/*!< 15-30 ms connection interval to send many packets per event, 2M PHY (e.g. data logging) */
+	BLE_PROFILE_LOW_POWER		/*!< 100-200 ms connection interval skipping up to 4 events, 1-1.5 s advertising interval (e.g. battery units) */
+} ble_profile_t;
+
 /**
  * @brief BLE configuration struct
  */
 typedef struct {			
 	char * device_name;		/*!< BLE device name */
 	read_func func_p;		/*!< Pointer to callback function to call when receiving data (= BLE_NO_INT if not requiered) */
+	ble_tx_policy_t tx_policy;	/*!< Policy when the transmission buffer is full (default BLE_TX_BLOCK) */
+	uint32_t tx_buffer_size;	/*!< Transmission buffer size in bytes (0: default, 4096). Each message uses 8 extra bytes */
+	uint16_t service_uuid;		/*!< UUID of the service with the characteristics added with BleAddCharacteristic() (0: default, 0xFFF0) */
+	ble_profile_t profile;		/*!< Connection and power profile (default BLE_PROFILE_DEFAULT) */
 } ble_config_t;
 
 /**
@@ -53,6 +133,36 @@ typedef enum ble_status {
 	BLE_DISCONNECTED,		/*!< BLE device disconnected */
 	BLE_CONNECTED			/*!< BLE device connected */
 } ble_status_t;
+/**
+ * @brief BLE transmission statistics
+ * 
+ * Latency is measured from the BleSend...() call until the last notification
+ * of the message is handed to the Bluetooth stack.
+ */
+typedef struct {
+	uint32_t messages;			/*!< Messages sent */
+	uint32_t bytes;				/*!< Bytes sent */
+	uint32_t notifications;		/*!< Notifications sent */
+	uint32_t dropped;			/*!< Messages discarded because the buffer was full (or bigger than it) */
+	uint32_t congestions;		/*!< Times the controller buffers got full and transmission paused */
+	uint32_t pending;			/*!< Bytes waiting in the transmission buffer */
+	uint32_t throughput;		/*!< Bytes per second sent during the last second */
+	uint32_t latency_last_us;	/*!< Latency of the last message (us) */
+	uint32_t latency_avg_us;	/*!< Average latency (us) */
+	uint32_t latency_max_us;	/*!< Max latency (us) */
+} ble_stats_t;
+/**
+ * @brief Parameters of the current connection
+ */
+typedef struct {
+	ble_profile_t profile;		/*!< Profile selected */
+	uint16_t mtu;				/*!< ATT MTU */
+	uint32_t interval_us;		/*!< Connection interval (us) */
+	uint16_t latency;			/*!< Connection events the device can skip */
+	uint16_t timeout_ms;		/*!< Supervision timeout (ms) */
+	uint8_t phy;				/*!< Transmission PHY (1: 1M, 2: 2M) */
+	uint16_t data_length;		/*!< Max link layer payload in bytes (27 without Data Length Extension) */
+} ble_link_t;
 /*==================[external data declaration]==============================*/
 
 /*==================[external functions declaration]=========================*/
@@ -72,6 +182,16 @@ void BleInit(ble_config_t * ble_device);
  */
 ble_status_t BleStatus(void);
 
+/**
+ * @brief Gets the ATT MTU negotiated with the connected device
+ * 
+ * @note Data is sent in notifications of up to BleMtu() - 3 bytes. It's 23 until
+ * the client requests a bigger MTU (up to BLE_MTU_MAX).
+ * 
+ * @return uint16_t ATT MTU in bytes
+ */
+uint16_t BleMtu(void);
+
 /**
  * @brief Send a single byte trough BLE (if connected)
  * 
@@ -94,6 +214,81 @@ void BleSendString(const char *msg);
  */
 void BleSendBuffer(const char *data, uint8_t nbytes);
 
+/**
+ * @brief Enable or disable batching of the data sent with BleSendByte(), BleSendString() and BleSendBuffer()
+ * 
+ * When enabled, consecutive messages are sent together in one notification, which
+ * is sent when it's full (BleMtu() - 3 bytes) or when the oldest message in it has
+ * waited deadline_ms. Fewer notifications save airtime and power, at the cost of up
+ * to deadline_ms (rounded up to the RTOS tick) of extra latency.
+ * 
+ * @note The receiver must not rely on each message arriving in its own notification.
+ * 
+ * @param deadline_ms Max time a message waits for more data (0: disable batching, default)
+ */
+void BleSetBatching(uint16_t deadline_ms);
+
+/**
+ * @brief Add a characteristic to the application service
+ * 
+ * @note Must be called before BleInit().
+ * 
+ * @param config Characteristic configuration (notify_period_ms > 0 requires read_p and BLE_CHAR_NOTIFY)
+ * @return int8_t Characteristic id used by BleNotify(), or -1 if it can't be added
+ */
+int8_t BleAddCharacteristic(const ble_char_config_t *config);
+
+/**
+ * @brief Update the value of a characteristic and notify it (if the client subscribed)
+ * 
+ * @note Notifications carry up to BleMtu() - 3 bytes of the value.
+ * 
+ * @param id Characteristic id
+ * @param value Pointer to the value
+ * @param length Number of bytes of the value
+ * @return true if the notification was queued
+ */
+bool BleNotify(uint8_t id, const void *value, uint16_t length);
+
+/**
+ * @brief Gets whether the client subscribed to notifications of a characteristic
+ * 
+ * @param id Characteristic id
+ * @return true if subscribed
+ */
+bool BleSubscribed(uint8_t id);
+
+/**
+ * @brief Gets transmission statistics
+ * 
+ * @param stats Pointer to store the statistics
+ */
+void BleGetStats(ble_stats_t *stats);
+
+/**
+ * @brief Clears transmission statistics
+ */
+void BleResetStats(void);
+
+/**
+ * @brief Select the connection and power profile
+ * 
+ * @note Can be called at any time: if connected the new connection parameters
+ * and PHY are requested to the central, if advertising it restarts with the new interval.
+ * 
+ * @param profile Profile
+ */
+void BleSetProfile(ble_profile_t profile);
+
+/**
+ * @brief Gets the parameters of the current connection
+ * 
+ * @note Measured throughput and latency are given by BleGetStats().
+ * 
+ * @param link Pointer to store the parameters
+ */
+void BleGetLink(ble_link_t *link);
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
@@ -0,0 +1,121 @@
+#ifndef FORMAT_MCU_H
+#define FORMAT_MCU_H
+
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Microcontroller Drivers microcontroller
+ ** @{ */
+/** \addtogroup Format Format
+ ** @{ */
+
+/** \brief Number to text conversion without printf.
+ *
+ * Every function writes into a buffer supplied by the caller (so they can be
+ * used from several tasks at once), ends it with '\0' and returns the number
+ * of characters written (without the '\0').
+ *
+ * Decimal conversion produces two digits per division by 100 using a table,
+ * hexadecimal conversion uses shifts only.
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 19/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+/*==================[macros]=================================================*/
+#define FORMAT_UINT_SIZE	11		/*!< Buffer size for any uint32_t in decimal */
+#define FORMAT_INT_SIZE		12		/*!< Buffer size for any int32_t in decimal */
+#define FORMAT_HEX_SIZE		9		/*!< Buffer size for any uint32_t in hexadecimal */
+#define FORMAT_BIN_SIZE		33		/*!< Buffer size for any uint32_t in binary */
+#define FORMAT_FLOAT_SIZE	24		/*!< Buffer size for any float with up to 9 decimals */
+#define FORMAT_MAX_DECIMALS	9		/*!< Max decimals of FormatFixed() and FormatFloat() */
+/*==================[typedef]================================================*/
+
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Unsigned decimal
+ *
+ * @param buf Buffer (FORMAT_UINT_SIZE bytes)
+ * @param val Number
+ * @return uint8_t Length
+ */
+uint8_t FormatUint(char *buf, uint32_t val);
+
+/**
+ * @brief Unsigned decimal with leading characters (like "%03lu")
+ *
+ * @param buf Buffer (max(width, FORMAT_UINT_SIZE - 1) + 1 bytes)
+ * @param val Number
+ * @param width Min length
+ * @param pad Character used to fill (e.g. '0' or ' ')
+ * @return uint8_t Length
+ */
+uint8_t FormatUintPad(char *buf, uint32_t val, uint8_t width, char pad);
+
+/**
+ * @brief Signed decimal
+ *
+ * @param buf Buffer (FORMAT_INT_SIZE bytes)
+ * @param val Number
+ * @return uint8_t Length
+ */
+uint8_t FormatInt(char *buf, int32_t val);
+
+/**
+ * @brief Hexadecimal (lowercase)
+ *
+ * @param buf Buffer (FORMAT_HEX_SIZE bytes)
+ * @param val Number
+ * @param digits Min number of digits, filled with '0' (0: no leading zeros)
+ * @return uint8_t Length
+ */
+uint8_t FormatHex(char *buf, uint32_t val, uint8_t digits);
+
+/**
+ * @brief Any base from 2 to 16
+ *
+ * @param buf Buffer (FORMAT_BIN_SIZE bytes for base 2)
+ * @param val Number
+ * @param base Base of the converted number
+ * @return uint8_t Length (0 if base is not valid)
+ */
+uint8_t FormatBase(char *buf, uint32_t val, uint8_t base);
+
+/**
+ * @brief Fixed point number
+ *
+ * e.g. FormatFixed(buf, -12345, 2) writes "-123.45"
+ *
+ * @param buf Buffer (FORMAT_INT_SIZE + 1 bytes)
+ * @param val Number multiplied by 10^decimals
+ * @param decimals Number of decimals (up to FORMAT_MAX_DECIMALS)
+ * @return uint8_t Length
+ */
+uint8_t FormatFixed(char *buf, int32_t val, uint8_t decimals);
+
+/**
+ * @brief Float number, rounded to the number of decimals
+ *
+ * @note Values of 1e9 or more are written in exponential notation (e.g. "1.50e+12").
+ * @param buf Buffer (FORMAT_FLOAT_SIZE bytes)
+ * @param val Number
+ * @param decimals Number of decimals (up to FORMAT_MAX_DECIMALS)
+ * @return uint8_t Length
+ */
+uint8_t FormatFloat(char *buf, float val, uint8_t decimals);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,121 @@
+#ifndef GPIO_EVENT_MCU_H
+#define GPIO_EVENT_MCU_H
+
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Microcontroller Drivers microcontroller
+ ** @{ */
+/** \addtogroup GPIO_Event GPIO events
+ ** @{ */
+
+/** \brief Debounced input events (press, release, click, double click and long press).
+ *
+ * Each configured input interrupts on both edges. The ISR only stores the pin
+ * level and a timestamp in a queue, and a single task runs the debounce and
+ * the button state machine of every pin from those timestamps, calling the
+ * callback function of the pin with each event. No task polls the inputs.
+ *
+ * Debounce reports the first edge at once (so a press is delivered within
+ * microseconds) and ignores the following edges for debounce_ms; the level is
+ * checked again when that time ends, so a change hidden by bounces isn't lost.
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 19/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "gpio_mcu.h"
+/*==================[macros]=================================================*/
+#define GPIO_EVENT_DEBOUNCE_MS	20		/*!< Default debounce time */
+/*==================[typedef]================================================*/
+/**
+ * @brief Input event types
+ */
+typedef enum {
+	GPIO_EVENT_PRESS,			/*!< Input became active */
+	GPIO_EVENT_RELEASE,			/*!< Input became inactive */
+	GPIO_EVENT_CLICK,			/*!< Press and release (after double_click_ms without a second press) */
+	GPIO_EVENT_DOUBLE_CLICK,	/*!< Second click within double_click_ms */
+	GPIO_EVENT_LONG_PRESS		/*!< Input active for long_press_ms (no click follows) */
+} gpio_event_type_t;
+
+/**
+ * @brief Input event
+ */
+typedef struct {
+	gpio_t pin;					/*!< GPIO number */
+	gpio_event_type_t type;		/*!< Event type */
+	int64_t time_us;			/*!< Time of the edge (or timeout) that caused the event (esp_timer time, us) */
+	uint32_t duration_ms;		/*!< GPIO_EVENT_RELEASE: time the input was active */
+} gpio_event_t;
+
+/**
+ * @brief Prototype of callback function for input events
+ *
+ * @note Called from the events task (not from an ISR).
+ *
+ * @param event		pointer to the event
+ * @param param_p	parameter given in the configuration
+ */
+typedef void (*gpio_event_func_t) (const gpio_event_t *event, void *param_p);
+
+/**
+ * @brief Input events configuration struct
+ */
+typedef struct {
+	bool active_high;			/*!< false: active low, e.g. switch to ground with pull-up (ESP-EDU switches) */
+	uint16_t debounce_ms;		/*!< Edges ignored after a change (0: default, GPIO_EVENT_DEBOUNCE_MS) */
+	uint16_t long_press_ms;		/*!< Time to report GPIO_EVENT_LONG_PRESS (0: disabled) */
+	uint16_t double_click_ms;	/*!< Max time between clicks of a double click (0: disabled, clicks are reported on release) */
+	gpio_event_func_t func_p;	/*!< Pointer to callback function */
+	void *param_p;				/*!< Parameter passed to the callback function */
+} gpio_event_config_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Configure a GPIO as input with events
+ *
+ * @note The GPIO is initialized as input with pull-up (GPIOInit()).
+ * @param pin GPIO number
+ * @param config Events configuration
+ * @return true if configured
+ */
+bool GPIOEventInit(gpio_t pin, const gpio_event_config_t *config);
+
+/**
+ * @brief Stop generating events of a GPIO
+ *
+ * @param pin GPIO number
+ */
+void GPIOEventDeinit(gpio_t pin);
+
+/**
+ * @brief Debounced state of a GPIO with events
+ *
+ * @param pin GPIO number
+ * @return true if active
+ */
+bool GPIOEventActive(gpio_t pin);
+
+/**
+ * @brief Number of edges lost because the events queue was full
+ *
+ * @return uint32_t Lost edges (the state is recovered when the debounce time ends)
+ */
+uint32_t GPIOEventOverflows(void);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif
+
+/*==================[end of file]============================================*/
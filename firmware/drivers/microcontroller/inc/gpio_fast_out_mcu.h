@@ -8,6 +8,22 @@
  ** @{ */
 
 /** \brief GPIO driver to use gpio ouputs with faster functions than gpio_mcu.
+ * 
+ * Pins are grouped in bundles of dedicated GPIO channels of the CPU, so a
+ * bundle is written or read with a single CPU instruction (no peripheral bus
+ * access, no locks): timing is deterministic and the functions can be called
+ * from ISRs. Several bundles can be used at the same time, up to
+ * GPIO_FAST_CHANNELS outputs and GPIO_FAST_CHANNELS inputs in total.
+ * 
+ * Bit n of every value and mask is pin_list[n] of the bundle.
+ * 
+ * e.g.
+ * @code
+ * gpio_fast_t bcd;
+ * gpio_t pins[] = {GPIO_20, GPIO_21, GPIO_22, GPIO_23};
+ * GPIOFastInit(&bcd, pins, 4, GPIO_FAST_OUTPUT);
+ * GPIOFastWriteMask(&bcd, 0x03, 0x01);		// GPIO_20 high, GPIO_21 low
+ * @endcode
  * 
  * @author Albano Peñalva
  *
@@ -16,6 +32,7 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 20/11/2023 | Document creation		                         						|
+ * | 19/10/2026 | Several bundles, input and bidirectional bundles, masked writes		|
  * 
  **/
 
@@ -23,28 +40,92 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include "gpio_mcu.h"
+#include "hal/dedic_gpio_cpu_ll.h"
 /*==================[macros]=================================================*/
-
+#define GPIO_FAST_CHANNELS	8	/*!< Dedicated GPIO channels of the CPU (for each direction) */
 /*==================[typedef]================================================*/
+/**
+ * @brief Bundle direction
+ */
+typedef enum {
+	GPIO_FAST_OUTPUT,	/*!< Push-pull outputs */
+	GPIO_FAST_INPUT,	/*!< Inputs with pull-up resistor */
+	GPIO_FAST_IN_OUT	/*!< Open-drain outputs with pull-up resistor, their levels can be read (e.g. bidirectional data lines) */
+} gpio_fast_mode_t;
 
+/**
+ * @brief Bundle of dedicated GPIOs (fields are set by GPIOFastInit())
+ */
+typedef struct {
+	void *handle;		/*!< Dedicated GPIO bundle */
+	uint8_t pin_qty;	/*!< Number of pins */
+	uint8_t out_shift;	/*!< First output channel */
+	uint8_t in_shift;	/*!< First input channel */
+	uint32_t out_mask;	/*!< Output channels of the bundle */
+	uint32_t in_mask;	/*!< Input channels of the bundle */
+} gpio_fast_t;
 /*==================[external data declaration]==============================*/
 
 /*==================[external functions declaration]=========================*/
 
 /**
- * @brief 
+ * @brief Create a bundle
+ * 
+ * @param bundle Bundle to initialize
+ * @param pin_list Pins of the bundle (pin_list[0] is bit 0)
+ * @param pin_qty Number of pins (up to GPIO_FAST_CHANNELS)
+ * @param mode Direction of the pins
+ * @return true if the bundle was created, false if there aren't enough free channels
+ */
+bool GPIOFastInit(gpio_fast_t *bundle, const gpio_t *pin_list, uint8_t pin_qty, gpio_fast_mode_t mode);
+
+/**
+ * @brief Release the channels of a bundle
+ * 
+ * @param bundle Bundle
+ */
+void GPIOFastDeinit(gpio_fast_t *bundle);
+
+/**
+ * @brief Change the state of some pins of an output bundle
+ * 
+ * @param bundle Output or bidirectional bundle
+ * @param mask Pins to change
+ * @param value New state of the pins in mask
+ */
+static inline __attribute__((always_inline)) void GPIOFastWriteMask(const gpio_fast_t *bundle, uint32_t mask, uint32_t value){
+	dedic_gpio_cpu_ll_write_mask((mask << bundle->out_shift) & bundle->out_mask, value << bundle->out_shift);
+}
+
+/**
+ * @brief Change the state of every pin of an output bundle
+ * 
+ * @param bundle Output or bidirectional bundle
+ * @param value New state of the pins
+ */
+static inline __attribute__((always_inline)) void GPIOFastWrite(const gpio_fast_t *bundle, uint32_t value){
+	dedic_gpio_cpu_ll_write_mask(bundle->out_mask, value << bundle->out_shift);
+}
+
+/**
+ * @brief Read the levels of an input bundle
  * 
- * @param pin_list 
- * @param pin_qty 
+ * @param bundle Input or bidirectional bundle
+ * @return uint32_t Pin levels
  */
-void GPIOFastInit(gpio_t *pin_list, uint8_t pin_qty);
+static inline __attribute__((always_inline)) uint32_t GPIOFastRead(const gpio_fast_t *bundle){
+	return (dedic_gpio_cpu_ll_read_in() & bundle->in_mask) >> bundle->in_shift;
+}
 
 /**
- * @brief 
+ * @brief Read the last state written to an output bundle
  * 
- * @param value 
+ * @param bundle Output or bidirectional bundle
+ * @return uint32_t Output states
  */
-void GPIOFastWrite(uint16_t value);
+static inline __attribute__((always_inline)) uint32_t GPIOFastReadOut(const gpio_fast_t *bundle){
+	return (dedic_gpio_cpu_ll_read_out() & bundle->out_mask) >> bundle->out_shift;
+}
 
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
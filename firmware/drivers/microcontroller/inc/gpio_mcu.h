@@ -26,6 +26,8 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 23/10/2023 | Document creation		                         						|
+ * | 19/10/2026 | Interruptions on both edges		                 						|
+ * | 19/10/2026 | Masked read/write of several GPIOs in one register access				|
  * 
  **/
 
@@ -33,6 +35,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 /*==================[macros]=================================================*/
+#define GPIO_MASK(pin)	(1UL << (pin))		/*!< Bit of a GPIO in GPIOWriteMask() and GPIOReadAll() masks */
 
 /*==================[typedef]================================================*/
 /**
@@ -124,6 +127,27 @@ void GPIOToggle(gpio_t pin);
  */
 bool GPIORead(gpio_t pin);
 
+/**
+ * @brief Set and clear several GPIOs at once
+ * 
+ * Each mask is written to the GPIO set/clear registers in a single access, so
+ * every GPIO in a mask changes at the same time and GPIOs that aren't in the
+ * masks aren't modified (safe to use from several tasks on different pins).
+ * 
+ * e.g. GPIOWriteMask(GPIO_MASK(GPIO_5), GPIO_MASK(GPIO_10) | GPIO_MASK(GPIO_11))
+ * 
+ * @param set_mask GPIOs to change to high
+ * @param clear_mask GPIOs to change to low
+ */
+void GPIOWriteMask(uint32_t set_mask, uint32_t clear_mask);
+
+/**
+ * @brief Reads every GPIO input in one access
+ * 
+ * @return uint32_t GPIO levels (bit GPIO_MASK(pin) set: GPIO input high)
+ */
+uint32_t GPIOReadAll(void);
+
 /**
  * @brief Configure GPIO input interruption
  * 
@@ -134,6 +158,22 @@ bool GPIORead(gpio_t pin);
  */
 void GPIOActivInt(gpio_t pin, void *ptr_int_func, bool edge, void *args);
 
+/**
+ * @brief Configure GPIO input interruption on both edges
+ * 
+ * @param pin GPIO number
+ * @param ptr_int_func Pointer to callback function
+ * @param args Pointer to callback function parameters
+ */
+void GPIOActivIntAnyEdge(gpio_t pin, void *ptr_int_func, void *args);
+
+/**
+ * @brief Disable GPIO input interruption and remove its callback function
+ * 
+ * @param pin GPIO number
+ */
+void GPIODeactivInt(gpio_t pin);
+
 /**
  * @brief Configure an input glitch filter to a GPIO
  * 
@@ -11,8 +11,14 @@
  *
  * This driver provide functions to generate PWM signals 
  *
- * @note It can setup up to 4 PWM outputs, with independet duty 
- * cycle and frequency configuration
+ * @note It can setup up to 6 PWM outputs, with independet duty cycle. Outputs
+ * with the same frequency share one of the 4 hardware timers, so up to 4
+ * different frequencies can be used at the same time.
+ *
+ * The duty cycle resolution is chosen from the frequency (up to 14 bits, e.g.
+ * 16384 steps at 50 Hz or 1000 Hz, 1024 steps at 40 kHz). Duty cycle can be
+ * set in %, per mille or timer ticks (PWMGetMaxTicks()), and changed
+ * gradually by the hardware with PWMFade().
  *
  * @author Albano Peñalva
  * 
@@ -21,6 +27,8 @@
  * |   Date	    | Description                                    |
  * |:----------:|:-----------------------------------------------|
  * | 23/01/2024 | Document creation		                         |
+ * | 19/10/2026 | Timers shared by frequency, duty in per mille  |
+ * |            | or ticks, hardware fades                       |
  *
  */
 
@@ -28,14 +36,21 @@
 #include <stdint.h>
 #include <gpio_mcu.h>
 /*==================[macros]=================================================*/
-
+#define PWM_DUTY_PERMILLE_MAX	1000	/*!< 100 % duty cycle in per mille */
 /*==================[typedef]================================================*/
 typedef enum pwm_out {
 	PWM_0,      /**< PWM output 1 */
 	PWM_1,		/**< PWM output 2 */
 	PWM_2,		/**< PWM output 3 */
-	PWM_3		/**< PWM output 4 */
+	PWM_3,		/**< PWM output 4 */
+	PWM_4,		/**< PWM output 5 */
+	PWM_5		/**< PWM output 6 */
 } pwm_out_t;
+
+/**
+ * @brief Fade end callback function (called from an ISR)
+ */
+typedef void (*pwm_fade_func_t)(pwm_out_t out, void *param_p);
 /*==================[internal data declaration]==============================*/
 
 /*==================[internal functions declaration]=========================*/
@@ -48,7 +63,7 @@ typedef enum pwm_out {
  * @param out PWM output
  * @param gpio GPIO pin number
  * @param freq PWM wave frequency
- * @return uint8_t 
+ * @return uint8_t 0: ok, 1: no free timer for this frequency
  */
 uint8_t PWMInit(pwm_out_t out, gpio_t gpio, uint16_t freq);
 
@@ -60,8 +75,9 @@ uint8_t PWMInit(pwm_out_t out, gpio_t gpio, uint16_t freq);
 void PWMOn(pwm_out_t out);
 
 /**
- * @brief Pause PWM output
+ * @brief Pause PWM output (output low)
  * 
+ * @note Duty cycle changes while paused are applied by PWMOn().
  * @param out PWM output 
  */
 void PWMOff(pwm_out_t out);
@@ -74,12 +90,51 @@ void PWMOff(pwm_out_t out);
  */
 void PWMSetDutyCycle(pwm_out_t out, uint8_t duty_cycle);
 
+/**
+ * @brief Change PWM duty cycle of an PWM output
+ * 
+ * @param out PWM output 
+ * @param duty duty cycle in per mille (0 to PWM_DUTY_PERMILLE_MAX)
+ */
+void PWMSetDutyPermille(pwm_out_t out, uint16_t duty);
+
+/**
+ * @brief Change PWM duty cycle of an PWM output
+ * 
+ * @param out PWM output 
+ * @param ticks high time in timer ticks (0 to PWMGetMaxTicks())
+ */
+void PWMSetDutyTicks(pwm_out_t out, uint32_t ticks);
+
+/**
+ * @brief Timer ticks in a PWM period (duty cycle resolution)
+ * 
+ * @note It changes with the frequency.
+ * @param out PWM output 
+ * @return uint32_t Ticks for 100 % duty cycle
+ */
+uint32_t PWMGetMaxTicks(pwm_out_t out);
+
+/**
+ * @brief Change duty cycle gradually, without CPU intervention
+ * 
+ * @note The output is turned on. A new duty cycle or fade stops the fade in progress.
+ * @param out PWM output 
+ * @param duty Final duty cycle in per mille (0 to PWM_DUTY_PERMILLE_MAX)
+ * @param time_ms Fade duration
+ * @param func_p Function called when the fade ends (NULL: none)
+ * @param param_p Parameter of func_p
+ * @return uint8_t 0: ok, 1: output not initialized
+ */
+uint8_t PWMFade(pwm_out_t out, uint16_t duty, uint32_t time_ms, pwm_fade_func_t func_p, void *param_p);
+
 /**
  * @brief Change frequency of an PWM output
  * 
+ * @note The duty cycle (in %) is kept.
  * @param out PWM output 
  * @param freq Frequency of PWM output (40kHz máx)
- * @return uint8_t 
+ * @return uint8_t 0: ok, 1: no free timer for this frequency
  */
 uint8_t PWMSetFreq(pwm_out_t out, uint32_t freq);
 
@@ -17,13 +17,18 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 02/07/2024 | Document creation		                         						|
+ * | 19/10/2026 | Configurable buffers and zero-copy transmission                        |
+ * | 19/10/2026 | Frame reception (terminator or idle line)                              |
+ * | 19/10/2026 | UartItoa() uses a buffer per task                                      |
  * 
  **/
 
 /*==================[inclusions]=============================================*/
 #include "stdint.h"
+#include "stdbool.h"
 /*==================[macros]=================================================*/
 #define UART_NO_INT	0		/*!< Flag used when no reading interruption is required */
+#define UART_FRAME_MAX_TERMINATOR	4	/*!< Max repetitions of the frame terminator */
 /*==================[typedef]================================================*/
 /**
  * @brief List of UART ports available in ESP-EDU
@@ -32,6 +37,22 @@ typedef enum uart_ports{
 	UART_PC,				/*!< UART connected PC through USB port (indicated with UART) (also maped to TX: GPIO16, RX: GPIO17) */
 	UART_CONNECTOR,			/*!< UART connected to J2 connector (TX: GPIO18, RX: GPIO19) */
 } uart_mcu_port_t;
+/**
+ * @brief Frame reception configuration
+ * 
+ * With terminator_count > 0 a frame ends with terminator_count consecutive
+ * terminator characters (detected by the UART hardware), otherwise a frame
+ * ends when the line stays idle for idle_symbols characters.
+ */
+typedef struct {
+	char terminator;			/*!< Frame terminator character (e.g. '\n') */
+	uint8_t terminator_count;	/*!< Repetitions of terminator (0: idle line framing) */
+	uint8_t idle_symbols;		/*!< Idle time ending a frame, in characters (0: default, 10) */
+	uint16_t max_frame;			/*!< Max frame length (0: default, 256), longer frames are dropped */
+	void (*frame_p)(const uint8_t *frame, uint16_t len, void *param);	/*!< Called with each frame (without terminator), frame is valid until it returns */
+	void *param_p;				/*!< frame_p parameter */
+} uart_frame_config_t;
+
 /**
  * @brief Serial port configuration struct
  */
@@ -40,6 +61,10 @@ typedef struct {
 	uint32_t baud_rate;		/*!< baudrate (bits per second) */
 	void *func_p;			/*!< Pointer to callback function to call when receiving data (= UART_NO_INT if not requiered)*/
 	void *param_p;			/*!< Pointer to callback function parameters */
+	uint32_t rx_buffer_size;	/*!< RX ring buffer size in bytes (0: default, 256) */
+	uint32_t tx_buffer_size;	/*!< TX ring buffer size in bytes (0: default, 256, or no ring buffer if tx_queue_size > 0) */
+	uint8_t tx_queue_size;		/*!< Buffers that can wait in UartSendOwned() (0: UartSendOwned() not used) */
+	const uart_frame_config_t *frame_config;	/*!< Frame reception (NULL if not required), replaces func_p for received data */
 } serial_config_t;
 /*==================[external data declaration]==============================*/
 
@@ -95,11 +120,48 @@ void UartSendString(uart_mcu_port_t port, const char *msg);
  * @param data Pointer to array of data to be transmitted
  * @param nbytes Number of bytes to be sended
  */
-void UartSendBuffer(uart_mcu_port_t port, const char *data, uint8_t nbytes);
+void UartSendBuffer(uart_mcu_port_t port, const char *data, uint32_t nbytes);
+
+/**
+ * @brief Send a buffer without copying it
+ * 
+ * @note The driver owns the buffer until done_p is called (from the UART TX task).
+ * With tx_buffer_size = 0 data goes from the buffer straight to the UART FIFO.
+ * Requires tx_queue_size > 0 in UartInit().
+ * 
+ * @param port Port for sending data
+ * @param data Pointer to array of data to be transmitted
+ * @param nbytes Number of bytes to be sended
+ * @param done_p Function called when the buffer can be reused (NULL if not required)
+ * @param param_p done_p parameter
+ * @return true if the buffer was queued, false if the queue is full
+ */
+bool UartSendOwned(uart_mcu_port_t port, const uint8_t *data, uint32_t nbytes,
+                   void (*done_p)(const uint8_t *data, void *param), void *param_p);
+
+/**
+ * @brief Get the number of received frames lost (too long or buffer overflow)
+ * 
+ * @param port Port
+ * @return uint32_t Frames lost
+ */
+uint32_t UartFrameErrors(uart_mcu_port_t port);
+
+/**
+ * @brief Wait until all data has been sent
+ * 
+ * @param port Port to wait for
+ * @param timeout_ms Max wait
+ * @return true if all data was sent
+ */
+bool UartWaitTxDone(uart_mcu_port_t port, uint32_t timeout_ms);
 
 /**
  * @brief Convert a number to a String (char array ended with '\0')
  * 
+ * @note The string is valid until the same task calls UartItoa() again.
+ * For caller supplied buffers, fixed point and float numbers see "format_mcu.h".
+ * 
  * @param val Number to be converted
  * @param base Base of the converted number (2: binary, 10: decimal, 16: hexadecimal)
  * @return uint8_t* 
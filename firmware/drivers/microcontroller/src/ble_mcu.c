@@ -12,30 +12,43 @@
 /*==================[inclusions]=============================================*/
 #include "ble_mcu.h"
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "nvs_flash.h"
 
 #include "esp_log.h"
+#include "esp_timer.h"
 
 #include "esp_bt.h"
 #include "esp_gap_ble_api.h"
 #include "esp_gatts_api.h"
 #include "esp_bt_defs.h"
 #include "esp_bt_main.h"
+#include "esp_gatt_common_api.h"
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/queue.h"
+#include "freertos/semphr.h"
 /*==================[macros and definitions]=================================*/
 #define TAG "ble_mcu"
-#define MTU_MAX_BYTES		20	 /* GATT Maximum Transmission Unit */
-#define PAYLOAD_SIZE        128  /* Maximun number of bytes transmitted in one transaction */
+#define ATT_HEADER_BYTES	3	 /* Opcode and handle of each notification */
+#define DLE_TX_BYTES		251	 /* Max link layer payload with Data Length Extension */
+#define PAYLOAD_SIZE        (BLE_MTU_MAX - ATT_HEADER_BYTES)  /* Maximun number of bytes transmitted in one transaction */
 #define SPP_PROFILE_NUM     1       
 #define SPP_PROFILE_APP_IDX 0
 #define ESP_SPP_APP_ID      0x56
 #define SPP_SVC_INST_ID     0
-#define SPP_DATA_MAX_LEN    (128) /* Maximun number of bytes transmitted in one transaction */
+#define SPP_DATA_MAX_LEN    PAYLOAD_SIZE /* Maximun number of bytes transmitted in one transaction */
+#define TX_BUFFER_SIZE      4096    /* Default size of the transmission ring */
+#define RECORD_HEADER       8       /* Time (4 bytes), length and attribute handle (2 bytes) of each message in the ring */
+#define RX_QUEUE_SIZE       10      /* Messages waiting to be read */
+#define CHARS_SVC_INST_ID   1       /* Service of the characteristics added with BleAddCharacteristic() */
+#define CHARS_SVC_UUID      0xFFF0  /* Default UUID of that service */
+#define SPP_MSG_ID          0xFF    /* Received message id for the SPP characteristic */
+#define PHY_ALL_MASK        (ESP_BLE_GAP_PHY_1M_PREF_MASK | ESP_BLE_GAP_PHY_2M_PREF_MASK)
+#define THROUGHPUT_WINDOW   1000000 /* Time to measure throughput (us) */
 /* List of attributes to be added to the service database */
 enum{
     SPP_IDX_SVC,
@@ -53,28 +66,79 @@ enum{
 #define ADV_CONFIG_FLAG			                (1 << 0)
 #define SCAN_RSP_CONFIG_FLAG	                (1 << 1)
 /*==================[typedef]================================================*/
-/* Commands for handling Bluetooth events */
-typedef enum {
-    CMD_BLUETOOTH_CONNECT,       /* bt connection */
-    CMD_BLUETOOTH_AUTH,          /* device authentification */
-    CMD_BLUETOOTH_DATA,          /* data reception */
-    CMD_BLUETOOTH_DISCONNECT,    /* device disconnection */
-    CMD_SEND_DATA,               /* data transmission */
-} comd_bt_ev_t;
-/* Struct used to handle Bluetooth events */
+/* Header of each message stored in the transmission ring */
 typedef struct {
-	uint16_t spp_conn_id;
-	esp_gatt_if_t spp_gatts_if;
-	uint16_t command;
-	size_t length;
-	uint8_t payload[PAYLOAD_SIZE];
-	TaskHandle_t taskHandle;
-} CMD_t;
+	uint32_t time;		/* Time when the message was queued (us) */
+	uint16_t length;	/* Number of bytes */
+	uint16_t handle;	/* Attribute handle of the characteristic */
+} ble_record_t;
+/* Received message passed by reference (only the pointer goes through the queue) */
+typedef struct {
+	uint16_t length;	/* Number of bytes */
+	uint8_t id;			/* Characteristic written (SPP_MSG_ID for the SPP one) */
+	uint8_t data[];		/* Message bytes */
+} ble_msg_t;
+/* Connection and advertising parameters of each profile */
+typedef struct {
+	uint16_t adv_int_min;		/* Advertising interval (x 0.625 ms) */
+	uint16_t adv_int_max;
+	uint16_t conn_int_min;		/* Connection interval (x 1.25 ms) */
+	uint16_t conn_int_max;
+	uint16_t latency;			/* Connection events the peripheral can skip */
+	uint16_t timeout;			/* Supervision timeout (x 10 ms) */
+	uint8_t phy_mask;			/* Preferred PHYs */
+} ble_profile_params_t;
+/* Characteristic added with BleAddCharacteristic() */
+typedef struct {
+	ble_char_config_t config;	/* Configuration given by the application */
+	uint8_t properties;			/* GATT properties (declaration value) */
+	uint16_t cccd;				/* Client Characteristic Configuration value */
+	uint8_t *value;				/* Value for automatic read responses */
+	uint8_t attr;				/* Index of the declaration in the attribute table */
+	uint16_t value_handle;		/* Handle of the value attribute */
+	uint16_t cccd_handle;		/* Handle of the CCCD (0 if not notifiable) */
+	bool subscribed;			/* The client enabled notifications */
+	TickType_t period;			/* Notification period (ticks) */
+	TickType_t next;			/* Tick of the next periodic notification */
+} ble_char_t;
 /*==================[internal data declaration]==============================*/
 char * device_name; /* Device name */
 void (*ble_read_isr_p)(uint8_t * data, uint8_t length);  /* Pointer to callback function for reading data */
 ble_status_t status = BLE_OFF;
 static uint16_t spp_handle_table[SPP_IDX_NB];   /* Service database table */
+static uint16_t mtu = ESP_GATT_DEF_BLE_MTU_SIZE;	/* Negotiated ATT MTU */
+static uint16_t spp_conn_id = 0xffff;			/* Connection id */
+static esp_gatt_if_t spp_gatts_if = ESP_GATT_IF_NONE;	/* GATT interface of the connection */
+static ble_stats_t stats;						/* Transmission statistics */
+static uint64_t latency_sum = 0;				/* Sum of latencies, for the average */
+static uint8_t *tx_ring = NULL;					/* Transmission ring: records with header and data */
+static uint32_t tx_ring_size;					/* Size of the transmission ring */
+static uint32_t tx_tail = 0;					/* Position of the oldest record */
+static uint32_t tx_used = 0;					/* Bytes used in the ring */
+static uint16_t tx_sent = 0;					/* Bytes of the oldest record already sent */
+static uint32_t tx_discards = 0;				/* Times records were discarded by senders or disconnection */
+static uint8_t tx_chunk[PAYLOAD_SIZE];			/* Notification being sent */
+static ble_tx_policy_t tx_policy;				/* What to do when the ring is full */
+static bool congested = false;					/* Controller buffers full, waiting */
+static uint32_t batch_us = 0;					/* Max time to wait for more data to fill a notification (0: no batching) */
+static SemaphoreHandle_t tx_mutex = NULL;		/* Protects the ring and the statistics */
+static SemaphoreHandle_t tx_space = NULL;		/* Given when space is freed in the ring */
+static TaskHandle_t tx_task_handle = NULL;
+static ble_char_t chars[BLE_MAX_CHARS];		/* Characteristics added with BleAddCharacteristic() */
+static uint8_t chars_qty = 0;					/* Number of characteristics */
+static uint8_t chars_attrs = 1;					/* Attributes of their service (declaration included) */
+static uint16_t chars_service_uuid = CHARS_SVC_UUID;
+static TaskHandle_t notify_task_handle = NULL;
+static ble_profile_t profile = BLE_PROFILE_DEFAULT;	/* Connection and power profile */
+static esp_bd_addr_t remote_bda;				/* Address of the connected device */
+static ble_link_t link_info;					/* Current connection parameters */
+static uint32_t window_start = 0;				/* Start of the throughput measurement (us) */
+static uint8_t *prep_buf = NULL;				/* Value of a long (prepared) write being received */
+static uint16_t prep_handle = 0;				/* Attribute of the long write */
+static uint16_t prep_len = 0;					/* Bytes of the long write received */
+static bool ble_init = false;					/* BleInit() called, the characteristics table is built */
+static volatile bool link_up = false;			/* Link established (status is BLE_CONNECTED only after authentication) */
+static uint32_t window_bytes = 0;				/* Bytes sent since window_start */
 /* GATT profile struct */
 struct gatts_profile_inst {
 	esp_gatts_cb_t gatts_cb;
@@ -90,13 +154,22 @@ struct gatts_profile_inst {
 	uint16_t descr_handle;
 	esp_bt_uuid_t descr_uuid;
 };
-QueueHandle_t xQueueEvents = NULL;  /* Queue for handling Bluettoth events */
 QueueHandle_t xQueueRead = NULL;    /* Queue for handling received data */
 
 /*==================[internal functions declaration]=========================*/
 static void gatts_profile_event_handler(esp_gatts_cb_event_t event,
 										esp_gatt_if_t gatts_if, esp_ble_gatts_cb_param_t *param);
 /*==================[internal data definition]===============================*/
+static const ble_profile_params_t profiles[] = {
+	/* 20-40 ms advertising, 7.5-20 ms interval */
+	[BLE_PROFILE_DEFAULT]		= {0x20, 0x40, 0x06, 0x10, 0, 400, PHY_ALL_MASK},
+	/* 20-40 ms advertising, 7.5 ms interval, 2M PHY */
+	[BLE_PROFILE_LOW_LATENCY]	= {0x20, 0x40, 0x06, 0x06, 0, 200, ESP_BLE_GAP_PHY_2M_PREF_MASK},
+	/* 20-40 ms advertising, 15-30 ms interval (more packets per connection event), 2M PHY */
+	[BLE_PROFILE_THROUGHPUT]	= {0x20, 0x40, 0x0C, 0x18, 0, 400, ESP_BLE_GAP_PHY_2M_PREF_MASK},
+	/* 1-1.5 s advertising, 100-200 ms interval, 4 events skipped when idle, 1M PHY */
+	[BLE_PROFILE_LOW_POWER]		= {0x640, 0x960, 0x50, 0xA0, 4, 600, ESP_BLE_GAP_PHY_1M_PREF_MASK},
+};
 static const uint16_t spp_service_uuid = ESP_GATT_UUID_SPP_SERVICE; /* Service ID */
 /* Advertising data */
 static const uint8_t spp_adv_data[23] = {
@@ -197,8 +270,347 @@ static const esp_gatts_attr_db_t spp_gatt_db[SPP_IDX_NB] = {
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+static ble_msg_t * BleMsgNew(const uint8_t *data, uint16_t length, uint8_t id){
+	ble_msg_t *msg = malloc(sizeof(ble_msg_t) + length);
+	if(msg != NULL){
+		msg->length = length;
+		msg->id = id;
+		memcpy(msg->data, data, length);
+	}
+	return msg;
+}
+
+/* Copy to/from the ring, wrapping around its end (pos < 2 * tx_ring_size) */
+static void BleRingWrite(uint32_t pos, const void *src, uint32_t len){
+	uint32_t first;
+	pos %= tx_ring_size;
+	first = (len < tx_ring_size - pos) ? len : tx_ring_size - pos;
+	memcpy(&tx_ring[pos], src, first);
+	memcpy(tx_ring, (const uint8_t *)src + first, len - first);
+}
+
+static void BleRingRead(uint32_t pos, void *dst, uint32_t len){
+	uint32_t first;
+	pos %= tx_ring_size;
+	first = (len < tx_ring_size - pos) ? len : tx_ring_size - pos;
+	memcpy(dst, &tx_ring[pos], first);
+	memcpy((uint8_t *)dst + first, tx_ring, len - first);
+}
+
+static void BleRingHeader(uint32_t pos, ble_record_t *rec){
+	uint8_t header[RECORD_HEADER];
+	BleRingRead(pos, header, RECORD_HEADER);
+	memcpy(&rec->time, header, 4);
+	memcpy(&rec->length, &header[4], 2);
+	memcpy(&rec->handle, &header[6], 2);
+}
+
+/* Discard the oldest record, called with the mutex taken */
+static void BleRingDrop(void){
+	ble_record_t rec;
+	BleRingHeader(tx_tail, &rec);
+	tx_tail = (tx_tail + RECORD_HEADER + rec.length) % tx_ring_size;
+	tx_used -= RECORD_HEADER + rec.length;
+	tx_sent = 0;
+}
+
+/* Remove sent bytes from the oldest records, called with the mutex taken */
+static void BleRingConsume(uint16_t bytes, bool whole){
+	ble_record_t rec;
+	uint16_t n;
+	uint32_t latency;
+
+	while(bytes > 0 && tx_used > 0){
+		BleRingHeader(tx_tail, &rec);
+		n = rec.length - tx_sent;
+		if(n > bytes && !whole){
+			tx_sent += bytes;
+			return;
+		}
+		/* Message completely sent (a whole record can be truncated to the MTU) */
+		bytes = (n > bytes) ? 0 : bytes - n;
+		BleRingDrop();
+		latency = (uint32_t)esp_timer_get_time() - rec.time;
+		stats.messages++;
+		stats.latency_last_us = latency;
+		if(latency > stats.latency_max_us){
+			stats.latency_max_us = latency;
+		}
+		latency_sum += latency;
+		xSemaphoreGive(tx_space);
+	}
+}
+
+static void BleQueueSend(uint16_t handle, const uint8_t *data, uint16_t length){
+	uint8_t header[RECORD_HEADER];
+	uint32_t time;
+	uint32_t need = RECORD_HEADER + length;
+
+	if(status != BLE_CONNECTED || length == 0){
+		return;
+	}
+	xSemaphoreTake(tx_mutex, portMAX_DELAY);
+	if(need > tx_ring_size){
+		stats.dropped++;
+		xSemaphoreGive(tx_mutex);
+		return;
+	}
+	while(tx_ring_size - tx_used < need){
+		if(tx_policy == BLE_TX_DROP_OLDEST){
+			BleRingDrop();
+			tx_discards++;
+			stats.dropped++;
+		}else{
+			/* Wait until the transmission task frees space (or disconnection) */
+			xSemaphoreGive(tx_mutex);
+			xSemaphoreTake(tx_space, portMAX_DELAY);
+			if(status != BLE_CONNECTED){
+				/* Pass the wake up on to the next blocked sender */
+				xSemaphoreGive(tx_space);
+				return;
+			}
+			xSemaphoreTake(tx_mutex, portMAX_DELAY);
+		}
+	}
+	time = esp_timer_get_time();
+	memcpy(header, &time, 4);
+	memcpy(&header[4], &length, 2);
+	memcpy(&header[6], &handle, 2);
+	BleRingWrite(tx_tail + tx_used, header, RECORD_HEADER);
+	BleRingWrite(tx_tail + tx_used + RECORD_HEADER, data, length);
+	tx_used += need;
+	xSemaphoreGive(tx_mutex);
+	xTaskNotifyGive(tx_task_handle);
+}
+
+/* Discard pending data and release blocked senders (each one woken gives
+ * tx_space again, so all of them return, not only the first) */
+static void BleTxFlush(void){
+	xSemaphoreTake(tx_mutex, portMAX_DELAY);
+	tx_tail = 0;
+	tx_used = 0;
+	tx_sent = 0;
+	tx_discards++;
+	congested = false;
+	xSemaphoreGive(tx_mutex);
+	xSemaphoreGive(tx_space);
+}
+
+static ble_char_t * BleCharFind(uint16_t handle){
+	for(uint8_t i = 0; i < chars_qty; i++){
+		if(handle == chars[i].value_handle || (handle == chars[i].cccd_handle && handle != 0)){
+			return &chars[i];
+		}
+	}
+	return NULL;
+}
+
+/* Create the service with the characteristics added with BleAddCharacteristic() */
+static void BleCharsCreate(esp_gatt_if_t gatts_if){
+	esp_gatts_attr_db_t *db;
+	ble_char_t *ch;
+	uint8_t n = 0;
+	uint16_t perm;
+
+	db = calloc(chars_attrs, sizeof(esp_gatts_attr_db_t));
+	if(db == NULL){
+		ESP_LOGE(TAG, "No memory for the characteristics table");
+		return;
+	}
+	db[n++] = (esp_gatts_attr_db_t){{ESP_GATT_AUTO_RSP}, {ESP_UUID_LEN_16, (uint8_t *)&primary_service_uuid, ESP_GATT_PERM_READ,
+		sizeof(chars_service_uuid), sizeof(chars_service_uuid), (uint8_t *)&chars_service_uuid}};
+	for(uint8_t i = 0; i < chars_qty; i++){
+		ch = &chars[i];
+		ch->attr = n;
+		perm = ((ch->config.properties & BLE_CHAR_READ) ? ESP_GATT_PERM_READ : 0) |
+			((ch->config.properties & BLE_CHAR_WRITE) ? ESP_GATT_PERM_WRITE : 0);
+		db[n++] = (esp_gatts_attr_db_t){{ESP_GATT_AUTO_RSP}, {ESP_UUID_LEN_16, (uint8_t *)&character_declaration_uuid, ESP_GATT_PERM_READ,
+			sizeof(uint8_t), sizeof(uint8_t), &ch->properties}};
+		/* Values with a read function are answered by the application */
+		db[n++] = (esp_gatts_attr_db_t){{(ch->config.read_p != NULL) ? ESP_GATT_RSP_BY_APP : ESP_GATT_AUTO_RSP},
+			{ESP_UUID_LEN_16, (uint8_t *)&ch->config.uuid, perm, ch->config.max_length, 0, ch->value}};
+		if(ch->config.properties & BLE_CHAR_NOTIFY){
+			db[n++] = (esp_gatts_attr_db_t){{ESP_GATT_AUTO_RSP}, {ESP_UUID_LEN_16, (uint8_t *)&character_client_config_uuid,
+				ESP_GATT_PERM_READ | ESP_GATT_PERM_WRITE, sizeof(uint16_t), sizeof(uint16_t), (uint8_t *)&ch->cccd}};
+		}
+		if(ch->config.description != NULL){
+			db[n++] = (esp_gatts_attr_db_t){{ESP_GATT_AUTO_RSP}, {ESP_UUID_LEN_16, (uint8_t *)&character_description_uuid, ESP_GATT_PERM_READ,
+				strlen(ch->config.description), strlen(ch->config.description), (uint8_t *)ch->config.description}};
+		}
+	}
+	/* The stack copies the table */
+	esp_ble_gatts_create_attr_tab(db, gatts_if, n, CHARS_SVC_INST_ID);
+	free(db);
+}
+
+static void BleCharsStart(const uint16_t *handles, uint16_t num_handle){
+	ble_char_t *ch;
+	if(num_handle != chars_attrs){
+		ESP_LOGE(TAG, "Characteristics table created with %d handles instead of %d", num_handle, chars_attrs);
+		return;
+	}
+	for(uint8_t i = 0; i < chars_qty; i++){
+		ch = &chars[i];
+		ch->value_handle = handles[ch->attr + 1];
+		ch->cccd_handle = (ch->config.properties & BLE_CHAR_NOTIFY) ? handles[ch->attr + 2] : 0;
+	}
+	esp_ble_gatts_start_service(handles[0]);
+}
+
+/* Answer a read of a characteristic with read function */
+static void BleCharRead(ble_char_t *ch, esp_gatt_if_t gatts_if, esp_ble_gatts_cb_param_t *param){
+	static esp_gatt_rsp_t rsp;
+	uint16_t len;
+
+	memset(&rsp, 0, sizeof(rsp));
+	len = ch->config.read_p(rsp.attr_value.value, ch->config.max_length, ch->config.param_p);
+	if(param->read.offset > len){
+		esp_ble_gatts_send_response(gatts_if, param->read.conn_id, param->read.trans_id, ESP_GATT_INVALID_OFFSET, NULL);
+		return;
+	}
+	/* Long reads ask for the value from an offset */
+	len -= param->read.offset;
+	memmove(rsp.attr_value.value, &rsp.attr_value.value[param->read.offset], len);
+	rsp.attr_value.handle = param->read.handle;
+	rsp.attr_value.offset = param->read.offset;
+	rsp.attr_value.len = len;
+	esp_ble_gatts_send_response(gatts_if, param->read.conn_id, param->read.trans_id, ESP_GATT_OK, &rsp);
+}
+
+/* Client Characteristic Configuration written: notifications enabled or disabled */
+static void BleCharSubscribe(ble_char_t *ch, const uint8_t *value, uint16_t len){
+	ch->subscribed = (len == sizeof(uint16_t)) && (value[0] & 0x01);
+	if(ch->subscribed && ch->period > 0){
+		ch->next = xTaskGetTickCount();
+		xTaskNotifyGive(notify_task_handle);
+	}
+}
+
+/* Pass a written value to the read task */
+static void BleWriteValue(uint16_t handle, const uint8_t *value, uint16_t len){
+	ble_char_t *ch = BleCharFind(handle);
+	ble_msg_t *msg = NULL;
+
+	if(ch != NULL){
+		if(handle == ch->cccd_handle){
+			BleCharSubscribe(ch, value, len);
+		}else if(ch->config.write_p != NULL){
+			msg = BleMsgNew(value, len, ch - chars);
+		}
+	}else if(ble_read_isr_p != BLE_NO_INT){
+		msg = BleMsgNew(value, (len > PAYLOAD_SIZE) ? PAYLOAD_SIZE : len, SPP_MSG_ID);
+	}
+	if(msg != NULL && xQueueSend(xQueueRead, &msg, 0) != pdTRUE){
+		free(msg);
+	}
+}
+
+/* Store a fragment of a long write, the value is passed on execution */
+static esp_gatt_status_t BlePrepStore(esp_ble_gatts_cb_param_t *param){
+	ble_char_t *ch = BleCharFind(param->write.handle);
+	uint16_t max = (ch != NULL) ? ch->config.max_length : PAYLOAD_SIZE;
+
+	if(prep_buf == NULL){
+		prep_buf = malloc(ESP_GATT_MAX_ATTR_LEN);
+		if(prep_buf == NULL){
+			return ESP_GATT_NO_RESOURCES;
+		}
+		prep_handle = param->write.handle;
+		prep_len = 0;
+	}
+	if(param->write.handle != prep_handle){
+		/* Only one attribute per long write */
+		return ESP_GATT_REQ_NOT_SUPPORTED;
+	}
+	if(param->write.offset > max){
+		return ESP_GATT_INVALID_OFFSET;
+	}
+	if(param->write.offset + param->write.len > max){
+		return ESP_GATT_INVALID_ATTR_LEN;
+	}
+	memcpy(&prep_buf[param->write.offset], param->write.value, param->write.len);
+	if(param->write.offset + param->write.len > prep_len){
+		prep_len = param->write.offset + param->write.len;
+	}
+	return ESP_GATT_OK;
+}
+
+/* Prepare write: store the fragment and answer echoing it */
+static void BlePrepWrite(esp_gatt_if_t gatts_if, esp_ble_gatts_cb_param_t *param){
+	static esp_gatt_rsp_t rsp;
+	esp_gatt_status_t ret = BlePrepStore(param);
+
+	if(!param->write.need_rsp){
+		return;
+	}
+	memset(&rsp, 0, sizeof(rsp));
+	rsp.attr_value.handle = param->write.handle;
+	rsp.attr_value.offset = param->write.offset;
+	rsp.attr_value.len = param->write.len;
+	memcpy(rsp.attr_value.value, param->write.value, param->write.len);
+	esp_ble_gatts_send_response(gatts_if, param->write.conn_id, param->write.trans_id, ret, &rsp);
+}
+
+/* Long write executed or cancelled */
+static void BlePrepExec(bool exec){
+	if(prep_buf == NULL){
+		return;
+	}
+	if(exec){
+		BleWriteValue(prep_handle, prep_buf, prep_len);
+	}
+	free(prep_buf);
+	prep_buf = NULL;
+	prep_len = 0;
+}
+
+static void BleCharsDisconnect(void){
+	static const uint8_t cccd_off[2] = {0x00, 0x00};
+	for(uint8_t i = 0; i < chars_qty; i++){
+		chars[i].subscribed = false;
+		if(chars[i].cccd_handle != 0){
+			esp_ble_gatts_set_attr_value(chars[i].cccd_handle, sizeof(cccd_off), cccd_off);
+		}
+	}
+}
+
+/* Ask the central for the connection parameters and PHY of the profile */
+static void BleProfileConnection(void){
+	const ble_profile_params_t *params = &profiles[profile];
+	esp_ble_conn_update_params_t conn_params = {
+		.min_int = params->conn_int_min,
+		.max_int = params->conn_int_max,
+		.latency = params->latency,
+		.timeout = params->timeout,
+	};
+	memcpy(conn_params.bda, remote_bda, sizeof(esp_bd_addr_t));
+	esp_ble_gap_update_conn_params(&conn_params);
+#ifdef CONFIG_BT_BLE_50_FEATURES_SUPPORTED
+	esp_ble_gap_set_preferred_phy(remote_bda, 0, params->phy_mask, params->phy_mask, ESP_BLE_GAP_PHY_OPTIONS_NO_PREF);
+#endif
+}
+
+/* Advertising interval and connection interval hint of the profile */
+static void BleProfileAdvertising(void){
+	const ble_profile_params_t *params = &profiles[profile];
+	spp_adv_params.adv_int_min = params->adv_int_min;
+	spp_adv_params.adv_int_max = params->adv_int_max;
+	spp_adv_config.min_interval = params->conn_int_min;
+	spp_adv_config.max_interval = params->conn_int_max;
+}
+
+/* Throughput of the last THROUGHPUT_WINDOW, called with the mutex taken */
+static void BleThroughputUpdate(void){
+	uint32_t now = esp_timer_get_time();
+	uint32_t elapsed = now - window_start;
+	if(elapsed >= THROUGHPUT_WINDOW){
+		stats.throughput = (uint64_t)window_bytes * 1000000 / elapsed;
+		window_bytes = 0;
+		window_start = now;
+	}
+}
+
 static void gap_event_handler(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param) {
-	CMD_t cmdBuf;
 	static uint8_t adv_config_done = 0;
 	switch (event) {
 		case ESP_GAP_BLE_SCAN_RSP_DATA_SET_COMPLETE_EVT:
@@ -255,8 +667,11 @@ static void gap_event_handler(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param
 
 			break;
 		case ESP_GAP_BLE_AUTH_CMPL_EVT: {
-			cmdBuf.command = CMD_BLUETOOTH_AUTH;
-			xQueueSend(xQueueEvents, &cmdBuf, 0);
+			ESP_LOGI(TAG, "Device connected");
+			status = BLE_CONNECTED;
+			if(tx_task_handle != NULL){
+				xTaskNotifyGive(tx_task_handle);
+			}
 			break;
 	}
 	case ESP_GAP_BLE_REMOVE_BOND_DEV_COMPLETE_EVT: {
@@ -267,6 +682,41 @@ static void gap_event_handler(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param
 		ESP_LOGI(__FUNCTION__, "------------------------------------");
 		break;
 	}
+	case ESP_GAP_BLE_SET_PKT_LENGTH_COMPLETE_EVT:
+		ESP_LOGI(TAG, "Data length: tx %d, rx %d bytes", param->pkt_data_length_cmpl.params.tx_len,
+			param->pkt_data_length_cmpl.params.rx_len);
+		if(param->pkt_data_length_cmpl.status == ESP_BT_STATUS_SUCCESS){
+			link_info.data_length = param->pkt_data_length_cmpl.params.tx_len;
+		}
+		break;
+#ifdef CONFIG_BT_BLE_50_FEATURES_SUPPORTED
+	case ESP_GAP_BLE_PHY_UPDATE_COMPLETE_EVT:
+		ESP_LOGI(TAG, "PHY: tx %dM, rx %dM", param->phy_update.tx_phy, param->phy_update.rx_phy);
+		if(param->phy_update.status == ESP_BT_STATUS_SUCCESS){
+			link_info.phy = param->phy_update.tx_phy;
+		}
+		break;
+#endif
+	case ESP_GAP_BLE_UPDATE_CONN_PARAMS_EVT:
+		ESP_LOGI(TAG, "Connection interval: %d x 1.25 ms, latency %d, timeout %d x 10 ms", param->update_conn_params.conn_int,
+			param->update_conn_params.latency, param->update_conn_params.timeout);
+		if(param->update_conn_params.status == ESP_BT_STATUS_SUCCESS){
+			link_info.interval_us = param->update_conn_params.conn_int * 1250;
+			link_info.latency = param->update_conn_params.latency;
+			link_info.timeout_ms = param->update_conn_params.timeout * 10;
+		}
+		break;
+	case ESP_GAP_BLE_ADV_STOP_COMPLETE_EVT:
+		/* Advertising stopped to change the profile: the connection interval
+		 * hint is in the advertising data, advertising restarts when it is set */
+		if(status == BLE_DISCONNECTED && !link_up){
+			if(esp_ble_gap_config_adv_data(&spp_adv_config) == ESP_OK){
+				adv_config_done |= ADV_CONFIG_FLAG;
+			}else{
+				esp_ble_gap_start_advertising(&spp_adv_params);
+			}
+		}
+		break;
 	case ESP_GAP_BLE_SET_LOCAL_PRIVACY_COMPLETE_EVT:
 		if (param->local_privacy_cmpl.status != ESP_BT_STATUS_SUCCESS){
 			ESP_LOGE(__FUNCTION__, "config local privacy failed, error status = %x", param->local_privacy_cmpl.status);
@@ -293,7 +743,7 @@ static void gap_event_handler(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param
 static void gatts_profile_event_handler(esp_gatts_cb_event_t event,
 										esp_gatt_if_t gatts_if, esp_ble_gatts_cb_param_t *param) {
     esp_ble_gatts_cb_param_t *p_data = (esp_ble_gatts_cb_param_t *) param;
-	CMD_t cmdBuf;
+	ble_char_t *ch;
 
 	switch (event) {
 		case ESP_GATTS_REG_EVT:
@@ -304,16 +754,29 @@ static void gatts_profile_event_handler(esp_gatts_cb_event_t event,
 			esp_ble_gatts_create_attr_tab(spp_gatt_db, gatts_if, SPP_IDX_NB, SPP_SVC_INST_ID);
 			break;
 		case ESP_GATTS_READ_EVT:
+			ch = BleCharFind(param->read.handle);
+			if(ch != NULL && ch->config.read_p != NULL && param->read.need_rsp){
+				BleCharRead(ch, gatts_if, param);
+			}
 			break;
 		case ESP_GATTS_WRITE_EVT:
-			cmdBuf.command = CMD_BLUETOOTH_DATA;
-			memcpy(cmdBuf.payload, param->write.value, param->write.len);
-			cmdBuf.length = param->write.len;
-			xQueueSend(xQueueRead, &cmdBuf, 0);
+			if(param->write.is_prep){
+				BlePrepWrite(gatts_if, param);
+				break;
+			}
+			BleWriteValue(param->write.handle, param->write.value, param->write.len);
+			/* Values with a read function are answered by the application, writes included */
+			if(param->write.need_rsp){
+				esp_ble_gatts_send_response(gatts_if, param->write.conn_id, param->write.trans_id, ESP_GATT_OK, NULL);
+			}
 			break;
 		case ESP_GATTS_EXEC_WRITE_EVT:
+			BlePrepExec(param->exec_write.exec_write_flag == ESP_GATT_PREP_WRITE_EXEC);
+			esp_ble_gatts_send_response(gatts_if, param->exec_write.conn_id, param->exec_write.trans_id, ESP_GATT_OK, NULL);
 			break;
 		case ESP_GATTS_MTU_EVT:
+			mtu = param->mtu.mtu;
+			ESP_LOGI(TAG, "MTU: %d bytes", mtu);
 			break;
 		case ESP_GATTS_CONF_EVT:
 			break;
@@ -326,17 +789,30 @@ static void gatts_profile_event_handler(esp_gatts_cb_event_t event,
 		case ESP_GATTS_STOP_EVT:
 			break;
 		case ESP_GATTS_CONNECT_EVT:
+			link_up = true;
 			/* start security connect with peer device when receive the connect event sent by the master */
 			esp_ble_set_encryption(param->connect.remote_bda, ESP_BLE_SEC_ENCRYPT_MITM);
-			cmdBuf.command = CMD_BLUETOOTH_CONNECT;
-			cmdBuf.spp_conn_id = p_data->connect.conn_id;
-			cmdBuf.spp_gatts_if = gatts_if;
-			xQueueSend(xQueueEvents, &cmdBuf, portMAX_DELAY);
+			/* MTU exchange is started by the client, the link layer packet size and PHY by us */
+			mtu = ESP_GATT_DEF_BLE_MTU_SIZE;
+			esp_ble_gap_set_pkt_data_len(param->connect.remote_bda, DLE_TX_BYTES);
+			memcpy(remote_bda, param->connect.remote_bda, sizeof(esp_bd_addr_t));
+			link_info.interval_us = param->connect.conn_params.interval * 1250;
+			link_info.latency = param->connect.conn_params.latency;
+			link_info.timeout_ms = param->connect.conn_params.timeout * 10;
+			link_info.phy = ESP_BLE_GAP_PHY_1M;
+			link_info.data_length = 27;
+			BleProfileConnection();
+			spp_conn_id = p_data->connect.conn_id;
+			spp_gatts_if = gatts_if;
 			break;
 		case ESP_GATTS_DISCONNECT_EVT:
-			cmdBuf.command = CMD_BLUETOOTH_DISCONNECT;
+			ESP_LOGI(TAG, "Device disconnected");
+			link_up = false;
 			status = BLE_DISCONNECTED;
-			xQueueSend(xQueueEvents, &cmdBuf, portMAX_DELAY);
+			mtu = ESP_GATT_DEF_BLE_MTU_SIZE;
+			BleTxFlush();
+			BleCharsDisconnect();
+			BlePrepExec(false);
 			/* start advertising again when missing the connect */
 			esp_ble_gap_start_advertising(&spp_adv_params);
 			break;
@@ -349,13 +825,28 @@ static void gatts_profile_event_handler(esp_gatts_cb_event_t event,
 		case ESP_GATTS_LISTEN_EVT:
 			break;
 		case ESP_GATTS_CONGEST_EVT:
+			/* Controller buffers full: stop sending until they are released */
+			congested = param->congest.congested;
+			if(congested){
+				xSemaphoreTake(tx_mutex, portMAX_DELAY);
+				stats.congestions++;
+				xSemaphoreGive(tx_mutex);
+			}else{
+				xTaskNotifyGive(tx_task_handle);
+			}
 			break;
 		case ESP_GATTS_CREAT_ATTR_TAB_EVT: {
-			if (param->create.status == ESP_GATT_OK){
+			if (param->create.status == ESP_GATT_OK && param->add_attr_tab.svc_inst_id == CHARS_SVC_INST_ID){
+				BleCharsStart(param->add_attr_tab.handles, param->add_attr_tab.num_handle);
+			}else if (param->create.status == ESP_GATT_OK){
 				if(param->add_attr_tab.num_handle == SPP_IDX_NB) {
 					memcpy(spp_handle_table, param->add_attr_tab.handles,
 					sizeof(spp_handle_table));
 					esp_ble_gatts_start_service(spp_handle_table[SPP_IDX_SVC]);
+					/* Tables are created one after the other */
+					if(chars_qty > 0){
+						BleCharsCreate(gatts_if);
+					}
 				}else{
 					ESP_LOGE(__FUNCTION__, "Create attribute table abnormally, num_handle (%d) doesn't equal to SPP_IDX_NB(%d)",
 						param->add_attr_tab.num_handle, SPP_IDX_NB);
@@ -394,65 +885,131 @@ static void gatts_event_handler(esp_gatts_cb_event_t event, esp_gatt_if_t gatts_
 }
 
 static void read_task(void* pvParameters) {
-	CMD_t cmdBuf;
+	ble_msg_t *msg;
 	while(1) {
-		xQueueReceive(xQueueRead, &cmdBuf, portMAX_DELAY);
-		if(ble_read_isr_p != BLE_NO_INT){
-            ble_read_isr_p(cmdBuf.payload, cmdBuf.length);
-        }
+		xQueueReceive(xQueueRead, &msg, portMAX_DELAY);
+		if(msg->id == SPP_MSG_ID){
+			ble_read_isr_p(msg->data, msg->length);
+		}else{
+			chars[msg->id].config.write_p(msg->data, msg->length, chars[msg->id].config.param_p);
+		}
+		free(msg);
 	} 
 }
 
-void bluetooth_events_task(void * arg) {
-	CMD_t cmdBuf;
-	uint16_t spp_conn_id = 0xffff;
-	esp_gatt_if_t spp_gatts_if = 0xff;
-	int data_sent, i;
+static void tx_task(void* pvParameters) {
+	ble_record_t rec;
+	uint32_t discards, pos, used, age;
+	uint16_t chunk, max, sent, n, handle;
+	bool batch;
+	esp_err_t ret;
 
 	while(1){
-		vTaskDelay(50 / portTICK_PERIOD_MS);
-		xQueueReceive(xQueueEvents, &cmdBuf, portMAX_DELAY);
-        switch(cmdBuf.command){
-            case CMD_BLUETOOTH_CONNECT:
-                spp_conn_id = cmdBuf.spp_conn_id;
-                spp_gatts_if = cmdBuf.spp_gatts_if;
-            break;
-            case CMD_BLUETOOTH_AUTH:
-                ESP_LOGI(TAG, "Device connected");
-				status = BLE_CONNECTED;
-            break;
-            case CMD_BLUETOOTH_DISCONNECT:
-                ESP_LOGI(TAG, "Device disconnected");
-				status = BLE_DISCONNECTED;
-            break;
-            case CMD_SEND_DATA:
-                if (status == BLE_CONNECTED) {
-					data_sent = 0;
-					i = 0;
-					while(data_sent < cmdBuf.length){
-						if((cmdBuf.length - data_sent) > MTU_MAX_BYTES){
-							esp_ble_gatts_send_indicate(spp_gatts_if, spp_conn_id, spp_handle_table[SPP_IDX_SPP_DATA_NOTIFY_VAL], MTU_MAX_BYTES, &cmdBuf.payload[i*MTU_MAX_BYTES], false);
-							data_sent += MTU_MAX_BYTES;
-							i++;
-						}else{
-							esp_ble_gatts_send_indicate(spp_gatts_if, spp_conn_id, spp_handle_table[SPP_IDX_SPP_DATA_NOTIFY_VAL], cmdBuf.length - data_sent, &cmdBuf.payload[i*MTU_MAX_BYTES], false);
-							data_sent += MTU_MAX_BYTES;
-						}
-					}
-                }
-            break;
-            case CMD_BLUETOOTH_DATA:
-                xQueueSend(xQueueRead, &cmdBuf, portMAX_DELAY);
-            break;
-        }
+		if(status != BLE_CONNECTED || congested || tx_used == 0){
+			ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+			continue;
+		}
+		/* Copy the next notification: the rest of the oldest message and, when
+		batching, the following messages to the same characteristic */
+		max = mtu - ATT_HEADER_BYTES;
+		chunk = 0;
+		xSemaphoreTake(tx_mutex, portMAX_DELAY);
+		discards = tx_discards;
+		pos = tx_tail;
+		used = tx_used;
+		sent = tx_sent;
+		BleRingHeader(pos, &rec);
+		handle = rec.handle;
+		age = (uint32_t)esp_timer_get_time() - rec.time;
+		/* Characteristic values aren't merged nor split */
+		batch = (batch_us > 0) && (handle == spp_handle_table[SPP_IDX_SPP_DATA_NOTIFY_VAL]);
+		while(1){
+			n = rec.length - sent;
+			if(n > max - chunk){
+				n = max - chunk;
+			}
+			BleRingRead(pos + RECORD_HEADER + sent, &tx_chunk[chunk], n);
+			chunk += n;
+			used -= RECORD_HEADER + rec.length;
+			if(!batch || chunk == max || used == 0){
+				break;
+			}
+			pos = (pos + RECORD_HEADER + rec.length) % tx_ring_size;
+			sent = 0;
+			BleRingHeader(pos, &rec);
+			if(rec.handle != handle){
+				break;
+			}
+		}
+		xSemaphoreGive(tx_mutex);
+
+		if(batch && chunk < max && age < batch_us){
+			/* Wait for more data until the oldest message reaches the deadline */
+			ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS((batch_us - age + 999) / 1000) + 1);
+			continue;
+		}
+
+		ret = esp_ble_gatts_send_indicate(spp_gatts_if, spp_conn_id, handle, chunk, tx_chunk, false);
+		if(ret != ESP_OK){
+			/* Stack queue full, retry on the next tick */
+			ulTaskNotifyTake(pdTRUE, 1);
+			continue;
+		}
+
+		/* Remove the sent bytes (unless messages were dropped meanwhile) */
+		xSemaphoreTake(tx_mutex, portMAX_DELAY);
+		stats.notifications++;
+		stats.bytes += chunk;
+		window_bytes += chunk;
+		if(discards == tx_discards){
+			BleRingConsume(chunk, handle != spp_handle_table[SPP_IDX_SPP_DATA_NOTIFY_VAL]);
+		}
+		xSemaphoreGive(tx_mutex);
 	} 
 }
 
+static void notify_task(void* pvParameters) {
+	static uint8_t value[ESP_GATT_MAX_ATTR_LEN];
+	ble_char_t *ch;
+	TickType_t now, wait;
+	uint16_t len;
+
+	while(1){
+		now = xTaskGetTickCount();
+		wait = portMAX_DELAY;
+		for(uint8_t i = 0; i < chars_qty; i++){
+			ch = &chars[i];
+			if(ch->period == 0 || !ch->subscribed || status != BLE_CONNECTED){
+				continue;
+			}
+			if((int32_t)(now - ch->next) >= 0){
+				len = ch->config.read_p(value, ch->config.max_length, ch->config.param_p);
+				BleNotify(i, value, len);
+				ch->next += ch->period;
+				if((int32_t)(now - ch->next) >= 0){
+					/* Late (e.g. congestion), don't send the missed ones in a burst */
+					ch->next = now + ch->period;
+				}
+			}
+			if(ch->next - now < wait){
+				wait = ch->next - now;
+			}
+		}
+		ulTaskNotifyTake(pdTRUE, wait);
+	}
+}
+
 /*==================[external functions definition]==========================*/
 void BleInit(ble_config_t * ble_device){
 esp_err_t ret;
     device_name = ble_device->device_name;
+	if(ble_device->service_uuid != 0){
+		chars_service_uuid = ble_device->service_uuid;
+	}
     ble_read_isr_p = ble_device->func_p;
+	profile = ble_device->profile;
+	BleProfileAdvertising();
+	ble_init = true;
 	/* Initialize NVS. */
 	ret = nvs_flash_init();
 	if (ret == ESP_ERR_NVS_NO_FREE_PAGES || ret == ESP_ERR_NVS_NEW_VERSION_FOUND) {
@@ -497,6 +1054,14 @@ esp_err_t ret;
 		ESP_LOGE(TAG, "gatts app register error, error code = %x", ret);
 		return;
 	}
+	/* MTU offered to the client on the MTU exchange */
+	ret = esp_ble_gatt_set_local_mtu(BLE_MTU_MAX);
+	if (ret){
+		ESP_LOGE(TAG, "set local MTU failed, error code = %x", ret);
+	}
+#ifdef CONFIG_BT_BLE_50_FEATURES_SUPPORTED
+	esp_ble_gap_set_preferred_default_phy(profiles[profile].phy_mask, profiles[profile].phy_mask);
+#endif
 	/* set the security iocap & auth_req & key size & init key response key parameters to the stack*/
 	esp_ble_auth_req_t auth_req = ESP_LE_AUTH_REQ_SC_MITM_BOND;		//bonding with peer device after authentication
 	esp_ble_io_cap_t iocap = ESP_IO_CAP_NONE;			//set the IO capability to No output No input
@@ -516,51 +1081,156 @@ esp_err_t ret;
 	esp_ble_gap_set_security_param(ESP_BLE_SM_SET_INIT_KEY, &init_key, sizeof(uint8_t));
 	esp_ble_gap_set_security_param(ESP_BLE_SM_SET_RSP_KEY, &rsp_key, sizeof(uint8_t));
 	
-    /* Create Queue */
-	xQueueEvents = xQueueCreate(10, sizeof(CMD_t));
-	configASSERT(xQueueEvents);
-	xQueueRead = xQueueCreate( 10, sizeof(CMD_t) );
+    /* Create transmission ring and queue */
+	tx_policy = ble_device->tx_policy;
+	tx_ring_size = (ble_device->tx_buffer_size > 0) ? ble_device->tx_buffer_size : TX_BUFFER_SIZE;
+	tx_ring = malloc(tx_ring_size);
+	configASSERT(tx_ring);
+	tx_mutex = xSemaphoreCreateMutex();
+	configASSERT(tx_mutex);
+	tx_space = xSemaphoreCreateBinary();
+	configASSERT(tx_space);
+	xQueueRead = xQueueCreate(RX_QUEUE_SIZE, sizeof(ble_msg_t *));
 	configASSERT(xQueueRead);
 
 	/* Start tasks */
 	xTaskCreate(read_task, "read", 1024*4, NULL, 2, NULL);
-	xTaskCreate(bluetooth_events_task, "bluetooth_events", 1024*4, NULL, 10, NULL);
+	xTaskCreate(tx_task, "ble_tx", 1024*4, NULL, 10, &tx_task_handle);
+	for(uint8_t i = 0; i < chars_qty; i++){
+		if(chars[i].period > 0){
+			xTaskCreate(notify_task, "ble_notify", 1024*4, NULL, 5, &notify_task_handle);
+			break;
+		}
+	}
 }
 
 ble_status_t BleStatus(void){
 	return status;
 }
 
+uint16_t BleMtu(void){
+	return mtu;
+}
+
 void BleSendByte(const char *data){
-	CMD_t cmdBuf;
-	if(status == BLE_CONNECTED){
-		cmdBuf.command = CMD_SEND_DATA;
-		cmdBuf.length = 1;
-		memcpy(cmdBuf.payload, data, cmdBuf.length);
-		xQueueSend(xQueueEvents, &cmdBuf, portMAX_DELAY);
-	}
+	BleQueueSend(spp_handle_table[SPP_IDX_SPP_DATA_NOTIFY_VAL], (const uint8_t *)data, 1);
 }
 
 void BleSendString(const char *msg){
-	CMD_t cmdBuf;
-	if(status == BLE_CONNECTED){
-		cmdBuf.command = CMD_SEND_DATA;
-		cmdBuf.length = 0;
-		while(msg[cmdBuf.length] != '\0'){
-			cmdBuf.length++;
+	BleQueueSend(spp_handle_table[SPP_IDX_SPP_DATA_NOTIFY_VAL], (const uint8_t *)msg, strlen(msg));
+}
+
+void BleSendBuffer(const char *data, uint8_t nbytes){
+	BleQueueSend(spp_handle_table[SPP_IDX_SPP_DATA_NOTIFY_VAL], (const uint8_t *)data, nbytes);
+}
+
+int8_t BleAddCharacteristic(const ble_char_config_t *config){
+	ble_char_t *ch;
+	uint16_t max_length = (config->max_length > ESP_GATT_MAX_ATTR_LEN) ? ESP_GATT_MAX_ATTR_LEN : config->max_length;
+
+	if(ble_init || chars_qty >= BLE_MAX_CHARS || max_length == 0 || config->properties == 0){
+		return -1;
+	}
+	if(config->notify_period_ms > 0 && (config->read_p == NULL || !(config->properties & BLE_CHAR_NOTIFY))){
+		return -1;
+	}
+	ch = &chars[chars_qty];
+	memset(ch, 0, sizeof(ble_char_t));
+	ch->config = *config;
+	ch->config.max_length = max_length;
+	if(config->read_p == NULL){
+		ch->value = calloc(max_length, 1);
+		if(ch->value == NULL){
+			return -1;
 		}
-		memcpy(cmdBuf.payload, msg, cmdBuf.length);
-		xQueueSend(xQueueEvents, &cmdBuf, portMAX_DELAY);
 	}
+	ch->properties = ((config->properties & BLE_CHAR_READ) ? ESP_GATT_CHAR_PROP_BIT_READ : 0) |
+		((config->properties & BLE_CHAR_WRITE) ? (ESP_GATT_CHAR_PROP_BIT_WRITE | ESP_GATT_CHAR_PROP_BIT_WRITE_NR) : 0) |
+		((config->properties & BLE_CHAR_NOTIFY) ? ESP_GATT_CHAR_PROP_BIT_NOTIFY : 0);
+	if(config->notify_period_ms > 0){
+		ch->period = pdMS_TO_TICKS(config->notify_period_ms);
+		if(ch->period == 0){
+			ch->period = 1;
+		}
+	}
+	/* Declaration, value, CCCD and description attributes */
+	chars_attrs += 2 + ((config->properties & BLE_CHAR_NOTIFY) ? 1 : 0) + ((config->description != NULL) ? 1 : 0);
+	return chars_qty++;
 }
 
-void BleSendBuffer(const char *data, uint8_t nbytes){
-	CMD_t cmdBuf;
-	if(status == BLE_CONNECTED){
-		cmdBuf.command = CMD_SEND_DATA;
-		cmdBuf.length = nbytes;
-		memcpy(cmdBuf.payload, data, cmdBuf.length);
-		xQueueSend(xQueueEvents, &cmdBuf, portMAX_DELAY);
+bool BleNotify(uint8_t id, const void *value, uint16_t length){
+	ble_char_t *ch;
+	if(id >= chars_qty || chars[id].value_handle == 0){
+		return false;
+	}
+	ch = &chars[id];
+	if(length > ch->config.max_length){
+		length = ch->config.max_length;
+	}
+	/* Keep the value for reads answered by the stack */
+	if(ch->value != NULL){
+		esp_ble_gatts_set_attr_value(ch->value_handle, length, value);
+	}
+	if(!ch->subscribed || status != BLE_CONNECTED){
+		return false;
 	}
+	BleQueueSend(ch->value_handle, value, length);
+	return true;
+}
+
+void BleSetBatching(uint16_t deadline_ms){
+	batch_us = deadline_ms * 1000UL;
+	if(tx_task_handle != NULL){
+		xTaskNotifyGive(tx_task_handle);
+	}
+}
+
+bool BleSubscribed(uint8_t id){
+	return (id < chars_qty) && chars[id].subscribed;
+}
+
+void BleGetStats(ble_stats_t *stats_p){
+	xSemaphoreTake(tx_mutex, portMAX_DELAY);
+	BleThroughputUpdate();
+	*stats_p = stats;
+	stats_p->latency_avg_us = (stats.messages > 0) ? latency_sum / stats.messages : 0;
+	stats_p->pending = tx_used;
+	xSemaphoreGive(tx_mutex);
+}
+
+void BleResetStats(void){
+	xSemaphoreTake(tx_mutex, portMAX_DELAY);
+	memset(&stats, 0, sizeof(stats));
+	latency_sum = 0;
+	window_bytes = 0;
+	window_start = esp_timer_get_time();
+	xSemaphoreGive(tx_mutex);
+}
+void BleSetProfile(ble_profile_t new_profile){
+	if(new_profile > BLE_PROFILE_LOW_POWER){
+		return;
+	}
+	profile = new_profile;
+	BleProfileAdvertising();
+	if(status == BLE_OFF){
+		return;
+	}
+#ifdef CONFIG_BT_BLE_50_FEATURES_SUPPORTED
+	esp_ble_gap_set_preferred_default_phy(profiles[profile].phy_mask, profiles[profile].phy_mask);
+#endif
+	/* Until authentication completes status is still BLE_DISCONNECTED, but the
+	 * link is up and there is no advertising to restart */
+	if(link_up){
+		BleProfileConnection();
+	}else{
+		/* Advertising restarts with the new interval and hint when stopped */
+		esp_ble_gap_stop_advertising();
+	}
+}
+
+void BleGetLink(ble_link_t *link_p){
+	*link_p = link_info;
+	link_p->profile = profile;
+	link_p->mtu = mtu;
 }
 /*==================[end of file]============================================*/
\ No newline at end of file
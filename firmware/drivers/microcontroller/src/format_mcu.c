@@ -0,0 +1,210 @@
+/**
+ * @file format_mcu.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include <math.h>
+#include "format_mcu.h"
+/*==================[macros and definitions]=================================*/
+#define EXP_LIMIT		1e9f	/*!< Floats from this value are written with exponent */
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+static const char digit_pairs[201] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+static const char hex_digits[] = "0123456789abcdef";
+
+static const uint32_t pow10[FORMAT_MAX_DECIMALS + 1] = {
+	1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static uint8_t FormatDigits(uint32_t val){
+	uint8_t n = 1;
+	while(n < 10 && val >= pow10[n]){
+		n++;
+	}
+	return n;
+}
+
+/* Write exactly len digits of val ending at buf + len (no '\0') */
+static void FormatDecimal(char *buf, uint32_t val, uint8_t len){
+	char *p = buf + len;
+	uint32_t q;
+	while(p - buf >= 2){
+		q = val / 100;
+		p -= 2;
+		memcpy(p, &digit_pairs[2 * (val - q * 100)], 2);
+		val = q;
+	}
+	if(p > buf){
+		*--p = '0' + (val % 10);
+	}
+}
+
+/* "int.frac" with frac written with decimals digits */
+static uint8_t FormatParts(char *buf, uint32_t int_part, uint32_t frac, uint8_t decimals){
+	uint8_t len = FormatUint(buf, int_part);
+	if(decimals > 0){
+		buf[len++] = '.';
+		FormatDecimal(&buf[len], frac, decimals);
+		len += decimals;
+		buf[len] = '\0';
+	}
+	return len;
+}
+/*==================[external functions definition]==========================*/
+
+uint8_t FormatUint(char *buf, uint32_t val){
+	uint8_t len = FormatDigits(val);
+	FormatDecimal(buf, val, len);
+	buf[len] = '\0';
+	return len;
+}
+
+uint8_t FormatUintPad(char *buf, uint32_t val, uint8_t width, char pad){
+	uint8_t len = FormatDigits(val);
+	uint8_t fill = (width > len) ? width - len : 0;
+	memset(buf, pad, fill);
+	FormatDecimal(&buf[fill], val, len);
+	buf[fill + len] = '\0';
+	return fill + len;
+}
+
+uint8_t FormatInt(char *buf, int32_t val){
+	if(val < 0){
+		buf[0] = '-';
+		/* Unsigned negation also works for INT32_MIN */
+		return 1 + FormatUint(&buf[1], 0u - (uint32_t)val);
+	}
+	return FormatUint(buf, val);
+}
+
+uint8_t FormatHex(char *buf, uint32_t val, uint8_t digits){
+	uint8_t len = 1;
+	if(digits > 8){
+		digits = 8;
+	}
+	while(len < 8 && (val >> (4 * len))){
+		len++;
+	}
+	if(len < digits){
+		len = digits;
+	}
+	buf[len] = '\0';
+	for(int8_t i = len - 1; i >= 0; i--){
+		buf[i] = hex_digits[val & 0xF];
+		val >>= 4;
+	}
+	return len;
+}
+
+uint8_t FormatBase(char *buf, uint32_t val, uint8_t base){
+	char aux[FORMAT_BIN_SIZE];
+	uint8_t i = sizeof(aux) - 1;
+	uint8_t len;
+
+	if(base == 10){
+		return FormatUint(buf, val);
+	}
+	if(base == 16){
+		return FormatHex(buf, val, 0);
+	}
+	if(base < 2 || base > 16){
+		buf[0] = '\0';
+		return 0;
+	}
+	aux[i] = '\0';
+	do{
+		aux[--i] = hex_digits[val % base];
+		val /= base;
+	}while(val);
+	len = sizeof(aux) - 1 - i;
+	memcpy(buf, &aux[i], len + 1);
+	return len;
+}
+
+uint8_t FormatFixed(char *buf, int32_t val, uint8_t decimals){
+	uint32_t abs_val;
+	uint8_t len = 0;
+
+	if(decimals > FORMAT_MAX_DECIMALS){
+		decimals = FORMAT_MAX_DECIMALS;
+	}
+	if(val < 0){
+		buf[len++] = '-';
+		abs_val = 0u - (uint32_t)val;
+	}else{
+		abs_val = val;
+	}
+	return len + FormatParts(&buf[len], abs_val / pow10[decimals], abs_val % pow10[decimals], decimals);
+}
+
+uint8_t FormatFloat(char *buf, float val, uint8_t decimals){
+	uint32_t int_part, frac;
+	uint8_t len = 0;
+	uint8_t exp = 0;
+
+	if(isnan(val)){
+		strcpy(buf, "nan");
+		return 3;
+	}
+	if(decimals > FORMAT_MAX_DECIMALS){
+		decimals = FORMAT_MAX_DECIMALS;
+	}
+	if(signbit(val)){
+		buf[len++] = '-';
+		val = -val;
+	}
+	if(isinf(val)){
+		strcpy(&buf[len], "inf");
+		return len + 3;
+	}
+	if(val >= EXP_LIMIT){
+		while(val >= 10.0f){
+			val /= 10.0f;
+			exp++;
+		}
+	}
+	int_part = (uint32_t)val;
+	frac = (uint32_t)((val - int_part) * pow10[decimals] + 0.5f);
+	if(frac >= pow10[decimals]){
+		frac -= pow10[decimals];
+		int_part++;
+	}
+	if(exp > 0 && int_part >= 10){
+		/* Rounding turned 9.99 into 10.0 */
+		int_part = 1;
+		exp++;
+	}
+	len += FormatParts(&buf[len], int_part, frac, decimals);
+	if(exp > 0){
+		buf[len++] = 'e';
+		buf[len++] = '+';
+		len += FormatUintPad(&buf[len], exp, 2, '0');
+	}
+	return len;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,261 @@
+/**
+ * @file gpio_event_mcu.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include "gpio_event_mcu.h"
+#include "esp_attr.h"
+#include "esp_timer.h"
+#include "hal/gpio_ll.h"
+#include "soc/gpio_struct.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+/*==================[macros and definitions]=================================*/
+#define GPIO_EVENT_PINS		24		/* GPIO_0 to GPIO_23 */
+#define EDGE_QUEUE_SIZE		32		/* Edges waiting to be processed */
+#define EVENT_TASK_PRIORITY	10
+#define NO_DEADLINE			INT64_MAX
+/*==================[internal data declaration]==============================*/
+typedef enum {
+	STATE_IDLE,				/* Inactive */
+	STATE_PRESSED,			/* Active, shorter than long_press_ms */
+	STATE_LONG,				/* Active, long press reported */
+	STATE_WAIT_SECOND		/* Released, waiting for the second click */
+} button_state_t;
+
+typedef struct {
+	uint8_t pin;			/* GPIO number */
+	uint8_t level;			/* Level read in the ISR */
+	int64_t time_us;		/* Time of the edge */
+} gpio_edge_t;
+
+typedef struct {
+	gpio_event_config_t config;
+	bool enabled;			/* Events enabled */
+	bool active;			/* Debounced state */
+	bool check;				/* Level must be read again when the debounce time ends */
+	bool second;			/* Second press of a double click */
+	button_state_t state;	/* Button state */
+	int64_t change_us;		/* Time of the last accepted change */
+	int64_t press_us;		/* Time of the last press */
+	int64_t release_us;		/* Time of the last release */
+	int64_t debounce_us;
+	int64_t long_press_us;
+	int64_t double_click_us;
+} gpio_event_pin_t;
+
+static gpio_event_pin_t *pins[GPIO_EVENT_PINS];
+static QueueHandle_t edge_queue = NULL;
+static volatile uint32_t overflows = 0;
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static void IRAM_ATTR GPIOEventIsr(void *args){
+	BaseType_t woken = pdFALSE;
+	gpio_edge_t edge = {
+		.pin = (uintptr_t)args,
+		.level = gpio_ll_get_level(&GPIO, (uintptr_t)args),
+		.time_us = esp_timer_get_time(),
+	};
+	if(xQueueSendFromISR(edge_queue, &edge, &woken) != pdTRUE){
+		overflows++;
+	}
+	portYIELD_FROM_ISR(woken);
+}
+
+static void GPIOEventSend(gpio_t pin, gpio_event_type_t type, int64_t time_us, uint32_t duration_ms){
+	gpio_event_t event = {
+		.pin = pin,
+		.type = type,
+		.time_us = time_us,
+		.duration_ms = duration_ms,
+	};
+	pins[pin]->config.func_p(&event, pins[pin]->config.param_p);
+}
+
+/* Debounced change of state */
+static void GPIOEventChange(gpio_t pin, bool active, int64_t time_us){
+	gpio_event_pin_t *p = pins[pin];
+
+	p->active = active;
+	p->change_us = time_us;
+	p->check = true;
+	if(active){
+		GPIOEventSend(pin, GPIO_EVENT_PRESS, time_us, 0);
+		p->second = (p->state == STATE_WAIT_SECOND);
+		p->state = STATE_PRESSED;
+		p->press_us = time_us;
+		return;
+	}
+	GPIOEventSend(pin, GPIO_EVENT_RELEASE, time_us, (time_us - p->press_us) / 1000);
+	if(p->state == STATE_PRESSED){
+		if(p->second){
+			GPIOEventSend(pin, GPIO_EVENT_DOUBLE_CLICK, time_us, 0);
+		}else if(p->double_click_us == 0){
+			GPIOEventSend(pin, GPIO_EVENT_CLICK, time_us, 0);
+		}else{
+			p->state = STATE_WAIT_SECOND;
+			p->release_us = time_us;
+			return;
+		}
+	}
+	p->state = STATE_IDLE;
+}
+
+static void GPIOEventEdge(const gpio_edge_t *edge){
+	gpio_event_pin_t *p = pins[edge->pin];
+	bool active = (edge->level != 0) == p->config.active_high;
+
+	if(edge->time_us - p->change_us < p->debounce_us){
+		/* Bounce, the level is read again when the debounce time ends */
+		p->check = true;
+		return;
+	}
+	if(active != p->active){
+		GPIOEventChange(edge->pin, active, edge->time_us);
+	}
+}
+
+/* Timeouts of a pin, returns its next deadline */
+static int64_t GPIOEventTimeouts(gpio_t pin, int64_t now){
+	gpio_event_pin_t *p = pins[pin];
+	int64_t deadline = NO_DEADLINE;
+	bool active;
+
+	if(p->check){
+		if(now - p->change_us >= p->debounce_us){
+			p->check = false;
+			active = GPIORead(pin) == p->config.active_high;
+			if(active != p->active){
+				GPIOEventChange(pin, active, now);
+			}
+		}
+		if(p->check){
+			deadline = p->change_us + p->debounce_us;
+		}
+	}
+	if(p->state == STATE_PRESSED && p->long_press_us > 0){
+		if(now - p->press_us >= p->long_press_us){
+			if(p->second){
+				/* The first click didn't become a double click */
+				GPIOEventSend(pin, GPIO_EVENT_CLICK, p->release_us, 0);
+			}
+			GPIOEventSend(pin, GPIO_EVENT_LONG_PRESS, p->press_us + p->long_press_us, 0);
+			p->state = STATE_LONG;
+		}else if(p->press_us + p->long_press_us < deadline){
+			deadline = p->press_us + p->long_press_us;
+		}
+	}
+	if(p->state == STATE_WAIT_SECOND){
+		if(now - p->release_us >= p->double_click_us){
+			GPIOEventSend(pin, GPIO_EVENT_CLICK, p->release_us, 0);
+			p->state = STATE_IDLE;
+		}else if(p->release_us + p->double_click_us < deadline){
+			deadline = p->release_us + p->double_click_us;
+		}
+	}
+	return deadline;
+}
+
+static void GPIOEventTask(void *param){
+	gpio_edge_t edge;
+	TickType_t wait = portMAX_DELAY;
+	int64_t now, deadline, next;
+
+	while(1){
+		if(xQueueReceive(edge_queue, &edge, wait) == pdTRUE && pins[edge.pin]->enabled){
+			GPIOEventEdge(&edge);
+		}
+		/* Debounce checks, long presses and double click timeouts */
+		now = esp_timer_get_time();
+		next = NO_DEADLINE;
+		for(uint8_t pin = 0; pin < GPIO_EVENT_PINS; pin++){
+			if(pins[pin] != NULL && pins[pin]->enabled){
+				deadline = GPIOEventTimeouts(pin, now);
+				if(deadline < next){
+					next = deadline;
+				}
+			}
+		}
+		if(next == NO_DEADLINE){
+			wait = portMAX_DELAY;
+		}else{
+			/* Rounded up to the next tick */
+			wait = (next - now + portTICK_PERIOD_MS * 1000 - 1) / (portTICK_PERIOD_MS * 1000);
+			if(wait == 0){
+				wait = 1;
+			}
+		}
+	}
+}
+/*==================[external functions definition]==========================*/
+
+bool GPIOEventInit(gpio_t pin, const gpio_event_config_t *config){
+	gpio_event_pin_t *p;
+
+	if(pin == GPIO_14 || pin >= GPIO_EVENT_PINS || config->func_p == NULL){
+		return false;
+	}
+	if(edge_queue == NULL){
+		edge_queue = xQueueCreate(EDGE_QUEUE_SIZE, sizeof(gpio_edge_t));
+		if(edge_queue == NULL){
+			return false;
+		}
+		xTaskCreate(GPIOEventTask, "gpio_event", 3072, NULL, EVENT_TASK_PRIORITY, NULL);
+	}
+	if(pins[pin] == NULL){
+		pins[pin] = calloc(1, sizeof(gpio_event_pin_t));
+		if(pins[pin] == NULL){
+			return false;
+		}
+	}
+	p = pins[pin];
+	if(p->enabled){
+		/* Configured again: stop the interrupt of the previous configuration */
+		GPIODeactivInt(pin);
+		p->enabled = false;
+	}
+	p->config = *config;
+	p->debounce_us = ((config->debounce_ms > 0) ? config->debounce_ms : GPIO_EVENT_DEBOUNCE_MS) * 1000LL;
+	p->long_press_us = config->long_press_ms * 1000LL;
+	p->double_click_us = config->double_click_ms * 1000LL;
+	p->state = STATE_IDLE;
+	p->check = false;
+	p->change_us = esp_timer_get_time() - p->debounce_us;
+
+	GPIOInit(pin, GPIO_INPUT);
+	p->active = GPIORead(pin) == config->active_high;
+	p->enabled = true;
+	GPIOActivIntAnyEdge(pin, GPIOEventIsr, (void *)(uintptr_t)pin);
+	return true;
+}
+
+void GPIOEventDeinit(gpio_t pin){
+	if(pin < GPIO_EVENT_PINS && pins[pin] != NULL && pins[pin]->enabled){
+		GPIODeactivInt(pin);
+		pins[pin]->enabled = false;
+	}
+}
+
+bool GPIOEventActive(gpio_t pin){
+	return (pin < GPIO_EVENT_PINS) && (pins[pin] != NULL) && pins[pin]->active;
+}
+
+uint32_t GPIOEventOverflows(void){
+	return overflows;
+}
+
+/*==================[end of file]============================================*/
@@ -19,8 +19,7 @@
 /*==================[macros and definitions]=================================*/
 
 /*==================[internal data declaration]==============================*/
-dedic_gpio_bundle_handle_t bundleA = NULL;
-int bundleA_gpios[16];
+
 /*==================[internal functions declaration]=========================*/
 
 /*==================[internal data definition]===============================*/
@@ -31,28 +30,61 @@ int bundleA_gpios[16];
 
 /*==================[external functions definition]==========================*/
 
-void GPIOFastInit(gpio_t *pin_list, uint8_t pin_qty){
-    memcpy(bundleA_gpios, pin_list, pin_qty);
+bool GPIOFastInit(gpio_fast_t *bundle, const gpio_t *pin_list, uint8_t pin_qty, gpio_fast_mode_t mode){
+    int gpios[GPIO_FAST_CHANNELS];
+    int offset;
+    dedic_gpio_bundle_handle_t handle = NULL;
     gpio_config_t io_conf = {
         .mode = GPIO_MODE_OUTPUT,
     };
-    for (int i = 0; i < pin_qty; i++) {
-        io_conf.pin_bit_mask = 1ULL << bundleA_gpios[i];
-        gpio_config(&io_conf);
+
+    memset(bundle, 0, sizeof(gpio_fast_t));
+    if(pin_qty == 0 || pin_qty > GPIO_FAST_CHANNELS){
+        return false;
+    }
+    if(mode == GPIO_FAST_INPUT){
+        io_conf.mode = GPIO_MODE_INPUT;
+        io_conf.pull_up_en = GPIO_PULLUP_ENABLE;
+    } else if(mode == GPIO_FAST_IN_OUT){
+        io_conf.mode = GPIO_MODE_INPUT_OUTPUT_OD;
+        io_conf.pull_up_en = GPIO_PULLUP_ENABLE;
+    }
+    for(uint8_t i = 0; i < pin_qty; i++){
+        gpios[i] = pin_list[i];
+        io_conf.pin_bit_mask |= 1ULL << pin_list[i];
     }
-    // Create bundleA, output only
-    dedic_gpio_bundle_config_t bundleA_config = {
-        .gpio_array = bundleA_gpios,
+    gpio_config(&io_conf);
+    dedic_gpio_bundle_config_t bundle_config = {
+        .gpio_array = gpios,
         .array_size = pin_qty,
         .flags = {
-            .out_en = 1,
+            .in_en = (mode != GPIO_FAST_OUTPUT),
+            .out_en = (mode != GPIO_FAST_INPUT),
         },
     };
-    ESP_ERROR_CHECK(dedic_gpio_new_bundle(&bundleA_config, &bundleA));
+    if(dedic_gpio_new_bundle(&bundle_config, &handle) != ESP_OK){
+        return false;
+    }
+    bundle->handle = handle;
+    bundle->pin_qty = pin_qty;
+    if(bundle_config.flags.out_en){
+        dedic_gpio_get_out_offset(handle, &offset);
+        bundle->out_shift = offset;
+        bundle->out_mask = ((1UL << pin_qty) - 1) << offset;
+    }
+    if(bundle_config.flags.in_en){
+        dedic_gpio_get_in_offset(handle, &offset);
+        bundle->in_shift = offset;
+        bundle->in_mask = ((1UL << pin_qty) - 1) << offset;
+    }
+    return true;
 }
 
-void GPIOFastWrite(uint16_t value){
-    dedic_gpio_bundle_write(bundleA, 0xFF, value);
+void GPIOFastDeinit(gpio_fast_t *bundle){
+    if(bundle->handle != NULL){
+        dedic_gpio_del_bundle(bundle->handle);
+    }
+    memset(bundle, 0, sizeof(gpio_fast_t));
 }
 
-/*==================[end of file]============================================*/
\ No newline at end of file
+/*==================[end of file]============================================*/
@@ -10,23 +10,37 @@
  */
 
 /*==================[inclusions]=============================================*/
+#include <stdbool.h>
+#include <stddef.h>
 #include "pwm_mcu.h"
 #include "driver/ledc.h"
+#include "esp_attr.h"
 /*==================[macros and definitions]=================================*/
-#define DC_MAX  1023
-#define DC_100  100
+#define PWM_QTY         6           /*!< LEDC channels */
+#define SPEED_MODE      LEDC_LOW_SPEED_MODE
+#define SRC_CLK_HZ      80000000    /*!< LEDC_USE_PLL_DIV_CLK */
+#define MAX_BITS        14          /*!< Max duty cycle resolution */
+#define PERCENT_TO_PERMILLE 10
 /*==================[internal data declaration]==============================*/
-static ledc_timer_config_t pwm_timer_cfg = {
-    .speed_mode       = LEDC_LOW_SPEED_MODE,
-    .duty_resolution  = LEDC_TIMER_10_BIT,
-    .clk_cfg          = LEDC_AUTO_CLK
-};
-static ledc_channel_config_t ledc_channel_cfg = {
-    .speed_mode     = LEDC_LOW_SPEED_MODE,
-    .intr_type      = LEDC_INTR_DISABLE,
-    .duty           = 0,       /*!< Starts in 0% */
-    .hpoint         = 0
-};
+typedef struct {
+    uint32_t freq;          /*!< Timer frequency */
+    uint8_t bits;           /*!< Duty cycle resolution */
+    uint8_t users;          /*!< Outputs using the timer */
+} pwm_timer_t;
+
+typedef struct {
+    bool init;              /*!< Output initialized */
+    bool on;                /*!< Output running (PWMOn/PWMOff) */
+    volatile bool fading;   /*!< Hardware fade in progress */
+    ledc_timer_t timer;     /*!< Timer of the output */
+    uint32_t duty;          /*!< Duty cycle in ticks */
+    pwm_fade_func_t func_p; /*!< Fade end callback */
+    void *param_p;          /*!< Fade end callback parameter */
+} pwm_channel_t;
+
+static pwm_timer_t timers[LEDC_TIMER_MAX];
+static pwm_channel_t channels[PWM_QTY];
+static bool fade_installed = false;
 /*==================[internal functions declaration]=========================*/
 
 /*==================[internal data definition]===============================*/
@@ -34,143 +48,234 @@ static ledc_channel_config_t ledc_channel_cfg = {
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+/* Highest resolution the timer divider allows at that frequency */
+static uint8_t PWMBits(uint32_t freq){
+    uint8_t bits = MAX_BITS;
+    while(bits > 1 && ((uint64_t)freq << bits) > SRC_CLK_HZ){
+        bits--;
+    }
+    return bits;
+}
+
+static bool PWMTimerConfig(ledc_timer_t timer, uint32_t freq){
+    ledc_timer_config_t timer_cfg = {
+        .speed_mode       = SPEED_MODE,
+        .duty_resolution  = PWMBits(freq),
+        .timer_num        = timer,
+        .freq_hz          = freq,
+        .clk_cfg          = LEDC_USE_PLL_DIV_CLK
+    };
+    if(ledc_timer_config(&timer_cfg) != ESP_OK){
+        return false;
+    }
+    timers[timer].freq = freq;
+    timers[timer].bits = timer_cfg.duty_resolution;
+    return true;
+}
+
+/* Timer in use with that frequency (LEDC_TIMER_MAX if none) */
+static ledc_timer_t PWMTimerFind(uint32_t freq){
+    for(ledc_timer_t t = 0; t < LEDC_TIMER_MAX; t++){
+        if(timers[t].users > 0 && timers[t].freq == freq){
+            return t;
+        }
+    }
+    return LEDC_TIMER_MAX;
+}
 
+/* Timer with that frequency, or a free one configured for it (LEDC_TIMER_MAX if none) */
+static ledc_timer_t PWMTimerGet(uint32_t freq){
+    ledc_timer_t timer = PWMTimerFind(freq);
+    if(timer == LEDC_TIMER_MAX){
+        for(timer = 0; timer < LEDC_TIMER_MAX && timers[timer].users > 0; timer++);
+        if(timer == LEDC_TIMER_MAX || !PWMTimerConfig(timer, freq)){
+            return LEDC_TIMER_MAX;
+        }
+    }
+    timers[timer].users++;
+    return timer;
+}
+
+static uint32_t PWMPermilleToTicks(pwm_out_t out, uint16_t duty){
+    if(duty > PWM_DUTY_PERMILLE_MAX){
+        duty = PWM_DUTY_PERMILLE_MAX;
+    }
+    return (((uint32_t)duty << timers[channels[out].timer].bits) + PWM_DUTY_PERMILLE_MAX / 2) / PWM_DUTY_PERMILLE_MAX;
+}
+
+static void PWMFadeStop(pwm_out_t out){
+    if(channels[out].fading){
+        channels[out].fading = false;
+        ledc_fade_stop(SPEED_MODE, (ledc_channel_t)out);
+    }
+}
+
+/* Write the stored duty cycle (only while the output is on) */
+static void PWMUpdate(pwm_out_t out){
+    PWMFadeStop(out);
+    if(channels[out].on){
+        ledc_set_duty(SPEED_MODE, (ledc_channel_t)out, channels[out].duty);
+        ledc_update_duty(SPEED_MODE, (ledc_channel_t)out);
+    }
+}
+
+static bool IRAM_ATTR PWMFadeEnd(const ledc_cb_param_t *param, void *user_arg){
+    pwm_channel_t *ch = &channels[(uintptr_t)user_arg];
+    if(param->event == LEDC_FADE_END_EVT && ch->fading){
+        ch->fading = false;
+        if(ch->func_p != NULL){
+            ch->func_p((pwm_out_t)(uintptr_t)user_arg, ch->param_p);
+        }
+    }
+    return false;
+}
 /*==================[external functions definition]==========================*/
 uint8_t PWMInit(pwm_out_t out, gpio_t gpio, uint16_t freq){
-    switch(out){
-        case PWM_0:
-            pwm_timer_cfg.freq_hz = freq;
-            pwm_timer_cfg.timer_num = LEDC_TIMER_0;
-            ledc_timer_config(&pwm_timer_cfg);
-            ledc_channel_cfg.channel = LEDC_CHANNEL_0;
-            ledc_channel_cfg.timer_sel = LEDC_TIMER_0;
-            ledc_channel_cfg.gpio_num = gpio;
-            ledc_channel_config(&ledc_channel_cfg);
-            break;
-        case PWM_1:
-            pwm_timer_cfg.freq_hz = freq;
-            pwm_timer_cfg.timer_num = LEDC_TIMER_1;
-            ledc_timer_config(&pwm_timer_cfg);
-            ledc_channel_cfg.channel = LEDC_CHANNEL_1;
-            ledc_channel_cfg.timer_sel = LEDC_TIMER_1;
-            ledc_channel_cfg.gpio_num = gpio;
-            ledc_channel_config(&ledc_channel_cfg);
-            break;
-        case PWM_2:
-            pwm_timer_cfg.freq_hz = freq;
-            pwm_timer_cfg.timer_num = LEDC_TIMER_2;
-            ledc_timer_config(&pwm_timer_cfg);
-            ledc_channel_cfg.channel = LEDC_CHANNEL_2;
-            ledc_channel_cfg.timer_sel = LEDC_TIMER_2;
-            ledc_channel_cfg.gpio_num = gpio;
-            ledc_channel_config(&ledc_channel_cfg);
-            break;
-        case PWM_3:
-            pwm_timer_cfg.freq_hz = freq;
-            pwm_timer_cfg.timer_num = LEDC_TIMER_3;
-            ledc_timer_config(&pwm_timer_cfg);
-            ledc_channel_cfg.channel = LEDC_CHANNEL_3;
-            ledc_channel_cfg.timer_sel = LEDC_TIMER_3;
-            ledc_channel_cfg.gpio_num = gpio;
-            ledc_channel_config(&ledc_channel_cfg);
-            break;
+    ledc_channel_config_t ledc_channel_cfg = {
+        .gpio_num       = gpio,
+        .speed_mode     = SPEED_MODE,
+        .channel        = (ledc_channel_t)out,
+        .intr_type      = LEDC_INTR_DISABLE,
+        .duty           = 0,       /*!< Starts in 0% */
+        .hpoint         = 0
+    };
+    if(out >= PWM_QTY || freq == 0){
+        return 1;
+    }
+    if(channels[out].init){
+        PWMDeinit(out);
+    }
+    if(!fade_installed){
+        ledc_fade_func_install(0);
+        fade_installed = true;
     }
+    ledc_channel_cfg.timer_sel = PWMTimerGet(freq);
+    if(ledc_channel_cfg.timer_sel == LEDC_TIMER_MAX){
+        return 1;
+    }
+    ledc_channel_config(&ledc_channel_cfg);
+    channels[out] = (pwm_channel_t){
+        .init = true,
+        .on = true,
+        .timer = ledc_channel_cfg.timer_sel,
+    };
     return 0;
 }
 
 void PWMOn(pwm_out_t out){
-    switch(out){
-        case PWM_0:
-            ledc_timer_resume(LEDC_LOW_SPEED_MODE, LEDC_TIMER_0);
-            break;
-        case PWM_1:
-            ledc_timer_resume(LEDC_LOW_SPEED_MODE, LEDC_TIMER_1);
-            break;
-        case PWM_2:
-            ledc_timer_resume(LEDC_LOW_SPEED_MODE, LEDC_TIMER_2);
-            break;
-        case PWM_3:
-            ledc_timer_resume(LEDC_LOW_SPEED_MODE, LEDC_TIMER_3);
-            break;
+    if(out >= PWM_QTY || !channels[out].init){
+        return;
     }
+    channels[out].on = true;
+    PWMUpdate(out);
 }
 
 void PWMOff(pwm_out_t out){
-    switch(out){
-        case PWM_0:
-            ledc_timer_pause(LEDC_LOW_SPEED_MODE, LEDC_TIMER_0);
-            break;
-        case PWM_1:
-            ledc_timer_pause(LEDC_LOW_SPEED_MODE, LEDC_TIMER_1);
-            break;
-        case PWM_2:
-            ledc_timer_pause(LEDC_LOW_SPEED_MODE, LEDC_TIMER_2);
-            break;
-        case PWM_3:
-            ledc_timer_pause(LEDC_LOW_SPEED_MODE, LEDC_TIMER_3);
-            break;
+    if(out >= PWM_QTY || !channels[out].init){
+        return;
     }
+    PWMFadeStop(out);
+    channels[out].on = false;
+    ledc_stop(SPEED_MODE, (ledc_channel_t)out, 0);
 }
 
 void PWMSetDutyCycle(pwm_out_t out, uint8_t duty_cycle){
-    if(duty_cycle > DC_100){
-        duty_cycle = DC_100;
-    }
-    uint32_t dc = ((uint32_t)duty_cycle * DC_MAX) / DC_100;
-    switch(out){
-        case PWM_0:
-            ledc_set_duty(LEDC_LOW_SPEED_MODE, LEDC_TIMER_0, dc);
-            ledc_update_duty(LEDC_LOW_SPEED_MODE, LEDC_TIMER_0);
-            break;
-        case PWM_1:
-            ledc_set_duty(LEDC_LOW_SPEED_MODE, LEDC_TIMER_1, dc);
-            ledc_update_duty(LEDC_LOW_SPEED_MODE, LEDC_TIMER_1);
-            break;
-        case PWM_2:
-            ledc_set_duty(LEDC_LOW_SPEED_MODE, LEDC_TIMER_2, dc);
-            ledc_update_duty(LEDC_LOW_SPEED_MODE, LEDC_TIMER_2);
-            break;
-        case PWM_3:
-            ledc_set_duty(LEDC_LOW_SPEED_MODE, LEDC_TIMER_3, dc);
-            ledc_update_duty(LEDC_LOW_SPEED_MODE, LEDC_TIMER_3);
-            break;
+    PWMSetDutyPermille(out, (uint16_t)duty_cycle * PERCENT_TO_PERMILLE);
+}
+
+void PWMSetDutyPermille(pwm_out_t out, uint16_t duty){
+    if(out >= PWM_QTY || !channels[out].init){
+        return;
+    }
+    channels[out].duty = PWMPermilleToTicks(out, duty);
+    PWMUpdate(out);
+}
+
+void PWMSetDutyTicks(pwm_out_t out, uint32_t ticks){
+    if(out >= PWM_QTY || !channels[out].init){
+        return;
+    }
+    if(ticks > PWMGetMaxTicks(out)){
+        ticks = PWMGetMaxTicks(out);
+    }
+    channels[out].duty = ticks;
+    PWMUpdate(out);
+}
+
+uint32_t PWMGetMaxTicks(pwm_out_t out){
+    if(out >= PWM_QTY || !channels[out].init){
+        return 0;
     }
+    return 1UL << timers[channels[out].timer].bits;
+}
+
+uint8_t PWMFade(pwm_out_t out, uint16_t duty, uint32_t time_ms, pwm_fade_func_t func_p, void *param_p){
+    ledc_cbs_t callbacks = {
+        .fade_cb = PWMFadeEnd
+    };
+    pwm_channel_t *ch;
+
+    if(out >= PWM_QTY || !channels[out].init){
+        return 1;
+    }
+    ch = &channels[out];
+    PWMFadeStop(out);
+    ch->duty = PWMPermilleToTicks(out, duty);
+    ch->func_p = func_p;
+    ch->param_p = param_p;
+    ch->on = true;
+    ch->fading = true;
+    ledc_cb_register(SPEED_MODE, (ledc_channel_t)out, &callbacks, (void *)(uintptr_t)out);
+    ledc_set_fade_with_time(SPEED_MODE, (ledc_channel_t)out, ch->duty, time_ms);
+    ledc_fade_start(SPEED_MODE, (ledc_channel_t)out, LEDC_FADE_NO_WAIT);
+    return 0;
 }
 
 uint8_t PWMSetFreq(pwm_out_t out, uint32_t freq){
-    switch(out){
-        case PWM_0:
-            ledc_set_freq(LEDC_LOW_SPEED_MODE, LEDC_TIMER_0, freq);
-            break;
-        case PWM_1:
-            ledc_set_freq(LEDC_LOW_SPEED_MODE, LEDC_TIMER_1, freq);
-            break;
-        case PWM_2:
-            ledc_set_freq(LEDC_LOW_SPEED_MODE, LEDC_TIMER_2, freq);
-            break;
-        case PWM_3:
-            ledc_set_freq(LEDC_LOW_SPEED_MODE, LEDC_TIMER_3, freq);
-            break;
+    ledc_timer_t timer;
+    uint8_t bits;
+
+    if(out >= PWM_QTY || !channels[out].init || freq == 0){
+        return 1;
+    }
+    timer = channels[out].timer;
+    if(timers[timer].freq == freq){
+        return 0;
+    }
+    bits = timers[timer].bits;
+    if(timers[timer].users == 1 && PWMTimerFind(freq) == LEDC_TIMER_MAX){
+        /* Only output of its timer: change the timer itself */
+        if(!PWMTimerConfig(timer, freq)){
+            return 1;
+        }
+    } else{
+        timer = PWMTimerGet(freq);
+        if(timer == LEDC_TIMER_MAX){
+            return 1;
+        }
+        ledc_bind_channel_timer(SPEED_MODE, (ledc_channel_t)out, timer);
+        timers[channels[out].timer].users--;
+        channels[out].timer = timer;
+    }
+    /* Same duty cycle with the new resolution */
+    if(timers[timer].bits > bits){
+        channels[out].duty <<= timers[timer].bits - bits;
+    } else{
+        channels[out].duty >>= bits - timers[timer].bits;
     }
+    PWMUpdate(out);
     return 0;
 }
 
 uint8_t PWMDeinit(pwm_out_t out){
-    switch(out){
-        case PWM_0:
-            ledc_stop(LEDC_LOW_SPEED_MODE, LEDC_CHANNEL_0, 0);
-            break;
-        case PWM_1:
-            ledc_stop(LEDC_LOW_SPEED_MODE, LEDC_CHANNEL_1, 0);
-            break;
-        case PWM_2:
-            ledc_stop(LEDC_LOW_SPEED_MODE, LEDC_CHANNEL_2, 0);
-            break;
-        case PWM_3:
-            ledc_stop(LEDC_LOW_SPEED_MODE, LEDC_CHANNEL_3, 0);
-            break;
+    if(out >= PWM_QTY || !channels[out].init){
+        return 1;
     }
+    PWMFadeStop(out);
+    ledc_stop(SPEED_MODE, (ledc_channel_t)out, 0);
+    timers[channels[out].timer].users--;
+    channels[out].init = false;
     return 0;
 }
 
-/*==================[end of file]============================================*/
\ No newline at end of file
+/*==================[end of file]============================================*/
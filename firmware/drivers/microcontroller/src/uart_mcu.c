@@ -10,10 +10,14 @@
  */
 
 /*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include <string.h>
 #include "uart_mcu.h"
 #include "gpio_mcu.h"
+#include "format_mcu.h"
 #include "driver/uart.h"
 #include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "freertos/queue.h"
 #include "esp_log.h"
 /*==================[macros and definitions]=================================*/
@@ -23,6 +27,9 @@
 #define RX_BUFFER_SIZE      256             /*!<  */
 #define EVENT_QUEUE_SIZE    16              /*!<  */
 #define READ_TIMEOUT        100             /*!<  */
+#define UART_PORTS          2               /*!< Number of ports in uart_mcu_port_t */
+#define UART_FRAME_SIZE     256             /*!< Default max frame length */
+#define UART_FRAME_IDLE     10              /*!< Default idle time ending a frame (in characters) */
 /*==================[internal data declaration]==============================*/
 void (*uart_pc_isr_p)(void*);	            /*!<  */
 void (*uart_conn_isr_p)(void*);	            /*!<  */
@@ -30,6 +37,25 @@ void *uart_pc_user_data;	                /*!<  */
 void *uart_conn_user_data;	                /*!<  */
 static QueueHandle_t uart_pc_queue;         /*!<  */
 static QueueHandle_t uart_conn_queue;       /*!<  */
+/**
+ * @brief Buffer waiting to be sent by UartSendOwned()
+ */
+typedef struct {
+    const uint8_t *data;                                /*!< Data (owned by the driver until sent) */
+    uint32_t nbytes;                                    /*!< Number of bytes */
+    void (*done_p)(const uint8_t *data, void *param);   /*!< Called when the buffer can be reused */
+    void *param_p;                                      /*!< done_p parameter */
+} uart_tx_item_t;
+static uint32_t uart_rx_size[UART_PORTS];   /*!< RX ring buffer size of each port */
+static uint32_t uart_tx_size[UART_PORTS];   /*!< TX ring buffer size of each port (0: none) */
+static QueueHandle_t uart_tx_queue[UART_PORTS];  /*!< Buffers given to UartSendOwned() */
+static volatile uint32_t uart_tx_owned[UART_PORTS]; /*!< Owned buffers queued or being written */
+static portMUX_TYPE uart_tx_mux = portMUX_INITIALIZER_UNLOCKED;    /*!< Protects uart_tx_owned */
+static uart_frame_config_t uart_frame[UART_PORTS];  /*!< Frame reception configuration of each port */
+static uint8_t *uart_frame_buf[UART_PORTS];     /*!< Frame being received */
+static uint16_t uart_frame_len[UART_PORTS];     /*!< Bytes in uart_frame_buf */
+static bool uart_frame_overrun[UART_PORTS];     /*!< Current frame didn't fit in uart_frame_buf */
+static uint32_t uart_frame_errors[UART_PORTS];  /*!< Frames lost */
 /*==================[internal functions declaration]=========================*/
 
 /*==================[internal data definition]===============================*/
@@ -37,21 +63,139 @@ static QueueHandle_t uart_conn_queue;       /*!<  */
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+static uart_port_t UartNum(uart_mcu_port_t port){
+    return (port == UART_CONNECTOR) ? UART_NUM_1 : UART_NUM_0;
+}
+
+static void uart_tx_task(void *pvParameters){
+    uart_mcu_port_t port = (uart_mcu_port_t)(uintptr_t)pvParameters;
+    uart_tx_item_t item;
+    while(1){
+        if(xQueueReceive(uart_tx_queue[port], &item, portMAX_DELAY)){
+            /* Without TX ring buffer the data goes straight from item.data to the FIFO */
+            uart_write_bytes(UartNum(port), item.data, item.nbytes);
+            if(item.done_p != NULL){
+                item.done_p(item.data, item.param_p);
+            }
+            portENTER_CRITICAL(&uart_tx_mux);
+            uart_tx_owned[port]--;
+            portEXIT_CRITICAL(&uart_tx_mux);
+        }
+    }
+}
+
+/* Read n bytes of the driver buffer into the frame (bytes that don't fit are discarded) */
+static void UartFrameRead(uart_mcu_port_t port, uint32_t n){
+    uint8_t discard[32];
+    uint32_t room = uart_frame[port].max_frame - uart_frame_len[port];
+    uint32_t chunk;
+
+    if(n <= room){
+        uart_frame_len[port] += uart_read_bytes(UartNum(port), &uart_frame_buf[port][uart_frame_len[port]], n, 0);
+        return;
+    }
+    uart_frame_len[port] += uart_read_bytes(UartNum(port), &uart_frame_buf[port][uart_frame_len[port]], room, 0);
+    n -= room;
+    uart_frame_overrun[port] = true;
+    while(n > 0){
+        chunk = (n > sizeof(discard)) ? sizeof(discard) : n;
+        uart_read_bytes(UartNum(port), discard, chunk, 0);
+        n -= chunk;
+    }
+}
+
+/* Deliver the received frame and start a new one */
+static void UartFrameEnd(uart_mcu_port_t port){
+    if(uart_frame_overrun[port]){
+        uart_frame_errors[port]++;
+    }else if(uart_frame_len[port] > 0){
+        uart_frame[port].frame_p(uart_frame_buf[port], uart_frame_len[port], uart_frame[port].param_p);
+    }
+    uart_frame_len[port] = 0;
+    uart_frame_overrun[port] = false;
+}
+
+/* Configure frame reception (called once the driver is installed) */
+static void UartFrameSetup(uart_mcu_port_t port){
+    uart_port_t uart_num = UartNum(port);
+    if(uart_frame[port].frame_p == NULL){
+        return;
+    }
+    if(uart_frame[port].terminator_count > 0){
+        uart_enable_pattern_det_baud_intr(uart_num, uart_frame[port].terminator,
+                                          uart_frame[port].terminator_count, 9, 0, 0);
+        uart_pattern_queue_reset(uart_num, EVENT_QUEUE_SIZE);
+    }else{
+        uart_set_rx_timeout(uart_num, uart_frame[port].idle_symbols ? uart_frame[port].idle_symbols : UART_FRAME_IDLE);
+    }
+}
+
+/* UART_DATA event: with idle line framing the frame ends when the line goes idle */
+static void UartFrameData(uart_mcu_port_t port, const uart_event_t *event){
+    if(uart_frame[port].terminator_count > 0){
+        /* Data stays in the driver until the terminator arrives */
+        return;
+    }
+    UartFrameRead(port, event->size);
+    if(event->timeout_flag){
+        UartFrameEnd(port);
+    }
+}
+
+/* UART_PATTERN_DET event: the frame ends at the terminator */
+static void UartFramePattern(uart_mcu_port_t port){
+    uart_port_t uart_num = UartNum(port);
+    int pos = uart_pattern_pop_pos(uart_num);
+    uint8_t terminator[UART_FRAME_MAX_TERMINATOR];
+
+    if(pos < 0){
+        /* Position queue overflow: frames can't be delimited any more */
+        uart_flush_input(uart_num);
+        uart_pattern_queue_reset(uart_num, EVENT_QUEUE_SIZE);
+        uart_frame_len[port] = 0;
+        uart_frame_overrun[port] = false;
+        uart_frame_errors[port]++;
+        return;
+    }
+    UartFrameRead(port, pos);
+    uart_read_bytes(uart_num, terminator, uart_frame[port].terminator_count, 0);
+    UartFrameEnd(port);
+}
+
+/* UART_BUFFER_FULL or UART_FIFO_OVF events: received data is lost */
+static void UartFrameOverflow(uart_mcu_port_t port){
+    uart_port_t uart_num = UartNum(port);
+    uart_flush_input(uart_num);
+    if(uart_frame[port].terminator_count > 0){
+        uart_pattern_queue_reset(uart_num, EVENT_QUEUE_SIZE);
+    }
+    uart_frame_len[port] = 0;
+    uart_frame_overrun[port] = false;
+    uart_frame_errors[port]++;
+}
+
 static void uart_pc_event_task(void *pvParameters){
     uart_event_t event;
-    uart_driver_install(UART_NUM_0, RX_BUFFER_SIZE, TX_BUFFER_SIZE, 16, &uart_pc_queue, 0);
+    uart_driver_install(UART_NUM_0, uart_rx_size[UART_PC], uart_tx_size[UART_PC], EVENT_QUEUE_SIZE, &uart_pc_queue, 0);
+    UartFrameSetup(UART_PC);
     while(1){
         //Waiting for UART event.
         if (xQueueReceive(uart_pc_queue, (void *)&event, (TickType_t)portMAX_DELAY)){
             switch(event.type) {
                 case UART_DATA:
-                    uart_pc_isr_p(uart_pc_user_data);
+                    if(uart_frame[UART_PC].frame_p != NULL){
+                        UartFrameData(UART_PC, &event);
+                    }else{
+                        uart_pc_isr_p(uart_pc_user_data);
+                    }
                     break;
                 case UART_BREAK:
                     break;
                 case UART_BUFFER_FULL:
-                    break;
                 case UART_FIFO_OVF:
+                    if(uart_frame[UART_PC].frame_p != NULL){
+                        UartFrameOverflow(UART_PC);
+                    }
                     break;
                 case UART_FRAME_ERR:
                     break;
@@ -60,6 +204,9 @@ static void uart_pc_event_task(void *pvParameters){
                 case UART_DATA_BREAK:
                     break;
                 case UART_PATTERN_DET:
+                    if(uart_frame[UART_PC].frame_p != NULL){
+                        UartFramePattern(UART_PC);
+                    }
                     break;
                 case UART_WAKEUP:
                     break;
@@ -72,19 +219,26 @@ static void uart_pc_event_task(void *pvParameters){
 
 static void uart_conn_event_task(void *pvParameters){
     uart_event_t event;
-    uart_driver_install(UART_NUM_1, RX_BUFFER_SIZE, TX_BUFFER_SIZE, 16, &uart_conn_queue, 0);
+    uart_driver_install(UART_NUM_1, uart_rx_size[UART_CONNECTOR], uart_tx_size[UART_CONNECTOR], EVENT_QUEUE_SIZE, &uart_conn_queue, 0);
+    UartFrameSetup(UART_CONNECTOR);
     while(1){
         //Waiting for UART event.
         if(xQueueReceive(uart_conn_queue, (void *)&event, (TickType_t)portMAX_DELAY)){
             switch(event.type) {
                 case UART_DATA:
-                    uart_conn_isr_p(uart_conn_user_data);
+                    if(uart_frame[UART_CONNECTOR].frame_p != NULL){
+                        UartFrameData(UART_CONNECTOR, &event);
+                    }else{
+                        uart_conn_isr_p(uart_conn_user_data);
+                    }
                     break;
                 case UART_BREAK:
                     break;
                 case UART_BUFFER_FULL:
-                    break;
                 case UART_FIFO_OVF:
+                    if(uart_frame[UART_CONNECTOR].frame_p != NULL){
+                        UartFrameOverflow(UART_CONNECTOR);
+                    }
                     break;
                 case UART_FRAME_ERR:
                     break;
@@ -93,6 +247,9 @@ static void uart_conn_event_task(void *pvParameters){
                 case UART_DATA_BREAK:
                     break;
                 case UART_PATTERN_DET:
+                    if(uart_frame[UART_CONNECTOR].frame_p != NULL){
+                        UartFramePattern(UART_CONNECTOR);
+                    }
                     break;
                 case UART_WAKEUP:
                     break;
@@ -113,30 +270,58 @@ void UartInit(serial_config_t *port_config){
         .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
         .source_clk = UART_SCLK_DEFAULT,
     };
+    uart_mcu_port_t port = port_config->port;
+    uart_rx_size[port] = (port_config->rx_buffer_size > RX_BUFFER_SIZE) ? port_config->rx_buffer_size : RX_BUFFER_SIZE;
+    if(port_config->tx_buffer_size > TX_BUFFER_SIZE){
+        uart_tx_size[port] = port_config->tx_buffer_size;
+    }else if(port_config->tx_buffer_size == 0 && port_config->tx_queue_size > 0){
+        uart_tx_size[port] = 0;
+    }else{
+        uart_tx_size[port] = TX_BUFFER_SIZE;
+    }
+    if(port_config->frame_config != NULL && port_config->frame_config->frame_p != NULL &&
+       uart_frame_buf[port] == NULL){
+        uart_frame[port] = *port_config->frame_config;
+        if(uart_frame[port].max_frame == 0){
+            uart_frame[port].max_frame = UART_FRAME_SIZE;
+        }
+        if(uart_frame[port].terminator_count > UART_FRAME_MAX_TERMINATOR){
+            uart_frame[port].terminator_count = UART_FRAME_MAX_TERMINATOR;
+        }
+        uart_frame_buf[port] = malloc(uart_frame[port].max_frame);
+        if(uart_frame_buf[port] == NULL){
+            uart_frame[port].frame_p = NULL;
+        }
+    }
     switch(port_config->port){
         case UART_PC:
             uart_param_config(UART_NUM_0, &uart_config);
             uart_set_pin(UART_NUM_0, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
-            if(port_config->func_p != UART_NO_INT){
+            if(port_config->func_p != UART_NO_INT || uart_frame[UART_PC].frame_p != NULL){
                 uart_pc_isr_p = port_config->func_p;
-                uart_pc_queue = port_config->param_p;
+                uart_pc_user_data = port_config->param_p;
                 xTaskCreate(uart_pc_event_task, "uart_pc_event_task", 2048, NULL, 12, 0);
             }else{
-                uart_driver_install(UART_NUM_0, RX_BUFFER_SIZE, TX_BUFFER_SIZE, 0, NULL, 0);
+                uart_driver_install(UART_NUM_0, uart_rx_size[UART_PC], uart_tx_size[UART_PC], 0, NULL, 0);
             }
             break;
         case UART_CONNECTOR:
             uart_param_config(UART_NUM_1, &uart_config);
             uart_set_pin(UART_NUM_1, UART_CONN_TX, UART_CONN_RX, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
-            if(port_config->func_p != UART_NO_INT){
+            if(port_config->func_p != UART_NO_INT || uart_frame[UART_CONNECTOR].frame_p != NULL){
                 uart_conn_isr_p = port_config->func_p;
-                uart_conn_queue = port_config->param_p;
+                uart_conn_user_data = port_config->param_p;
                 xTaskCreate(uart_conn_event_task, "uart_conn_event_task", 2048, NULL, 12, NULL);
             }else{
-                uart_driver_install(UART_NUM_1, RX_BUFFER_SIZE, TX_BUFFER_SIZE, 0, NULL, 0);
+                uart_driver_install(UART_NUM_1, uart_rx_size[UART_CONNECTOR], uart_tx_size[UART_CONNECTOR], 0, NULL, 0);
             }
             break;
     }
+    if(port_config->tx_queue_size > 0 && uart_tx_queue[port] == NULL){
+        uart_tx_queue[port] = xQueueCreate(port_config->tx_queue_size, sizeof(uart_tx_item_t));
+        xTaskCreate(uart_tx_task, (port == UART_PC) ? "uart_pc_tx_task" : "uart_conn_tx_task",
+                    2048, (void *)(uintptr_t)port, 12, NULL);
+    }
 }
 
 uint8_t UartReadByte(uart_mcu_port_t port, uint8_t* data){
@@ -187,7 +372,7 @@ void UartSendByte(uart_mcu_port_t port, const char *data){
                 uart_num = UART_NUM_1;
             break;
     }
-    uart_tx_chars(uart_num, data, 1);
+    uart_write_bytes(uart_num, data, 1);
 }
 
 void UartSendString(uart_mcu_port_t port, const char *msg){
@@ -200,13 +385,10 @@ void UartSendString(uart_mcu_port_t port, const char *msg){
                 uart_num = UART_NUM_1;
             break;
     }
-	while(*msg != 0){
-        uart_tx_chars(uart_num, msg, 1);
-		msg++;
-	}
+    uart_write_bytes(uart_num, msg, strlen(msg));
 }
 
-void UartSendBuffer(uart_mcu_port_t port, const char *data, uint8_t nbytes){
+void UartSendBuffer(uart_mcu_port_t port, const char *data, uint32_t nbytes){
     uart_port_t uart_num = UART_NUM_0;
     switch(port){
         case UART_PC:
@@ -216,20 +398,53 @@ void UartSendBuffer(uart_mcu_port_t port, const char *data, uint8_t nbytes){
                 uart_num = UART_NUM_1;
             break;
     }
-    uart_tx_chars(uart_num, data, nbytes);
+    uart_write_bytes(uart_num, data, nbytes);
 }
 
-uint8_t* UartItoa(uint32_t val, uint8_t base){
-	static uint8_t buf[32] = {0};
-	uint32_t i = 30;
-    if(val == 0){
-        return (uint8_t*)"0";
-    }else{
-        for(; val && i ; --i, val /= base){
-            buf[i] = "0123456789abcdef"[val % base];
+bool UartSendOwned(uart_mcu_port_t port, const uint8_t *data, uint32_t nbytes,
+                   void (*done_p)(const uint8_t *data, void *param), void *param_p){
+    uart_tx_item_t item = {
+        .data = data,
+        .nbytes = nbytes,
+        .done_p = done_p,
+        .param_p = param_p,
+    };
+    if(uart_tx_queue[port] == NULL){
+        return false;
+    }
+    portENTER_CRITICAL(&uart_tx_mux);
+    uart_tx_owned[port]++;
+    portEXIT_CRITICAL(&uart_tx_mux);
+    if(xQueueSend(uart_tx_queue[port], &item, 0) != pdTRUE){
+        portENTER_CRITICAL(&uart_tx_mux);
+        uart_tx_owned[port]--;
+        portEXIT_CRITICAL(&uart_tx_mux);
+        return false;
+    }
+    return true;
+}
+
+uint32_t UartFrameErrors(uart_mcu_port_t port){
+    return uart_frame_errors[port];
+}
+
+bool UartWaitTxDone(uart_mcu_port_t port, uint32_t timeout_ms){
+    /* Owned buffers queued, or taken by uart_tx_task but not written yet, are not in the driver */
+    while(uart_tx_owned[port] > 0){
+        if(timeout_ms == 0){
+            return false;
         }
-        return &buf[i+1];
+        vTaskDelay(1);
+        timeout_ms = (timeout_ms > portTICK_PERIOD_MS) ? timeout_ms - portTICK_PERIOD_MS : 0;
     }
+    return uart_wait_tx_done(UartNum(port), pdMS_TO_TICKS(timeout_ms)) == ESP_OK;
+}
+
+uint8_t* UartItoa(uint32_t val, uint8_t base){
+    /* One buffer per task, so tasks converting at the same time don't overwrite each other */
+    static __thread uint8_t buf[FORMAT_BIN_SIZE];
+    FormatBase((char*)buf, val, base);
+    return buf;
 }
 
 /*==================[end of file]============================================*/
\ No newline at end of file
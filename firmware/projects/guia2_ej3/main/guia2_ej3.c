@@ -107,7 +107,6 @@ static void Led3Task(void *pvParameter) {
  */
 static void MeasurementTask(void *pvParameter) {
     uint32_t distance_cm = 0;
-    char lcd_buffer[32];
     char uart_buffer[32];
     bool lcd_initialized = LcdItsE0803Init();
     if (!lcd_initialized) {
@@ -130,9 +129,7 @@ static void MeasurementTask(void *pvParameter) {
         } else if (xSemaphoreTake(measure_button_semaphore, portMAX_DELAY) == pdTRUE) {
             if (!hold_flag) {
                 distance_cm = HcSr04ReadDistanceInCentimeters();
-                snprintf(lcd_buffer, sizeof(lcd_buffer), "Distancia: %lu cm", distance_cm);
-                LcdItsE0803Write(0); // Clear the display
-                LcdItsE0803Write(lcd_buffer); // Display the new string
+                LcdItsE0803Write(distance_cm); // Display the distance (refreshed by the driver)
                 if (distance_cm < 10) {
                     LedOff(LED_1);
                     LedOff(LED_2);
@@ -0,0 +1,193 @@
+/**
+ * @file format_bench.c
+ * @brief Host benchmark and equivalence check of format_mcu against snprintf.
+ *
+ * Every Format*() function is compared against the snprintf() format it
+ * replaces over edge values and a pseudo random sweep, then both are timed.
+ * Build and run from firmware/tools/bench:
+ *
+ *     gcc -O2 -Wall -Wextra -I../../drivers/microcontroller/inc format_bench.c -o format_bench -lm
+ *     ./format_bench
+ *
+ * FormatFloat() works in single precision, so its output is accepted when it
+ * is within one unit of the last decimal (plus the float error) of "%.*f".
+ * Host timings only show the relative cost, newlib's snprintf on the
+ * ESP32-C6 is much slower than glibc's.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <float.h>
+#include <time.h>
+#include "../../drivers/microcontroller/src/format_mcu.c"
+
+#define SWEEP		1000000
+#define ROUNDS		2000000
+
+static char buf[64];
+static char ref[64];
+static uint32_t errors;
+static volatile uint32_t sink;
+
+static double Now(void){
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* xorshift32, same sequence on every run */
+static uint32_t Random(void){
+  static uint32_t x = 2463534242u;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return x;
+}
+
+static void Check(const char *func, uint8_t len, const char *arg){
+  if (strcmp(buf, ref) != 0 || len != strlen(ref)) {
+    if (errors < 10) {
+      printf("  %s(%s): \"%s\" (%u), expected \"%s\"\n", func, arg, buf, len, ref);
+    }
+    errors++;
+  }
+}
+
+static void CheckUint(uint32_t val){
+  char arg[16];
+  snprintf(arg, sizeof(arg), "%" PRIu32, val);
+  snprintf(ref, sizeof(ref), "%" PRIu32, val);
+  Check("FormatUint", FormatUint(buf, val), arg);
+  snprintf(ref, sizeof(ref), "%0*" PRIu32, (int)(val % 13), val);
+  Check("FormatUintPad", FormatUintPad(buf, val, val % 13, '0'), arg);
+  snprintf(ref, sizeof(ref), "%*" PRIu32, (int)(val % 13), val);
+  Check("FormatUintPad", FormatUintPad(buf, val, val % 13, ' '), arg);
+  snprintf(ref, sizeof(ref), "%" PRIx32, val);
+  Check("FormatHex", FormatHex(buf, val, 0), arg);
+  snprintf(ref, sizeof(ref), "%0*" PRIx32, (int)(val % 9), val);
+  Check("FormatHex", FormatHex(buf, val, val % 9), arg);
+}
+
+static void CheckInt(int32_t val){
+  char arg[16];
+  uint8_t decimals = (uint32_t)val % (FORMAT_MAX_DECIMALS + 1);
+  uint32_t abs_val = (val < 0) ? 0u - (uint32_t)val : (uint32_t)val;
+
+  snprintf(arg, sizeof(arg), "%" PRId32, val);
+  snprintf(ref, sizeof(ref), "%" PRId32, val);
+  Check("FormatInt", FormatInt(buf, val), arg);
+  if (decimals == 0) {
+    snprintf(ref, sizeof(ref), "%" PRId32, val);
+  } else {
+    snprintf(ref, sizeof(ref), "%s%" PRIu32 ".%0*" PRIu32, (val < 0) ? "-" : "",
+             abs_val / pow10[decimals], (int)decimals, abs_val % pow10[decimals]);
+  }
+  Check("FormatFixed", FormatFixed(buf, val, decimals), arg);
+}
+
+static void CheckFloat(float val, uint8_t decimals){
+  char arg[32];
+  double diff, tol;
+  uint8_t len = FormatFloat(buf, val, decimals);
+
+  snprintf(ref, sizeof(ref), "%.*f", decimals, val);
+  if (strcmp(buf, ref) == 0 && len == strlen(ref)) {
+    return;
+  }
+  /* Different rounding is fine, a different value is not */
+  diff = fabs(strtod(buf, NULL) - strtod(ref, NULL));
+  tol = 1.0 / pow10[decimals] + fabs(val) * 2 * FLT_EPSILON;
+  if (len != strlen(buf) || diff > tol) {
+    snprintf(arg, sizeof(arg), "%.9g, %u", val, decimals);
+    Check("FormatFloat", len, arg);
+  }
+}
+
+int main(void){
+  static const uint32_t uint_edges[] = {
+    0, 1, 9, 10, 99, 100, 999, 1000, 9999, 10000, 99999, 100000, 999999, 1000000,
+    9999999, 10000000, 99999999, 100000000, 999999999, 1000000000, 0x7FFFFFFF,
+    0x80000000, 0xFFFFFFFE, 0xFFFFFFFF
+  };
+  static const float float_edges[] = {
+    0.0f, -0.0f, 0.5f, 0.05f, 0.005f, 0.999f, 1.0f, -1.0f, 9.995f, 3.14159265f,
+    -273.15f, 100.0f, 12345.678f, 999999.9f, 16777216.0f, 999999936.0f
+  };
+  uint32_t int_errors;
+  double t, t_ref, t_new;
+
+  /* Integers: must be identical */
+  for (uint8_t i = 0; i < sizeof(uint_edges) / sizeof(uint_edges[0]); i++) {
+    CheckUint(uint_edges[i]);
+    CheckInt((int32_t)uint_edges[i]);
+    CheckInt(-(int32_t)(uint_edges[i] & 0x7FFFFFFF));
+  }
+  CheckInt(INT32_MIN);
+  for (uint32_t n = 0; n < SWEEP; n++) {
+    uint32_t r = Random();
+    /* Shift so that every length is tested, not only 10 digit numbers */
+    r >>= r % 32;
+    CheckUint(r);
+    CheckInt((int32_t)Random() >> (r % 32));
+  }
+  printf("FormatUint/UintPad/Hex/Int/Fixed: %u mismatches\n", errors);
+
+  /* Floats below EXP_LIMIT: same value as "%.*f" */
+  int_errors = errors;
+  errors = 0;
+  for (uint8_t i = 0; i < sizeof(float_edges) / sizeof(float_edges[0]); i++) {
+    for (uint8_t d = 0; d <= 6; d++) {
+      CheckFloat(float_edges[i], d);
+    }
+  }
+  for (uint32_t n = 0; n < SWEEP; n++) {
+    float val = (float)((int32_t)Random()) / (float)(1u << (Random() % 31));
+    if (fabsf(val) < EXP_LIMIT) {
+      CheckFloat(val, n % 7);
+    }
+  }
+  printf("FormatFloat: %u out of tolerance\n", errors);
+
+  /* Timing */
+  t = Now();
+  for (uint32_t n = 0; n < ROUNDS; n++) {
+    sink += snprintf(buf, sizeof(buf), "%" PRIu32, n * 2654435761u);
+  }
+  t_ref = Now() - t;
+  t = Now();
+  for (uint32_t n = 0; n < ROUNDS; n++) {
+    sink += FormatUint(buf, n * 2654435761u);
+  }
+  t_new = Now() - t;
+  printf("uint: snprintf %.1f ns, FormatUint %.1f ns (x%.1f)\n",
+         t_ref * 1e9 / ROUNDS, t_new * 1e9 / ROUNDS, t_ref / t_new);
+
+  t = Now();
+  for (uint32_t n = 0; n < ROUNDS; n++) {
+    sink += snprintf(buf, sizeof(buf), "%08" PRIx32, n * 2654435761u);
+  }
+  t_ref = Now() - t;
+  t = Now();
+  for (uint32_t n = 0; n < ROUNDS; n++) {
+    sink += FormatHex(buf, n * 2654435761u, 8);
+  }
+  t_new = Now() - t;
+  printf("hex: snprintf %.1f ns, FormatHex %.1f ns (x%.1f)\n",
+         t_ref * 1e9 / ROUNDS, t_new * 1e9 / ROUNDS, t_ref / t_new);
+
+  t = Now();
+  for (uint32_t n = 0; n < ROUNDS; n++) {
+    sink += snprintf(buf, sizeof(buf), "%.3f", (int32_t)n * 0.137f);
+  }
+  t_ref = Now() - t;
+  t = Now();
+  for (uint32_t n = 0; n < ROUNDS; n++) {
+    sink += FormatFloat(buf, (int32_t)n * 0.137f, 3);
+  }
+  t_new = Now() - t;
+  printf("float: snprintf %.1f ns, FormatFloat %.1f ns (x%.1f)\n",
+         t_ref * 1e9 / ROUNDS, t_new * 1e9 / ROUNDS, t_ref / t_new);
+
+  return (int_errors || errors) ? 1 : 0;
+}
@@ -0,0 +1,9 @@
+/* Host build shim of esp_err.h (only what the benchmarked drivers use) */
+#ifndef HOST_ESP_ERR_H
+#define HOST_ESP_ERR_H
+typedef int esp_err_t;
+#define ESP_OK				0
+#define ESP_FAIL			-1
+#define ESP_ERR_INVALID_STATE	0x103
+#define ESP_ERR_TIMEOUT		0x107
+#endif
@@ -0,0 +1,14 @@
+/* Host build shim of FreeRTOS.h: single threaded, every call succeeds at once */
+#ifndef HOST_FREERTOS_H
+#define HOST_FREERTOS_H
+#include <stdint.h>
+#include <stddef.h>
+typedef int BaseType_t;
+typedef uint32_t TickType_t;
+#define pdFALSE					0
+#define pdTRUE					1
+#define portMAX_DELAY			0xFFFFFFFF
+#define pdMS_TO_TICKS(ms)		(ms)
+#define portYIELD_FROM_ISR(x)	(void)(x)
+#define IRAM_ATTR
+#endif
@@ -0,0 +1,11 @@
+/* Host build shim of semphr.h */
+#ifndef HOST_SEMPHR_H
+#define HOST_SEMPHR_H
+#include "freertos/FreeRTOS.h"
+typedef void *SemaphoreHandle_t;
+static inline SemaphoreHandle_t xSemaphoreCreateMutex(void){ return (SemaphoreHandle_t)1; }
+static inline SemaphoreHandle_t xSemaphoreCreateCounting(uint32_t max, uint32_t init){ return (SemaphoreHandle_t)1; }
+static inline BaseType_t xSemaphoreTake(SemaphoreHandle_t s, TickType_t t){ return pdTRUE; }
+static inline BaseType_t xSemaphoreGive(SemaphoreHandle_t s){ return pdTRUE; }
+static inline BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t s, BaseType_t *woken){ return pdTRUE; }
+#endif
@@ -0,0 +1,10 @@
+/* Host build shim of task.h */
+#ifndef HOST_TASK_H
+#define HOST_TASK_H
+#include "freertos/FreeRTOS.h"
+typedef void *TaskHandle_t;
+static inline BaseType_t xTaskCreate(void (*func)(void *), const char *name, uint32_t stack,
+									 void *param, int prio, TaskHandle_t *handle){ return pdTRUE; }
+static inline TickType_t xTaskGetTickCount(void){ return 0; }
+static inline void vTaskDelayUntil(TickType_t *prev, TickType_t inc){ }
+#endif
@@ -0,0 +1 @@
+/* Host build shim: no Kconfig options are needed by the benchmarked code */
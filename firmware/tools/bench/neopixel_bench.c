@@ -0,0 +1,171 @@
+/**
+ * @file neopixel_bench.c
+ * @brief Host benchmark of the NeoPixel color conversions.
+ *
+ * Compares NeoPixelHSV2ColorArray() against the per-LED NeoPixelHSV2Color()
+ * loop used before by NeoPixelRainbow(), checks both give the same colors and
+ * times the palette interpolation. Build and run from firmware/tools/bench:
+ *
+ *     gcc -O2 -Wall -Wextra -Wno-unused-parameter -Ihost -I../../drivers/devices/inc \
+ *         -I../../drivers/microcontroller/inc neopixel_bench.c -o neopixel_bench
+ *     ./neopixel_bench
+ *
+ * Host timings only show the relative cost, absolute values on the ESP32-C6
+ * are several times higher.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../../drivers/devices/src/neopixel_stripe.c"
+
+#define LEDS		300
+#define ROUNDS		20000
+
+/* ws2812b is not used by the conversions, these only satisfy the linker */
+void ws2812bInit(gpio_t pin){ }
+void ws2812bSetCallback(void (*func_p)(void *param), void *param_p){ }
+esp_err_t ws2812bTransmit(const uint8_t *grb, uint32_t len){ return ESP_OK; }
+bool ws2812bBusy(void){ return false; }
+esp_err_t ws2812bWait(int32_t timeout_ms){ return ESP_OK; }
+uint8_t ws2812bGammaCorrection(uint8_t component){ return component; }
+bool ws2812bParallelInit(gpio_t *pins, uint8_t qty){ return false; }
+void ws2812bParallelTransmit(const uint8_t *const grb[], const uint32_t len[]){ }
+void ws2812bSend(rgb_led_t led_color){ }
+void ws2812bSendRet(void){ }
+
+/* NeoPixelHSV2Color() before the fixed point rework */
+static neopixel_color_t OldHSV2Color(uint16_t hue, uint8_t sat, uint8_t val){
+  uint8_t r, g, b;
+
+  hue = (hue * 1530L + 32768) / 65536;
+  if (hue < 510) {
+    b = 0;
+    if (hue < 255) { r = 255; g = hue; } else { r = 510 - hue; g = 255; }
+  } else if (hue < 1020) {
+    r = 0;
+    if (hue < 765) { g = 255; b = hue - 510; } else { g = 1020 - hue; b = 255; }
+  } else if (hue < 1530) {
+    g = 0;
+    if (hue < 1275) { r = hue - 1020; b = 255; } else { r = 255; b = 1530 - hue; }
+  } else {
+    r = 255;
+    g = b = 0;
+  }
+  uint32_t v1 = 1 + val;
+  uint16_t s1 = 1 + sat;
+  uint8_t s2 = 255 - sat;
+  return ((((((r * s1) >> 8) + s2) * v1) & 0xff00) << 8) |
+         (((((g * s1) >> 8) + s2) * v1) & 0xff00) |
+         (((((b * s1) >> 8) + s2) * v1) >> 8);
+}
+
+/* NeoPixelRainbow() loop before the fixed point rework */
+static void OldRainbow(neopixel_color_t *colors, uint16_t len, uint16_t first_hue, uint8_t sat, uint8_t val, uint8_t reps){
+  for (uint16_t i = 0; i < len; i++) {
+    uint16_t hue = first_hue + (i * reps * 65536) / len;
+    colors[i] = OldHSV2Color(hue, sat, val);
+  }
+}
+
+/* Reference blend, channel by channel */
+static neopixel_color_t RefPaletteColor(const neopixel_palette_t *palette, uint16_t index){
+  uint8_t entry = index >> 12;
+  uint32_t frac = (index >> 4) & 0xFF;
+  neopixel_color_t c1 = palette->colors[entry];
+  neopixel_color_t c2 = palette->colors[(entry + 1) & (NEOPIXEL_PALETTE_SIZE - 1)];
+  neopixel_color_t out = 0;
+
+  for (uint8_t shift = 0; shift < 24; shift += 8) {
+    uint32_t a = (c1 >> shift) & 0xFF;
+    uint32_t b = (c2 >> shift) & 0xFF;
+    out |= (((a * (256 - frac) + b * frac) >> 8) & 0xFF) << shift;
+  }
+  return out;
+}
+
+static double Now(void){
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static neopixel_color_t old_colors[LEDS];
+static neopixel_color_t new_colors[LEDS];
+static volatile uint32_t sink;
+
+int main(void){
+  neopixel_palette_t palette;
+  uint32_t errors = 0;
+  uint32_t diff_pixels = 0;
+  double t, t_old, t_new, t_ref, t_pal;
+
+  /* Single conversion: same result for every hue */
+  for (uint32_t hue = 0; hue < 65536; hue++) {
+    for (uint16_t sv = 0; sv < 256; sv += 51) {
+      if (NeoPixelHSV2Color(hue, sv, 255 - sv) != OldHSV2Color(hue, sv, 255 - sv)) {
+        errors++;
+      }
+    }
+  }
+  printf("NeoPixelHSV2Color: %u mismatches\n", errors);
+
+  /* Array conversion: hue accumulated in fixed point can round differently */
+  for (uint8_t reps = 1; reps <= 4; reps++) {
+    OldRainbow(old_colors, LEDS, 1000, 255, 255, reps);
+    NeoPixelHSV2ColorArray(new_colors, LEDS, 1000UL << 16, ((uint64_t)reps << 32) / LEDS, 255, 255);
+    for (uint16_t i = 0; i < LEDS; i++) {
+      if (old_colors[i] != new_colors[i]) {
+        diff_pixels++;
+      }
+    }
+  }
+  printf("NeoPixelHSV2ColorArray: %u of %u pixels differ from the per-LED loop (hue rounding)\n",
+         diff_pixels, 4 * LEDS);
+
+  t = Now();
+  for (uint32_t n = 0; n < ROUNDS; n++) {
+    OldRainbow(old_colors, LEDS, n, 255, 200, 1);
+    sink += old_colors[n % LEDS];
+  }
+  t_old = Now() - t;
+  t = Now();
+  for (uint32_t n = 0; n < ROUNDS; n++) {
+    NeoPixelHSV2ColorArray(new_colors, LEDS, (n & 0xFFFF) << 16, (1ULL << 32) / LEDS, 255, 200);
+    sink += new_colors[n % LEDS];
+  }
+  t_new = Now() - t;
+  printf("rainbow, %u leds: per-LED loop %.1f ns/led, array %.1f ns/led (x%.1f)\n", LEDS,
+         t_old * 1e9 / ROUNDS / LEDS, t_new * 1e9 / ROUNDS / LEDS, t_old / t_new);
+
+  /* Palette: packed R/B blend against the channel by channel reference */
+  for (uint8_t i = 0; i < NEOPIXEL_PALETTE_SIZE; i++) {
+    palette.colors[i] = (uint32_t)rand() & 0xFFFFFF;
+  }
+  errors = 0;
+  for (uint32_t index = 0; index < 65536; index++) {
+    if (NeoPixelPaletteColor(&palette, index) != RefPaletteColor(&palette, index)) {
+      errors++;
+    }
+  }
+  printf("NeoPixelPaletteColor: %u mismatches\n", errors);
+
+  t = Now();
+  for (uint32_t n = 0; n < ROUNDS; n++) {
+    for (uint16_t i = 0; i < LEDS; i++) {
+      old_colors[i] = RefPaletteColor(&palette, n + i * 219);
+    }
+    sink += old_colors[n % LEDS];
+  }
+  t_ref = Now() - t;
+  t = Now();
+  for (uint32_t n = 0; n < ROUNDS; n++) {
+    NeoPixelPaletteArray(&palette, new_colors, LEDS, n << 16, 219UL << 16);
+    sink += new_colors[n % LEDS];
+  }
+  t_pal = Now() - t;
+  printf("palette, %u leds: per-channel blend %.1f ns/led, NeoPixelPaletteArray %.1f ns/led (x%.1f)\n", LEDS,
+         t_ref * 1e9 / ROUNDS / LEDS, t_pal * 1e9 / ROUNDS / LEDS, t_ref / t_pal);
+
+  return errors ? 1 : 0;
+}
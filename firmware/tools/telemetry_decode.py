@@ -0,0 +1,114 @@
+#!/usr/bin/env python3
+"""Decode the binary telemetry frames sent by the telemetry driver.
+
+Reads from a serial port (requires pyserial) or from a file / stdin and
+prints one CSV line per channel record: seq,channel,sample1,sample2,...
+
+    python3 telemetry_decode.py --port /dev/ttyUSB0 --baud 115200   (Ctrl+C to stop)
+    python3 telemetry_decode.py capture.bin
+"""
+
+import argparse
+import struct
+import sys
+
+# telemetry_type_t: (struct format, size)
+TYPES = [('B', 1), ('b', 1), ('H', 2), ('h', 2), ('I', 4), ('i', 4), ('f', 4)]
+
+
+def crc16(data):
+    """CRC-16/CCITT-FALSE."""
+    crc = 0xFFFF
+    for byte in data:
+        x = ((crc >> 8) ^ byte) & 0xFF
+        x ^= x >> 4
+        crc = ((crc << 8) ^ (x << 12) ^ (x << 5) ^ x) & 0xFFFF
+    return crc
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data) + 1:
+            raise ValueError('bad COBS block')
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def parse_frame(frame):
+    """Return (seq, [(channel, [samples])]) or raise ValueError."""
+    if len(frame) < 3:
+        raise ValueError('short frame')
+    payload, crc = frame[:-2], struct.unpack('<H', frame[-2:])[0]
+    if crc16(payload) != crc:
+        raise ValueError('bad CRC')
+    seq, pos, records = payload[0], 1, []
+    while pos < len(payload):
+        channel, kind, qty = payload[pos:pos + 3]
+        fmt, size = TYPES[kind]
+        pos += 3
+        samples = struct.unpack_from('<%d%s' % (qty, fmt), payload, pos)
+        pos += qty * size
+        records.append((channel, list(samples)))
+    return seq, records
+
+
+def frames(stream, live=False):
+    """Yield raw frames. live: serial port, an empty read is only idle line."""
+    buf = bytearray()
+    while True:
+        chunk = stream.read(256)
+        if not chunk:
+            if live:
+                continue
+            return
+        buf += chunk
+        while 0 in buf:
+            end = buf.index(0)
+            raw, buf = bytes(buf[:end]), buf[end + 1:]
+            if raw:
+                yield raw
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('file', nargs='?', help='capture file (default: stdin)')
+    parser.add_argument('--port', help='serial port')
+    parser.add_argument('--baud', type=int, default=115200)
+    args = parser.parse_args()
+
+    live = bool(args.port)
+    if args.port:
+        import serial
+        stream = serial.Serial(args.port, args.baud, timeout=1)
+    elif args.file:
+        stream = open(args.file, 'rb')
+    else:
+        stream = sys.stdin.buffer
+
+    last_seq, errors, lost = None, 0, 0
+    try:
+        for raw in frames(stream, live):
+            try:
+                seq, records = parse_frame(cobs_decode(raw))
+            except (ValueError, IndexError, struct.error) as err:
+                errors += 1
+                print('# error: %s' % err, file=sys.stderr)
+                continue
+            if last_seq is not None:
+                lost += (seq - last_seq - 1) & 0xFF
+            last_seq = seq
+            for channel, samples in records:
+                print(','.join(str(v) for v in [seq, channel] + samples))
+    except KeyboardInterrupt:
+        pass
+    print('# errors: %d, lost frames: %d' % (errors, lost), file=sys.stderr)
+
+
+if __name__ == '__main__':
+    main()